@@ -27,9 +27,12 @@ set(RAWGL_IO_SOURCES
     src/io/image_backend.cpp
     src/io/image_io.cpp
     src/io/io_facade.cpp
+    src/io/decoded_image_cache.cpp
     src/io/io_runtime.cpp
+    src/io/io_worker_pool.cpp
     src/io/jpeg2000_backend.cpp
     src/io/jpg_backend.cpp
+    src/io/mapped_file.cpp
     src/io/metadata_reader.cpp
     src/io/openmeta_bridge.cpp
     src/io/png_backend.cpp
@@ -58,7 +58,9 @@ if(RAWGL_TESTS)
     rawgl_add_cpp_smoke_test(rawgl_core_persistent_texture_smoke tests/rawgl_core_persistent_texture_smoke.cpp)
     rawgl_add_cpp_smoke_test(rawgl_core_persistent_atomic_counter_smoke tests/rawgl_core_persistent_atomic_counter_smoke.cpp)
     rawgl_add_cpp_smoke_test(rawgl_core_transient_output_reuse_smoke tests/rawgl_core_transient_output_reuse_smoke.cpp)
+    rawgl_add_cpp_smoke_test(rawgl_core_gl_error_pass_smoke tests/rawgl_core_gl_error_pass_smoke.cpp)
     rawgl_add_cpp_smoke_test(rawgl_io_workflow_smoke tests/rawgl_io_workflow_smoke.cpp)
+    rawgl_add_cpp_smoke_test(rawgl_io_tiled_run_smoke tests/rawgl_io_tiled_run_smoke.cpp)
     rawgl_add_cpp_io_smoke_test(rawgl_io_host_image_smoke tests/rawgl_io_host_image_smoke.cpp)
     rawgl_add_cpp_io_smoke_test(rawgl_io_capabilities_smoke tests/rawgl_io_capabilities_smoke.cpp)
     if(TARGET PNG::PNG AND TARGET TIFF::TIFF AND TARGET OpenEXR::OpenEXR)
@@ -77,6 +79,8 @@ if(RAWGL_TESTS)
     endif()
     if(TARGET openjp2)
         rawgl_add_cpp_io_smoke_test(rawgl_io_jpeg2000_native_smoke tests/rawgl_io_jpeg2000_native_smoke.cpp)
+        target_include_directories(rawgl_io_jpeg2000_native_smoke PRIVATE
+            "${CMAKE_SOURCE_DIR}/src/io")
     endif()
     if(TARGET TIFF::TIFF)
         rawgl_add_cpp_io_smoke_test(rawgl_io_tiff_native_smoke tests/rawgl_io_tiff_native_smoke.cpp)
@@ -163,6 +167,23 @@ if(RAWGL_TESTS)
     set_tests_properties(rawgl_core_transient_output_reuse_smoke PROPERTIES
         WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}")
 
+    add_test(NAME rawgl_core_transient_output_reuse_pass_checks_smoke
+        COMMAND rawgl_core_transient_output_reuse_smoke)
+    set_tests_properties(rawgl_core_transient_output_reuse_pass_checks_smoke PROPERTIES
+        WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}"
+        ENVIRONMENT "RAWGL_GL_ERRORS=pass")
+
+    add_test(NAME rawgl_core_gl_error_pass_smoke
+        COMMAND rawgl_core_gl_error_pass_smoke)
+    set_tests_properties(rawgl_core_gl_error_pass_smoke PROPERTIES
+        WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}"
+        ENVIRONMENT "RAWGL_GL_ERRORS=pass")
+
+    add_test(NAME rawgl_core_gl_error_pass_option_smoke
+        COMMAND rawgl_core_gl_error_pass_smoke)
+    set_tests_properties(rawgl_core_gl_error_pass_option_smoke PROPERTIES
+        WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}")
+
     add_test(NAME rawgl_io_host_image_smoke
         COMMAND rawgl_io_host_image_smoke)
     set_tests_properties(rawgl_io_host_image_smoke PROPERTIES
@@ -218,6 +239,11 @@ if(RAWGL_TESTS)
     set_tests_properties(rawgl_io_workflow_smoke PROPERTIES
         WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}")
 
+    add_test(NAME rawgl_io_tiled_run_smoke
+        COMMAND rawgl_io_tiled_run_smoke)
+    set_tests_properties(rawgl_io_tiled_run_smoke PROPERTIES
+        WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}")
+
     if(RAWGL_HAS_OPENMETA)
         add_test(NAME rawgl_io_metadata_smoke
             COMMAND rawgl_io_metadata_smoke)
@@ -70,6 +70,13 @@ struct CounterBinding {
     size_t arrayElement = 0;
 };
 
+/// Host capture sample layout for one output.
+enum class CaptureSampleType {
+    native,
+    unorm8,
+    unorm16,
+};
+
 /// Declared output binding for one pass.
 struct OutputBinding {
     std::string name;
@@ -82,6 +89,7 @@ struct OutputBinding {
     size_t arrayElement = 0;
     std::vector<Attribute> attributes;
     bool captureToHost = false;
+    CaptureSampleType captureSampleType = CaptureSampleType::native;
 };
 
 /// Mesh source selector for a render pass.
@@ -217,12 +225,42 @@ CapturedOutput(std::string name,
     return result;
 }
 
+/// Construction options for a \ref Session.
+struct SessionOptions {
+    /// Byte cap for file-sourced input textures shared across prepared workflows, or 0 to disable reuse.
+    uint64_t textureCacheBudgetBytes = 512ull * 1024ull * 1024ull;
+    /// Byte cap for pass output textures reused across runs, or 0 to allocate fresh outputs every run.
+    uint64_t outputTexturePoolBudgetBytes = 256ull * 1024ull * 1024ull;
+    /// OpenGL error checking: `call`, `pass`, `off`, or empty for the build default.
+    ///
+    /// See `ContextOptions::glErrorPolicy`; `RAWGL_GL_ERRORS` overrides it.
+    std::string glErrorPolicy;
+};
+
 /// Session cache and reuse statistics.
 struct SessionStats {
     size_t shaderInterfaces = 0;
     size_t textures = 0;
     size_t meshesHost = 0;
     size_t meshesGpu = 0;
+    /// Bytes held by cached input textures.
+    uint64_t textureBytes = 0;
+    /// Workflow inputs served from the texture cache.
+    uint64_t textureHits = 0;
+    /// Workflow inputs uploaded because no cached texture matched.
+    uint64_t textureMisses = 0;
+    /// Cached textures dropped to stay within the byte budget.
+    uint64_t textureEvictions = 0;
+    /// Released pass output textures waiting for reuse.
+    size_t outputTexturesPooled = 0;
+    /// Bytes held by pooled output textures.
+    uint64_t outputTexturePoolBytes = 0;
+    /// Output textures reused from the pool.
+    uint64_t outputTexturePoolHits = 0;
+    /// Output textures allocated because no pooled texture matched.
+    uint64_t outputTexturePoolMisses = 0;
+    /// Pooled output textures dropped to stay within the byte budget.
+    uint64_t outputTexturePoolEvictions = 0;
 };
 
 /// Per-run execution settings for a prepared workflow.
@@ -308,6 +346,18 @@ to_graph(const InputSourceKind sourceKind)
     return GraphInputSourceKind::intValues;
 }
 
+static inline GraphCaptureSampleType
+to_graph(const CaptureSampleType sampleType)
+{
+    switch (sampleType) {
+    case CaptureSampleType::native: return GraphCaptureSampleType::native;
+    case CaptureSampleType::unorm8: return GraphCaptureSampleType::unorm8;
+    case CaptureSampleType::unorm16: return GraphCaptureSampleType::unorm16;
+    }
+
+    return GraphCaptureSampleType::native;
+}
+
 static inline GraphMeshSourceKind
 to_graph(const MeshSourceKind sourceKind)
 {
@@ -388,6 +438,7 @@ to_graph(const OutputBinding& output)
     result.arrayElement = output.arrayElement;
     result.attributes = to_graph(output.attributes);
     result.captureToHost = output.captureToHost;
+    result.captureSampleType = to_graph(output.captureSampleType);
     return result;
 }
 
@@ -606,6 +657,25 @@ from_graph(const ContextCacheStats& stats)
     result.textures = stats.textures;
     result.meshesHost = stats.meshesHost;
     result.meshesGpu = stats.meshesGpu;
+    result.textureBytes = stats.textureBytes;
+    result.textureHits = stats.textureHits;
+    result.textureMisses = stats.textureMisses;
+    result.textureEvictions = stats.textureEvictions;
+    result.outputTexturesPooled = stats.outputTexturesPooled;
+    result.outputTexturePoolBytes = stats.outputTexturePoolBytes;
+    result.outputTexturePoolHits = stats.outputTexturePoolHits;
+    result.outputTexturePoolMisses = stats.outputTexturePoolMisses;
+    result.outputTexturePoolEvictions = stats.outputTexturePoolEvictions;
+    return result;
+}
+
+static inline ContextOptions
+to_graph(const SessionOptions& options)
+{
+    ContextOptions result;
+    result.textureCacheBudgetBytes = options.textureCacheBudgetBytes;
+    result.outputTexturePoolBudgetBytes = options.outputTexturePoolBudgetBytes;
+    result.glErrorPolicy = options.glErrorPolicy;
     return result;
 }
 
@@ -658,6 +728,10 @@ private:
 class Session {
 public:
     Session() = default;
+    explicit Session(const SessionOptions& options)
+        : m_context(detail::to_graph(options))
+    {
+    }
     ~Session() = default;
 
     Session(const Session&) = delete;
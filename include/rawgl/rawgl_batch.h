@@ -3,31 +3,67 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <rawgl/rawgl_io.h>
 
 namespace rawgl::batch {
 
+struct BatchResult;
+
 /// Controls queue sizing, worker intent, and budget hints for future batch execution.
 ///
-/// The current implementation uses a bounded GPU command queue, one GPU worker,
-/// and an optional save-worker pool while keeping `rawgl_core` itself synchronous.
+/// The current implementation uses optional prepare workers for per-job file
+/// decode, a bounded GPU command queue, one GPU worker, and an optional
+/// save-worker pool while keeping `rawgl_core` itself synchronous.
 struct BatchRunnerOptions {
     size_t maxInFlightJobs = 8;
     size_t prepareQueueCapacity = 8;
     size_t executeQueueCapacity = 4;
     size_t saveQueueCapacity = 8;
+    /// CPU workers that decode per-job file inputs before handing jobs to the GPU worker.
+    ///
+    /// Only used by runners constructed with `IoRuntime`. With 0 workers the GPU
+    /// worker decodes file inputs itself. While `preserveSubmitOrder` is set, jobs
+    /// still reach the GPU worker in submit order.
     uint32_t prepareWorkerCount = 2;
     uint32_t saveWorkerCount = 2;
     uint32_t gpuWorkerCount = 1;
+    /// Host byte budget for in-flight jobs, or 0 for no limit.
+    ///
+    /// Each job is charged for its host texture overrides, decoded file inputs,
+    /// and captured outputs. `submit` blocks while admitting a job would exceed
+    /// the budget; a job is always admitted when nothing else is in flight.
     uint64_t hostMemoryBudgetBytes = 0;
+    /// GPU byte budget for in-flight jobs, or 0 for no limit.
+    ///
+    /// Each job is charged for its uploaded input textures and pass outputs.
     uint64_t gpuMemoryBudgetBytes = 0;
+    /// Keeps GPU execution and completion delivery in submit order.
+    ///
+    /// When false, prepared jobs run as soon as their file inputs are decoded,
+    /// and `onCompleted` and the completion queue (see `collectCompletions`)
+    /// see jobs in the order they finish instead of in submit order.
     bool preserveSubmitOrder = true;
+    /// Queues finished jobs for `BatchRunner::waitNextCompleted` and `drain`.
+    ///
+    /// Queued results stay alive until delivered, so enable this only when the
+    /// caller consumes the completion queue. Without it `drain` still waits for
+    /// every submitted job but returns no results.
+    bool collectCompletions = false;
+    /// Called once per finished job, after its outputs are saved, in the same
+    /// order as completion delivery.
+    ///
+    /// Runs on a runner worker thread with other callbacks serialized, so it
+    /// must not block on `BatchRunner` calls that wait for jobs.
+    std::function<void(const BatchResult&)> onCompleted;
 };
 
 /// Snapshot of batch progress counters.
@@ -37,6 +73,10 @@ struct BatchProgress {
     size_t failedJobs = 0;
     size_t cancelledJobs = 0;
     size_t inFlightJobs = 0;
+    /// Host bytes reserved by in-flight jobs; estimated at submit and corrected once file inputs are decoded.
+    uint64_t reservedHostBytes = 0;
+    /// Estimated GPU bytes reserved by in-flight jobs.
+    uint64_t reservedGpuBytes = 0;
 };
 
 /// Per-submit run payload for a prepared batch workflow.
@@ -111,7 +151,8 @@ struct BatchPrepareResult {
 
 /// Handle for one submitted batch job.
 ///
-/// `wait()` blocks until the queued job reaches a terminal state.
+/// `wait()` blocks until the queued job reaches a terminal state; `isReady()`
+/// and `waitFor()` let callers poll or bound the wait instead.
 class BatchJobHandle {
 public:
     BatchJobHandle();
@@ -124,6 +165,14 @@ public:
 
     BatchResult wait() const;
 
+    /// Returns true once the job reached a terminal state. Empty handles are always ready.
+    bool isReady() const;
+
+    /// Waits up to `timeout` for the job to finish.
+    ///
+    /// Returns false and leaves `outResult` untouched when the job is still pending.
+    bool waitFor(std::chrono::milliseconds timeout, BatchResult& outResult) const;
+
 private:
     friend class BatchRunner;
     struct State;
@@ -136,7 +185,9 @@ private:
 /// Batch orchestration façade on top of `Session` and optional `IoRuntime`.
 ///
 /// The current implementation uses one GPU worker for `Session` preparation and
-/// execution, plus optional save workers for deferred file output writes.
+/// execution, optional prepare workers for per-job file input decode, plus
+/// optional save workers for deferred file output writes. Workflow-level file
+/// inputs passed to `prepare` are decoded on the calling thread.
 class BatchRunner {
 public:
     explicit BatchRunner(Session& session, const BatchRunnerOptions& options = {});
@@ -148,15 +199,36 @@ public:
     BatchRunner(BatchRunner&&) = delete;
     BatchRunner& operator=(BatchRunner&&) = delete;
 
+    /// Queues `workflow` for preparation on the GPU worker.
+    ///
+    /// Host textures in `workflow` are shared with the runner, not copied, and
+    /// must not be modified until the returned workflow is released.
     BatchPrepareResult prepare(const Workflow& workflow,
                                const std::vector<io::FileInputBinding>& fileInputs = {},
                                const std::vector<io::FileOutputBinding>& fileOutputs = {}) const;
 
+    /// Queues one run of `workflow`.
+    ///
+    /// Host texture overrides in `request` are shared with the job, not copied,
+    /// and must not be modified until the job is ready.
     BatchJobHandle
     submit(const BatchPreparedWorkflow& workflow,
            const BatchSubmitRequest& request = {},
            const BatchCancellationToken* cancellation = nullptr);
 
+    /// Waits for the next finished job that has not been delivered yet.
+    ///
+    /// Returns false once every submitted job has been delivered, and at once
+    /// when `BatchRunnerOptions::collectCompletions` is off; job handles stay
+    /// valid either way.
+    bool waitNextCompleted(BatchResult& outResult);
+
+    /// Waits for all submitted jobs and returns the results not yet delivered by `waitNextCompleted`.
+    ///
+    /// Without `BatchRunnerOptions::collectCompletions` the returned vector is
+    /// empty; read results through the job handles or `onCompleted`.
+    std::vector<BatchResult> drain();
+
     BatchProgress progress() const;
     void close();
 
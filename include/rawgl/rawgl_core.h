@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -228,7 +229,10 @@ struct GraphAttribute {
     std::string value;
 };
 
-/// Owned host-memory texture payload used for in-memory graph inputs and captures.
+/// Host-memory texture payload used for in-memory graph inputs and captures.
+///
+/// Pixels live either in owned \ref bytes or in a shared read-only buffer;
+/// bindings that hold the same `shared_ptr` to a payload share its pixels.
 struct HostImageData {
     /// Texture width in pixels.
     int width = 0;
@@ -244,6 +248,29 @@ struct HostImageData {
     unsigned int glType = 0;
     /// Owned tightly packed pixel bytes in row-major order.
     std::vector<std::byte> bytes;
+    /// Optional shared read-only pixel bytes, used instead of \ref bytes when set.
+    ///
+    /// File inputs materialized by the IO layer and arrays adopted from Python
+    /// carry their pixels here so copies of the payload share one buffer down to
+    /// texture upload. The pointer may alias storage owned by another object;
+    /// its control block keeps that owner alive. Reset it when assigning new
+    /// \ref bytes.
+    std::shared_ptr<const std::byte> sharedBytes;
+    /// Byte count of \ref sharedBytes.
+    size_t sharedByteCount = 0;
+
+    /// Returns the active pixel bytes: \ref sharedBytes when set, otherwise \ref bytes.
+    std::span<const std::byte> pixelBytes() const
+    {
+        return sharedBytes ? std::span<const std::byte>(sharedBytes.get(), sharedByteCount)
+                           : std::span<const std::byte>(bytes);
+    }
+    /// Optional identity of the pixel source, such as a decoded file and its load attributes.
+    ///
+    /// Graph inputs whose payloads carry the same non-empty key share one cached
+    /// GPU texture within a \ref RawGLContext. Clear the key after modifying
+    /// \ref bytes.
+    std::string sourceKey;
 };
 
 /// Extra per-vertex host-memory attribute.
@@ -344,6 +371,17 @@ struct GraphAtomicCounterDefinition {
     size_t arrayElement = 0;
 };
 
+/// Sample layout requested for host capture of a pass output.
+///
+/// `native` reads the texture back in the component type of its internal format. `unorm8` and `unorm16` pack
+/// float outputs on the GPU into clamped unsigned-normalized samples before readback, which shrinks the transfer and
+/// skips the CPU quantization step of 8-bit and 16-bit file encoders. Non-float outputs always use `native`.
+enum class GraphCaptureSampleType {
+    native,
+    unorm8,
+    unorm16,
+};
+
 /// Declares one named pass output.
 struct GraphOutputDefinition {
     /// Shader-visible output name.
@@ -366,6 +404,8 @@ struct GraphOutputDefinition {
     std::vector<GraphAttribute> attributes;
     /// Requests host-memory capture in \ref GraphExecutionResult::capturedOutputs.
     bool captureToHost = false;
+    /// Sample layout of the host capture when \ref captureToHost is true.
+    GraphCaptureSampleType captureSampleType = GraphCaptureSampleType::native;
 };
 
 /// Mesh source variant for a draw pass.
@@ -501,14 +541,56 @@ struct RuntimeInfo {
     std::string shadingLanguageVersion;
     /// True when the renderer looks like a software rasterizer.
     bool softwareRenderer = false;
+    /// OpenGL error checking in effect, from `ContextOptions::glErrorPolicy` or `RAWGL_GL_ERRORS`: `call`, `pass`,
+    /// or `off`.
+    std::string glErrorPolicy;
+};
+
+/// Construction options for a \ref RawGLContext instance.
+struct ContextOptions {
+    /// Byte cap for source-keyed input textures kept alive across graphs, or 0 to disable the cache.
+    ///
+    /// Least recently used textures are evicted first. Graphs that still use an
+    /// evicted texture keep it alive until they are destroyed.
+    uint64_t textureCacheBudgetBytes = 512ull * 1024ull * 1024ull;
+    /// Byte cap for released pass output textures kept for reuse by later executions, or 0 to disable pooling.
+    ///
+    /// Textures are matched by size, format and alpha channel. The least recently released are dropped first.
+    uint64_t outputTexturePoolBudgetBytes = 256ull * 1024ull * 1024ull;
+    /// OpenGL error checking: `call`, `pass`, `off`, or empty for the build default.
+    ///
+    /// `call` checks glGetError after every GL call, `pass` once after each
+    /// pass, and `off` only logs driver debug output. The build default is
+    /// `pass` in release builds and `call` otherwise. A set `RAWGL_GL_ERRORS`
+    /// overrides this. The policy is process-wide, so the most recently
+    /// created context decides it.
+    std::string glErrorPolicy;
 };
 
 /// Snapshot of cache usage for a \ref RawGLContext instance.
 struct ContextCacheStats {
-    size_t shaderInterfaces = 0;
-    size_t textures         = 0;
-    size_t meshesHost       = 0;
-    size_t meshesGpu        = 0;
+    size_t shaderInterfaces             = 0;
+    size_t textures                     = 0;
+    size_t meshesHost                   = 0;
+    size_t meshesGpu                    = 0;
+    /// Bytes held by cached input textures.
+    uint64_t textureBytes               = 0;
+    /// Graph inputs served from the texture cache.
+    uint64_t textureHits                = 0;
+    /// Graph inputs uploaded because no cached texture matched.
+    uint64_t textureMisses              = 0;
+    /// Cached textures dropped to stay within the byte budget.
+    uint64_t textureEvictions           = 0;
+    /// Released pass output textures waiting for reuse.
+    size_t outputTexturesPooled         = 0;
+    /// Bytes held by pooled output textures.
+    uint64_t outputTexturePoolBytes     = 0;
+    /// Output textures taken from the pool instead of being allocated.
+    uint64_t outputTexturePoolHits      = 0;
+    /// Output textures allocated because no pooled texture matched.
+    uint64_t outputTexturePoolMisses    = 0;
+    /// Pooled output textures dropped to stay within the byte budget.
+    uint64_t outputTexturePoolEvictions = 0;
 };
 
 class RawGLGraph;
@@ -526,7 +608,7 @@ struct RawGLContextState;
 /// Long-lived owner for cached shader interfaces and reusable graph resources.
 class RawGLContext {
 public:
-    RawGLContext();
+    explicit RawGLContext(const ContextOptions& options = {});
     ~RawGLContext();
 
     RawGLContext(const RawGLContext&) = delete;
@@ -588,8 +670,8 @@ InspectShaderInterface(const ShaderInspectionRequest& request);
 MeshInspectionResult
 InspectMeshFile(const MeshInspectionRequest& request);
 
-/// Creates a temporary context and returns OpenGL runtime diagnostics.
+/// Creates a temporary context with `options` and returns OpenGL runtime diagnostics.
 RuntimeInfo
-ProbeRuntimeInfo();
+ProbeRuntimeInfo(const ContextOptions& options = {});
 
 }  // namespace rawgl
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,11 +18,47 @@
 namespace rawgl::io {
 
 struct MetadataDocumentStorage;
+class ImageStreamEncoder;
+class IoRuntimeService;
 
 /// Controls CPU-side image decode and encode worker policy.
+///
+/// Worker counts bound the decode and encode pools owned by one \ref IoRuntime.
+/// Values <= 0 select one worker per hardware thread.
 struct IoRuntimeOptions {
+    /// Maximum number of concurrent file decodes.
     int decodeWorkerCount = 0;
+    /// Maximum number of concurrent file encodes.
     int encodeWorkerCount = 0;
+    /// Threads one decode may use for codecs that split an image into independent chunks, such as
+    /// strip- or tile-organized TIFF, OpenEXR, and JPEG-2000 code-blocks. Values <= 0 share the
+    /// hardware threads evenly between the decodes in flight when each one starts, so a single
+    /// large image uses every core. Values > 0 are used as given for every decode.
+    int decodeThreadsPerImage = 0;
+    /// Threads one encode may use to compress independent chunks, such as Deflate-, LZW-, or
+    /// ZSTD-compressed TIFF strips and tiles, OpenEXR line blocks, or JPEG-2000 code-blocks.
+    /// Values <= 0 share the hardware threads between the encodes in flight, as for
+    /// \ref decodeThreadsPerImage; values > 0 are used as given.
+    int encodeThreadsPerImage = 0;
+    /// Byte cap for decoded images kept for reuse, or 0 to disable the decode cache.
+    ///
+    /// Entries are keyed by canonical path, file size, write time, and load
+    /// attributes, so edited files are decoded again.
+    uint64_t decodeCacheBudgetBytes = 256ull * 1024ull * 1024ull;
+};
+
+/// Snapshot of the decoded-image cache shared by copies of one \ref IoRuntime.
+struct IoCacheStats {
+    /// Number of cached decoded images.
+    size_t entries = 0;
+    /// Decoded bytes held by the cache.
+    uint64_t bytes = 0;
+    /// File loads served from the cache.
+    uint64_t hits = 0;
+    /// File loads that decoded from disk.
+    uint64_t misses = 0;
+    /// Cached images dropped to stay within the byte budget.
+    uint64_t evictions = 0;
 };
 
 /// Decode backend policy for file-backed image loads.
@@ -36,10 +75,26 @@ enum class JpegLoadColorTransform : uint8_t {
     Rgb,
 };
 
+/// libjpeg DCT implementation used by native JPEG decode and encode.
+enum class JpegDctMethod : uint8_t {
+    /// Slow, accurate integer DCT (libjpeg `JDCT_ISLOW`).
+    Accurate,
+    /// Fast, less accurate integer DCT (libjpeg `JDCT_IFAST`).
+    Fast,
+    /// Floating-point DCT (libjpeg `JDCT_FLOAT`).
+    Float,
+};
+
 /// Typed native JPEG reader options.
 struct JpegLoadOptions {
     bool hasColorTransform = false;
     JpegLoadColorTransform colorTransform = JpegLoadColorTransform::Auto;
+    bool hasDctMethod = false;
+    JpegDctMethod dctMethod = JpegDctMethod::Accurate;
+    /// `false` selects the merged box-filter chroma upsampling and colour conversion path, which is faster but
+    /// softer than the default triangle filter.
+    bool hasFancyUpsampling = false;
+    bool fancyUpsampling = true;
 };
 
 /// Typed native PNG reader options.
@@ -67,6 +122,9 @@ enum class OpenExrChannelSelection : uint8_t {
 struct OpenExrLoadOptions {
     bool hasChannelSelection = false;
     OpenExrChannelSelection channelSelection = OpenExrChannelSelection::Auto;
+    /// Overrides `IoRuntimeOptions::decodeThreadsPerImage` for this load. 1 decodes on the calling thread.
+    bool hasThreadCount = false;
+    uint32_t threadCount = 1;
 };
 
 /// Typed native JPEG-2000 reader options.
@@ -75,6 +133,18 @@ struct Jpeg2000LoadOptions {
     uint32_t reduceFactor = 0;
     bool hasLayerLimit = false;
     uint32_t layerLimit = 0;
+    /// Decodes only this rectangle, in full-resolution pixels relative to the image origin.
+    ///
+    /// Combined with a reduce factor or decode scale, the decoded image covers the same area
+    /// at the reduced resolution.
+    bool hasRegion = false;
+    uint32_t regionX = 0;
+    uint32_t regionY = 0;
+    uint32_t regionWidth = 0;
+    uint32_t regionHeight = 0;
+    /// Overrides `IoRuntimeOptions::decodeThreadsPerImage` for this load. 1 decodes on the calling thread.
+    bool hasThreadCount = false;
+    uint32_t threadCount = 1;
 };
 
 /// Typed native codec reader options.
@@ -85,6 +155,15 @@ struct Jpeg2000LoadOptions {
 struct ImageCodecLoadOptions {
     bool hasBackendPolicy = false;
     ImageLoadBackendPolicy backendPolicy = ImageLoadBackendPolicy::Auto;
+    /// Requests a reduced-resolution decode at about 1/`decodeScale` of the full size.
+    ///
+    /// Must be a power of two from 1 to 256. JPEG maps it to libjpeg DCT scaling (down to
+    /// 1/8), mip- or rip-mapped tiled OpenEXR to the matching level, and JPEG-2000 to its
+    /// resolution reduce factor unless `Jpeg2000LoadOptions::reduceFactor` is set. Codecs clamp
+    /// to the smallest reduction they can produce and other codecs decode at full size, so read
+    /// the decoded dimensions instead of assuming them.
+    bool hasDecodeScale = false;
+    uint32_t decodeScale = 1;
     bool hasJpeg = false;
     JpegLoadOptions jpeg;
     bool hasPng = false;
@@ -107,6 +186,20 @@ struct ImageLoadRequest {
     ImageCodecLoadOptions codecOptions;
 };
 
+/// Request for decoding one encoded image that is already resident in memory.
+///
+/// Only native codecs decode in-memory sources; the bytes must stay valid for the duration of the call.
+struct ImageMemoryLoadRequest {
+    /// Encoded image bytes, e.g. a whole PNG or JPEG file.
+    std::span<const std::byte> bytes;
+    /// Optional file name whose extension selects the codec; the leading signature bytes are used when empty.
+    std::string nameHint;
+    /// Compatibility loader attributes such as colorspace hints.
+    std::vector<Attribute> attributes;
+    /// Typed native codec-specific reader options.
+    ImageCodecLoadOptions codecOptions;
+};
+
 /// Result of loading one file-backed image into host memory.
 struct ImageLoadResult {
     /// False when loading failed.
@@ -137,6 +230,8 @@ struct JpegSaveOptions {
     bool optimize = false;
     bool hasSubsampling = false;
     JpegChromaSubsampling subsampling = JpegChromaSubsampling::Default;
+    bool hasDctMethod = false;
+    JpegDctMethod dctMethod = JpegDctMethod::Accurate;
 };
 
 /// Typed native PNG writer options.
@@ -253,6 +348,9 @@ struct OpenExrSaveOptions {
     OpenExrLineOrder lineOrder = OpenExrLineOrder::IncreasingY;
     bool hasDwaCompressionLevel = false;
     float dwaCompressionLevel = 0.0f;
+    /// Overrides `IoRuntimeOptions::encodeThreadsPerImage` for this save. 1 encodes on the calling thread.
+    bool hasThreadCount = false;
+    uint32_t threadCount = 1;
 };
 
 /// Typed native JPEG-2000 writer options.
@@ -263,6 +361,9 @@ struct Jpeg2000SaveOptions {
     float compressionRatio = 0.0f;
     bool hasQuality = false;
     float quality = 0.0f;
+    /// Overrides `IoRuntimeOptions::encodeThreadsPerImage` for this save. Needs OpenJPEG 2.4 or newer.
+    bool hasThreadCount = false;
+    uint32_t threadCount = 1;
 };
 
 /// Typed native codec writer options.
@@ -307,6 +408,50 @@ struct ImageSaveResult {
     std::string errorMessage;
 };
 
+/// File-backed image that is written band by band, top to bottom.
+///
+/// Obtain one from \ref IoRuntime::beginImageFileStream. Native PNG, TIFF, and OpenEXR writers encode each band as
+/// it arrives; other formats collect the bands and write the image in \ref finish. A stream destroyed before
+/// \ref finish leaves an incomplete file behind.
+class ImageFileStream {
+public:
+    ImageFileStream();
+    explicit ImageFileStream(std::unique_ptr<ImageStreamEncoder> encoder);
+    ~ImageFileStream();
+
+    ImageFileStream(ImageFileStream&& other) noexcept;
+    ImageFileStream& operator=(ImageFileStream&& other) noexcept;
+    ImageFileStream(const ImageFileStream&) = delete;
+    ImageFileStream& operator=(const ImageFileStream&) = delete;
+
+    /// True until \ref finish succeeds or a write fails.
+    bool isOpen() const { return m_encoder != nullptr; }
+
+    /// Encodes the next `rows.height` full-width rows.
+    ///
+    /// `rows` must match the width, channel count, and pixel type of the stream layout. The pixels may be released
+    /// as soon as this returns.
+    ImageSaveResult
+    writeRows(const HostImageData& rows);
+
+    /// Completes the file once every row has been written.
+    ImageSaveResult
+    finish();
+
+private:
+    std::unique_ptr<ImageStreamEncoder> m_encoder;
+};
+
+/// Result of starting one streamed image save.
+struct ImageStreamBeginResult {
+    /// False when the file could not be started.
+    bool success = false;
+    /// Failure details when \ref success is false.
+    std::string errorMessage;
+    /// Open stream when \ref success is true.
+    ImageFileStream stream;
+};
+
 /// One name/value detail reported by the image IO capability query.
 struct ImageIoCapabilityDetail {
     std::string name;
@@ -639,10 +784,60 @@ struct SaveOutputsResult {
     bool success = false;
     /// Failure details when \ref success is false.
     std::string errorMessage;
-    /// Number of outputs written before completion or failure.
+    /// Number of outputs written successfully.
     size_t savedCount = 0;
 };
 
+/// Source-pixel rectangle covered by one tile of a tiled run.
+struct ImageTileRegion {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+/// File-backed tiled execution of a fullscreen workflow over one large image.
+///
+/// The source is split into tiles of at most \ref tileWidth x \ref tileHeight pixels. Each tile is extended by
+/// \ref halo pixels on every side, with clamp-to-edge replication past the image border, and every pass runs at
+/// that padded size. The halo is cropped from each tile's output before it is stitched into the target image, so
+/// only pointwise passes and passes whose sampling footprint stays within \ref halo pixels give seamless results.
+/// Every pass must be sized to the full source image; workflows that resample between passes are rejected.
+struct TiledRunRequest {
+    /// File-backed image input that receives each source tile.
+    FileInputBinding input;
+    /// File-backed output assembled from the stitched tiles.
+    FileOutputBinding output;
+    /// Tile width in pixels, before the halo is added.
+    int tileWidth = 4096;
+    /// Tile height in pixels, before the halo is added.
+    int tileHeight = 4096;
+    /// Extra source pixels supplied around each tile for bounded-neighbourhood passes.
+    int halo = 0;
+    /// Optional `ivec4` input set per tile to the padded tile origin and the full image size.
+    ///
+    /// The value is `(originX, originY, imageWidth, imageHeight)`, where the origin may be negative on border
+    /// tiles. Only passes whose workflow inputs list a binding with this name receive it; a shader uniform of that
+    /// name alone is not enough. The run is rejected when no pass declares it.
+    std::string tileInfoInputName;
+    /// In-memory run settings applied to every tile.
+    RunSettings settings;
+};
+
+/// Result of one tiled run.
+struct TiledRunResult {
+    /// False when the run failed.
+    bool success = false;
+    /// Failure details when \ref success is false.
+    std::string errorMessage;
+    /// Full output width in pixels.
+    int width = 0;
+    /// Full output height in pixels.
+    int height = 0;
+    /// Number of tiles executed.
+    size_t tileCount = 0;
+};
+
 class PreparedIoWorkflow;
 
 /// Result of preparing one IO-backed workflow for repeated execution.
@@ -719,20 +914,36 @@ FileOutput(size_t passIndex,
 /// This is the preferred public translation layer for file-oriented workflows.
 /// `rawgl_core` should stay host-memory oriented, while `IoRuntime` owns the
 /// materialization of file-backed inputs and deferred output saves.
+///
+/// Copies share the same bounded decode and encode worker pools and the same decoded-image cache.
 class IoRuntime {
 public:
     explicit IoRuntime(const IoRuntimeOptions& options = {});
 
     const IoRuntimeOptions& options() const { return m_options; }
 
+    /// Returns decoded-image cache counters.
+    IoCacheStats cacheStats() const;
+
     /// Loads one file-backed image into \ref HostImageData.
     ImageLoadResult
     loadImageFile(const ImageLoadRequest& request) const;
 
+    /// Decodes one in-memory encoded image into \ref HostImageData. Results are not cached.
+    ImageLoadResult
+    loadImageMemory(const ImageMemoryLoadRequest& request) const;
+
     /// Saves one \ref HostImageData payload to a file-backed image.
     ImageSaveResult
     saveImageFile(const ImageSaveRequest& request) const;
 
+    /// Starts saving one file-backed image band by band.
+    ///
+    /// `request.image` describes the full image: width, height, channel count, alpha channel, and pixel type. Its
+    /// pixel bytes are ignored and may be empty.
+    ImageStreamBeginResult
+    beginImageFileStream(const ImageSaveRequest& request) const;
+
     /// Reads metadata from one file-backed image or container.
     MetadataReadResult
     readMetadataFile(const MetadataReadRequest& request) const;
@@ -778,8 +989,25 @@ public:
         const std::vector<FileInputBinding>& fileInputs = {},
         const std::vector<FileOutputBinding>& fileOutputs = {}) const;
 
+    /// Runs a fullscreen workflow tile by tile over one file-backed image and saves the stitched output.
+    ///
+    /// Use this for images larger than the GPU's maximum texture size or available video memory. The workflow is
+    /// prepared once at the padded tile size and executed once per tile. Each completed row of tiles is streamed to
+    /// the output file through \ref beginImageFileStream.
+    TiledRunResult
+    runTiled(const Session& session, const Workflow& workflow, const TiledRunRequest& request) const;
+
 private:
+    /// Session-independent body of \ref runTiled; `prepareTiles` prepares the tile-sized workflow once and
+    /// `runTile` executes it for one tile.
+    TiledRunResult
+    runTiledWith(const Workflow& workflow,
+                 const TiledRunRequest& request,
+                 const std::function<bool(const Workflow&, std::string&)>& prepareTiles,
+                 const std::function<RunResult(const RunSettings&)>& runTile) const;
+
     IoRuntimeOptions m_options;
+    std::shared_ptr<IoRuntimeService> m_service;
 };
 
 /// Prepared IO-backed workflow that owns deferred output saves.
@@ -862,10 +1090,36 @@ private:
 ImageLoadResult
 LoadImageFile(const ImageLoadRequest& request);
 
+/// Decodes one in-memory encoded image into \ref HostImageData using a default \ref IoRuntime.
+ImageLoadResult
+LoadImageMemory(const ImageMemoryLoadRequest& request);
+
 /// Saves one \ref HostImageData payload to a file-backed image using a default \ref IoRuntime.
 ImageSaveResult
 SaveImageFile(const ImageSaveRequest& request);
 
+/// Splits a `width` x `height` image into row-major tiles of at most `tileWidth` x `tileHeight` pixels.
+std::vector<ImageTileRegion>
+PlanImageTiles(int width, int height, int tileWidth, int tileHeight);
+
+/// Copies a `width` x `height` window starting at (`x`, `y`) out of `source`.
+///
+/// The window may extend past the image; those pixels replicate the nearest edge pixel. Returns an empty image when
+/// `source` has no pixel data or the window is empty.
+HostImageData
+ExtractImageTile(const HostImageData& source, int x, int y, int width, int height);
+
+/// Copies the `region`-sized window at (`halo`, `halo`) of `tile` into `target` at the region origin.
+///
+/// `target` must have its width and height set. Its pixel storage and format are taken from the first tile when it
+/// has no bytes yet.
+bool
+StitchImageTile(HostImageData& target,
+                const HostImageData& tile,
+                const ImageTileRegion& region,
+                int halo,
+                std::string& errorMessage);
+
 /// Returns image IO capabilities for this RawGL build.
 ImageIoCapabilities
 GetImageIoCapabilities();
@@ -930,4 +1184,22 @@ IoRuntime::run(const Session& session,
     return preparedResult.workflow->run(request);
 }
 
+inline TiledRunResult
+IoRuntime::runTiled(const Session& session, const Workflow& workflow, const TiledRunRequest& request) const
+{
+    std::unique_ptr<PreparedWorkflow> prepared;
+    const auto prepareTiles = [&](const Workflow& tiledWorkflow, std::string& errorMessage) {
+        PrepareResult prepareResult = session.prepare(tiledWorkflow);
+        if (!prepareResult.success || !prepareResult.workflow) {
+            errorMessage =
+                prepareResult.errorMessage.empty() ? "workflow preparation failed" : prepareResult.errorMessage;
+            return false;
+        }
+        prepared = std::move(prepareResult.workflow);
+        return true;
+    };
+    const auto runTile = [&](const RunSettings& settings) { return prepared->run(settings); };
+    return runTiledWith(workflow, request, prepareTiles, runTile);
+}
+
 }  // namespace rawgl::io
@@ -3,8 +3,11 @@
 
 #include "rawgl/rawgl_batch.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <deque>
+#include <filesystem>
+#include <map>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -77,61 +80,63 @@ private:
     bool m_closed = false;
 };
 
-struct PrepareWaitState {
-    std::mutex mutex;
-    std::condition_variable condition;
-    bool ready = false;
-    BatchPrepareResult result;
+struct BatchJobFootprint {
+    uint64_t hostBytes = 0;
+    uint64_t gpuBytes = 0;
 };
 
-static InputBinding
-clone_batch_input_binding(const InputBinding& input)
+static uint64_t
+output_format_pixel_bytes(const std::string& format)
 {
-    InputBinding result = input;
-    if (input.hostTexture) {
-        result.hostTexture = std::make_shared<HostImageData>(*input.hostTexture);
-    }
-    return result;
-}
+    struct OutputFormatBytes {
+        const char* name;
+        uint64_t bytes;
+    };
 
-static InputOverride
-clone_batch_input_override(const InputOverride& inputOverride)
-{
-    InputOverride result = inputOverride;
-    if (inputOverride.hostTexture) {
-        result.hostTexture = std::make_shared<HostImageData>(*inputOverride.hostTexture);
+    static const OutputFormatBytes formats[] = {
+        { "rgba8", 4u },    { "rgba16", 8u },   { "rgba16f", 8u },  { "rgba32f", 16u },
+        { "r8", 1u },       { "r16", 2u },      { "r16f", 2u },     { "r32f", 4u },
+        { "rg8", 2u },      { "rg16", 4u },     { "rg16f", 4u },    { "rg32f", 8u },
+        { "rgb8", 3u },     { "rgb16", 6u },    { "rgb16f", 6u },   { "rgb32f", 12u },
+        { "r32ui", 4u },    { "rg32ui", 8u },   { "rgb32ui", 12u }, { "rgba32ui", 16u },
+    };
+
+    for (const OutputFormatBytes& entry : formats) {
+        if (format == entry.name) {
+            return entry.bytes;
+        }
     }
-    return result;
+
+    // Unknown output formats fall back to rgba32f in the runtime.
+    return 16u;
 }
 
-static Workflow
-clone_batch_workflow(const Workflow& workflow)
+static std::string
+make_batch_input_key(const size_t passIndex,
+                     const std::string& name,
+                     const bool usesArrayElement,
+                     const size_t arrayElement)
 {
-    Workflow result = workflow;
-    for (Pass& pass : result.passes) {
-        for (InputBinding& input : pass.inputs) {
-            if (!input.hostTexture) {
-                continue;
-            }
-            input = clone_batch_input_binding(input);
-        }
+    std::string key = std::to_string(passIndex) + "::" + name;
+    if (usesArrayElement) {
+        key += "[" + std::to_string(arrayElement) + "]";
     }
-    return result;
+    return key;
 }
 
-static BatchSubmitRequest
-clone_batch_submit_request(const BatchSubmitRequest& request)
+static uint64_t
+host_image_byte_size(const std::shared_ptr<HostImageData>& hostTexture)
 {
-    BatchSubmitRequest result = request;
-    for (InputOverride& inputOverride : result.settings.overrides) {
-        if (!inputOverride.hostTexture) {
-            continue;
-        }
-        inputOverride = clone_batch_input_override(inputOverride);
-    }
-    return result;
+    return hostTexture ? static_cast<uint64_t>(hostTexture->pixelBytes().size()) : 0u;
 }
 
+struct PrepareWaitState {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool ready = false;
+    BatchPrepareResult result;
+};
+
 static std::vector<io::OutputSaveBinding>
 make_batch_output_saves(const std::vector<io::OutputSaveBinding>& preparedOutputSaves,
                         const std::vector<io::FileOutputBinding>& requestFileOutputs)
@@ -150,6 +155,64 @@ struct BatchPreparedWorkflow::State {
     std::unique_ptr<PreparedWorkflow> workflow;
     const io::IoRuntime* ioRuntime = nullptr;
     std::vector<io::OutputSaveBinding> outputSaves;
+    /// Bytes every run allocates regardless of overrides: pass outputs on the GPU, captures on the host.
+    BatchJobFootprint runFootprint;
+    /// Host texture input sizes keyed by pass/input, used to estimate per-run replacements.
+    std::map<std::string, uint64_t> inputBytes;
+
+    void
+    estimate_footprint(const Workflow& preparedWorkflow)
+    {
+        runFootprint = BatchJobFootprint {};
+        inputBytes.clear();
+        for (size_t passIndex = 0; passIndex < preparedWorkflow.passes.size(); ++passIndex) {
+            const Pass& pass = preparedWorkflow.passes[passIndex];
+            const uint64_t pixelCount = static_cast<uint64_t>(pass.sizeX > 0 ? pass.sizeX : 0)
+                * static_cast<uint64_t>(pass.sizeY > 0 ? pass.sizeY : 0);
+            for (const OutputBinding& output : pass.outputs) {
+                const uint64_t outputBytes = pixelCount * output_format_pixel_bytes(output.format);
+                runFootprint.gpuBytes += outputBytes;
+                if (output.captureToHost) {
+                    runFootprint.hostBytes += outputBytes;
+                }
+            }
+            for (const InputBinding& input : pass.inputs) {
+                if (input.sourceKind != InputSourceKind::hostTexture || !input.hostTexture) {
+                    continue;
+                }
+                inputBytes[make_batch_input_key(passIndex, input.name, input.usesArrayElement, input.arrayElement)] =
+                    host_image_byte_size(input.hostTexture);
+            }
+        }
+    }
+
+    BatchJobFootprint
+    estimate_job_footprint(const BatchSubmitRequest& request) const
+    {
+        BatchJobFootprint footprint = runFootprint;
+        for (const InputOverride& inputOverride : request.settings.overrides) {
+            const uint64_t overrideBytes = host_image_byte_size(inputOverride.hostTexture);
+            footprint.hostBytes += overrideBytes;
+            footprint.gpuBytes += overrideBytes;
+        }
+        for (const io::FileInputOverride& fileInput : request.fileInputs) {
+            // Decoded size is unknown until materialization; prefer the size of the input being replaced,
+            // then fall back to the encoded file size. The reservation is corrected once the file is decoded.
+            uint64_t decodedBytes = 0;
+            const auto inputIt = inputBytes.find(
+                make_batch_input_key(fileInput.passIndex, fileInput.name, fileInput.usesArrayElement, fileInput.arrayElement));
+            if (inputIt != inputBytes.end()) {
+                decodedBytes = inputIt->second;
+            } else {
+                std::error_code sizeError;
+                const std::uintmax_t fileBytes = std::filesystem::file_size(fileInput.path, sizeError);
+                decodedBytes = sizeError ? 0u : static_cast<uint64_t>(fileBytes);
+            }
+            footprint.hostBytes += decodedBytes;
+            footprint.gpuBytes += decodedBytes;
+        }
+        return footprint;
+    }
 };
 
 struct BatchJobHandle::State {
@@ -157,18 +220,25 @@ struct BatchJobHandle::State {
     std::condition_variable condition;
     bool ready = false;
     BatchResult result;
+    BatchJobFootprint footprint;
 };
 
 struct BatchRunner::State {
     struct PrepareTask {
         Workflow workflow;
-        std::vector<io::FileInputBinding> fileInputs;
-        std::vector<io::FileOutputBinding> fileOutputs;
+        std::vector<io::OutputSaveBinding> outputSaves;
+        bool materialized = false;
         std::shared_ptr<PrepareWaitState> waitState;
     };
 
     struct ExecuteTask {
         size_t submitIndex = 0;
+        /// Position in the GPU execution order; only assigned to jobs that enter the worker pipeline.
+        size_t pipelineIndex = 0;
+        /// File inputs have been decoded into host texture overrides in `request.settings`.
+        bool materialized = false;
+        /// Placeholder for a job that finished before execution, keeping the GPU order gap-free.
+        bool skip = false;
         BatchSubmitRequest request;
         std::shared_ptr<BatchPreparedWorkflow::State> workflow;
         std::shared_ptr<BatchJobHandle::State> handle;
@@ -199,6 +269,7 @@ struct BatchRunner::State {
         : session(&runnerSession)
         , ioRuntime(runnerIoRuntime)
         , options(runnerOptions)
+        , prepareQueue(runnerOptions.prepareQueueCapacity)
         , gpuQueue(max_gpu_queue_capacity(runnerOptions))
         , saveQueue(runnerOptions.saveQueueCapacity)
     {
@@ -222,9 +293,22 @@ struct BatchRunner::State {
     std::condition_variable progressCondition;
     BatchProgress progress;
     size_t nextSubmitIndex = 0;
+    size_t nextPipelineIndex = 0;
     bool stopping = false;
+    std::mutex orderMutex;
+    std::map<size_t, ExecuteTask> pendingExecuteTasks;
+    size_t nextExecuteIndex = 0;
+    std::mutex deliveryMutex;
+    std::mutex completionMutex;
+    std::condition_variable completionCondition;
+    std::map<size_t, std::shared_ptr<BatchJobHandle::State>> pendingCompletions;
+    std::deque<std::shared_ptr<BatchJobHandle::State>> completedJobs;
+    size_t nextCompletionIndex = 0;
+    size_t undeliveredJobs = 0;
+    BoundedQueue<ExecuteTask> prepareQueue;
     BoundedQueue<GpuTask> gpuQueue;
     BoundedQueue<SaveTask> saveQueue;
+    std::vector<std::thread> prepareWorkers;
     std::thread gpuWorker;
     std::vector<std::thread> saveWorkers;
 
@@ -234,10 +318,15 @@ struct BatchRunner::State {
         session->releaseExecutionContext();
         gpuWorker = std::thread(&State::gpu_worker_main, this);
 
-        if (!ioRuntime || options.saveWorkerCount == 0) {
+        if (!ioRuntime) {
             return;
         }
 
+        prepareWorkers.reserve(options.prepareWorkerCount);
+        for (uint32_t workerIndex = 0; workerIndex < options.prepareWorkerCount; ++workerIndex) {
+            prepareWorkers.emplace_back(&State::prepare_worker_main, this);
+        }
+
         saveWorkers.reserve(options.saveWorkerCount);
         for (uint32_t workerIndex = 0; workerIndex < options.saveWorkerCount; ++workerIndex) {
             saveWorkers.emplace_back(&State::save_worker_main, this);
@@ -252,10 +341,16 @@ struct BatchRunner::State {
             stopping = true;
         }
 
+        prepareQueue.close();
         gpuQueue.close();
         saveQueue.close();
         progressCondition.notify_all();
 
+        for (size_t workerIndex = 0; workerIndex < prepareWorkers.size(); ++workerIndex) {
+            if (prepareWorkers[workerIndex].joinable()) {
+                prepareWorkers[workerIndex].join();
+            }
+        }
         if (gpuWorker.joinable()) {
             gpuWorker.join();
         }
@@ -295,6 +390,99 @@ struct BatchRunner::State {
         return BatchJobHandle(handleState);
     }
 
+    bool
+    fits_memory_budget(const BatchJobFootprint& footprint) const
+    {
+        // A job larger than the budget is still admitted when nothing else is in flight.
+        if (progress.inFlightJobs == 0) {
+            return true;
+        }
+        if (options.hostMemoryBudgetBytes != 0
+            && progress.reservedHostBytes + footprint.hostBytes > options.hostMemoryBudgetBytes) {
+            return false;
+        }
+        if (options.gpuMemoryBudgetBytes != 0
+            && progress.reservedGpuBytes + footprint.gpuBytes > options.gpuMemoryBudgetBytes) {
+            return false;
+        }
+        return true;
+    }
+
+    void
+    release_job_locked(const BatchJobFootprint& footprint)
+    {
+        if (progress.inFlightJobs > 0) {
+            --progress.inFlightJobs;
+        }
+        progress.reservedHostBytes -= std::min(footprint.hostBytes, progress.reservedHostBytes);
+        progress.reservedGpuBytes -= std::min(footprint.gpuBytes, progress.reservedGpuBytes);
+    }
+
+    void
+    register_completion()
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        ++undeliveredJobs;
+    }
+
+    void
+    publish_completion(const std::shared_ptr<BatchJobHandle::State>& handle, const size_t submitIndex)
+    {
+        // Serializes delivery so callbacks and the completion queue see jobs in one order.
+        std::lock_guard<std::mutex> deliveryLock(deliveryMutex);
+
+        std::vector<std::shared_ptr<BatchJobHandle::State>> deliverable;
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            if (!options.preserveSubmitOrder) {
+                deliverable.push_back(handle);
+            } else {
+                pendingCompletions.emplace(submitIndex, handle);
+                for (auto handleIt = pendingCompletions.find(nextCompletionIndex); handleIt != pendingCompletions.end();
+                     handleIt = pendingCompletions.find(nextCompletionIndex)) {
+                    deliverable.push_back(std::move(handleIt->second));
+                    pendingCompletions.erase(handleIt);
+                    ++nextCompletionIndex;
+                }
+            }
+        }
+        if (deliverable.empty()) {
+            return;
+        }
+
+        // Results are final once a job is ready and are only moved out after being queued below.
+        if (options.onCompleted) {
+            for (const std::shared_ptr<BatchJobHandle::State>& deliveredHandle : deliverable) {
+                try {
+                    options.onCompleted(deliveredHandle->result);
+                } catch (...) {
+                    // A failing callback must not take the worker, and with it every later job, down.
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            if (options.collectCompletions) {
+                completedJobs.insert(completedJobs.end(), deliverable.begin(), deliverable.end());
+            } else {
+                undeliveredJobs -= std::min(deliverable.size(), undeliveredJobs);
+            }
+        }
+        completionCondition.notify_all();
+    }
+
+    static BatchResult
+    take_completed_result(std::shared_ptr<BatchJobHandle::State> handle)
+    {
+        std::lock_guard<std::mutex> lock(handle->mutex);
+        // Once the caller dropped its job handle the runner holds the last reference and can move the result out.
+        if (handle.use_count() == 1) {
+            return std::move(handle->result);
+        }
+        return handle->result;
+    }
+
     bool
     should_stop() const
     {
@@ -320,17 +508,19 @@ struct BatchRunner::State {
         }
         handle->condition.notify_all();
 
-        std::lock_guard<std::mutex> lock(progressMutex);
-        ++progress.cancelledJobs;
-        if (progress.inFlightJobs > 0) {
-            --progress.inFlightJobs;
+        {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            ++progress.cancelledJobs;
+            release_job_locked(handle->footprint);
         }
         progressCondition.notify_all();
+        publish_completion(handle, submitIndex);
     }
 
     void
     finish_result(const std::shared_ptr<BatchJobHandle::State>& handle, BatchResult result)
     {
+        const size_t submitIndex = result.submitIndex;
         const bool cancelled = result.cancelled;
         const bool success = result.runResult.success;
 
@@ -344,18 +534,19 @@ struct BatchRunner::State {
         }
         handle->condition.notify_all();
 
-        std::lock_guard<std::mutex> lock(progressMutex);
-        if (cancelled) {
-            ++progress.cancelledJobs;
-        } else if (success) {
-            ++progress.completedJobs;
-        } else {
-            ++progress.failedJobs;
-        }
-        if (progress.inFlightJobs > 0) {
-            --progress.inFlightJobs;
+        {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            if (cancelled) {
+                ++progress.cancelledJobs;
+            } else if (success) {
+                ++progress.completedJobs;
+            } else {
+                ++progress.failedJobs;
+            }
+            release_job_locked(handle->footprint);
         }
         progressCondition.notify_all();
+        publish_completion(handle, submitIndex);
     }
 
     void
@@ -370,37 +561,9 @@ struct BatchRunner::State {
     }
 
     BatchPrepareResult
-    prepare_workflow(const Workflow& workflow,
-                     const std::vector<io::FileInputBinding>& fileInputs,
-                     const std::vector<io::FileOutputBinding>& fileOutputs)
+    prepare_workflow(PrepareTask& task)
     {
-        if (ioRuntime) {
-            const io::WorkflowMaterializationResult materialized =
-                ioRuntime->materializeWorkflow(workflow, fileInputs, fileOutputs);
-            if (!materialized.success) {
-                BatchPrepareResult result;
-                result.success = false;
-                result.errorMessage = materialized.errorMessage.empty() ? "batch workflow materialization failed"
-                                                                        : materialized.errorMessage;
-                return result;
-            }
-
-            PrepareResult prepareResult = session->prepare(materialized.workflow);
-
-            BatchPrepareResult result;
-            result.success = prepareResult.success;
-            result.errorMessage = std::move(prepareResult.errorMessage);
-            if (prepareResult.workflow) {
-                std::shared_ptr<BatchPreparedWorkflow::State> workflowState = std::make_shared<BatchPreparedWorkflow::State>();
-                workflowState->workflow = std::move(prepareResult.workflow);
-                workflowState->ioRuntime = ioRuntime;
-                workflowState->outputSaves = materialized.outputSaves;
-                result.workflow = std::unique_ptr<BatchPreparedWorkflow>(new BatchPreparedWorkflow(std::move(workflowState)));
-            }
-            return result;
-        }
-
-        PrepareResult prepareResult = session->prepare(workflow);
+        PrepareResult prepareResult = session->prepare(task.workflow);
 
         BatchPrepareResult result;
         result.success = prepareResult.success;
@@ -408,11 +571,138 @@ struct BatchRunner::State {
         if (prepareResult.workflow) {
             std::shared_ptr<BatchPreparedWorkflow::State> workflowState = std::make_shared<BatchPreparedWorkflow::State>();
             workflowState->workflow = std::move(prepareResult.workflow);
+            if (task.materialized) {
+                workflowState->ioRuntime = ioRuntime;
+                workflowState->outputSaves = std::move(task.outputSaves);
+            }
+            workflowState->estimate_footprint(task.workflow);
             result.workflow = std::unique_ptr<BatchPreparedWorkflow>(new BatchPreparedWorkflow(std::move(workflowState)));
         }
         return result;
     }
 
+    bool
+    materialize_execute_task(ExecuteTask& task)
+    {
+        if (task.materialized) {
+            return true;
+        }
+        if (!task.workflow->ioRuntime) {
+            task.materialized = true;
+            return true;
+        }
+
+        io::RunSettingsMaterializationResult materialized = task.workflow->ioRuntime->materializeRunSettings(
+            io::RunRequest { std::move(task.request.settings), std::move(task.request.fileInputs) });
+        if (!materialized.success) {
+            BatchResult result;
+            result.submitIndex = task.submitIndex;
+            result.runResult.success = false;
+            result.runResult.errorMessage = materialized.errorMessage.empty()
+                ? "batch run settings materialization failed"
+                : materialized.errorMessage;
+            finish_result(task.handle, std::move(result));
+            return false;
+        }
+
+        task.request.settings = std::move(materialized.settings);
+        task.request.fileInputs.clear();
+        task.materialized = true;
+        update_job_footprint(task.handle, task.workflow->estimate_job_footprint(task.request));
+        return true;
+    }
+
+    void
+    update_job_footprint(const std::shared_ptr<BatchJobHandle::State>& handle, const BatchJobFootprint& footprint)
+    {
+        {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            {
+                std::lock_guard<std::mutex> handleLock(handle->mutex);
+                if (handle->ready) {
+                    return;
+                }
+            }
+            progress.reservedHostBytes -= std::min(handle->footprint.hostBytes, progress.reservedHostBytes);
+            progress.reservedGpuBytes -= std::min(handle->footprint.gpuBytes, progress.reservedGpuBytes);
+            progress.reservedHostBytes += footprint.hostBytes;
+            progress.reservedGpuBytes += footprint.gpuBytes;
+            handle->footprint = footprint;
+        }
+        progressCondition.notify_all();
+    }
+
+    void
+    forward_to_gpu(ExecuteTask task)
+    {
+        if (!options.preserveSubmitOrder) {
+            if (task.skip) {
+                return;
+            }
+            push_execute_task(std::move(task));
+            return;
+        }
+
+        // Prepare workers finish out of order; release jobs to the GPU worker in pipeline order so
+        // persistent state observes the same run sequence as a serial runner.
+        std::lock_guard<std::mutex> lock(orderMutex);
+        const size_t pipelineIndex = task.pipelineIndex;
+        pendingExecuteTasks.emplace(pipelineIndex, std::move(task));
+        for (auto taskIt = pendingExecuteTasks.find(nextExecuteIndex); taskIt != pendingExecuteTasks.end();
+             taskIt = pendingExecuteTasks.find(nextExecuteIndex)) {
+            ExecuteTask readyTask = std::move(taskIt->second);
+            pendingExecuteTasks.erase(taskIt);
+            ++nextExecuteIndex;
+            if (!readyTask.skip) {
+                push_execute_task(std::move(readyTask));
+            }
+        }
+    }
+
+    void
+    forward_skipped(const size_t pipelineIndex)
+    {
+        ExecuteTask task;
+        task.pipelineIndex = pipelineIndex;
+        task.skip = true;
+        forward_to_gpu(std::move(task));
+    }
+
+    void
+    push_execute_task(ExecuteTask task)
+    {
+        const std::shared_ptr<BatchJobHandle::State> handle = task.handle;
+        const size_t submitIndex = task.submitIndex;
+
+        GpuTask gpuTask;
+        gpuTask.kind = GpuTask::Kind::execute;
+        gpuTask.executeTask = std::move(task);
+        if (!gpuQueue.push(std::move(gpuTask))) {
+            finish_cancelled(handle, submitIndex, "batch runner stopped");
+        }
+    }
+
+    void
+    prepare_worker_main()
+    {
+        ExecuteTask task;
+        while (prepareQueue.pop(task)) {
+            const size_t pipelineIndex = task.pipelineIndex;
+            if (should_stop()) {
+                finish_cancelled(task.handle, task.submitIndex, "batch runner stopped");
+                forward_skipped(pipelineIndex);
+            } else if (cancellation_requested(task.cancellation)) {
+                finish_cancelled(task.handle, task.submitIndex, "batch job cancelled before execution");
+                forward_skipped(pipelineIndex);
+            } else if (!materialize_execute_task(task)) {
+                forward_skipped(pipelineIndex);
+            } else {
+                forward_to_gpu(std::move(task));
+            }
+            task = ExecuteTask {};
+        }
+    }
+
     void
     gpu_worker_main()
     {
@@ -429,15 +719,12 @@ struct BatchRunner::State {
                     task = GpuTask {};
                     continue;
                 }
-                complete_prepare(task.prepareTask.waitState,
-                                 prepare_workflow(task.prepareTask.workflow,
-                                                  task.prepareTask.fileInputs,
-                                                  task.prepareTask.fileOutputs));
+                complete_prepare(task.prepareTask.waitState, prepare_workflow(task.prepareTask));
                 task = GpuTask {};
                 continue;
             }
 
-            const ExecuteTask& executeTask = task.executeTask;
+            ExecuteTask& executeTask = task.executeTask;
             if (should_stop()) {
                 finish_cancelled(executeTask.handle, executeTask.submitIndex, "batch runner stopped");
                 task = GpuTask {};
@@ -449,23 +736,10 @@ struct BatchRunner::State {
                 continue;
             }
 
-            RunSettings effectiveSettings = executeTask.request.settings;
-            if (executeTask.workflow->ioRuntime) {
-                io::RunSettingsMaterializationResult materialized =
-                    executeTask.workflow->ioRuntime->materializeRunSettings(
-                        io::RunRequest { executeTask.request.settings, executeTask.request.fileInputs });
-                if (!materialized.success) {
-                    BatchResult result;
-                    result.submitIndex = executeTask.submitIndex;
-                    result.runResult.success = false;
-                    result.runResult.errorMessage = materialized.errorMessage.empty()
-                        ? "batch run settings materialization failed"
-                        : materialized.errorMessage;
-                    finish_result(executeTask.handle, std::move(result));
-                    task = GpuTask {};
-                    continue;
-                }
-                effectiveSettings = std::move(materialized.settings);
+            // Without prepare workers the GPU worker still decodes file inputs itself.
+            if (!materialize_execute_task(executeTask)) {
+                task = GpuTask {};
+                continue;
             }
 
             if (cancellation_requested(executeTask.cancellation)) {
@@ -476,7 +750,7 @@ struct BatchRunner::State {
 
             BatchResult result;
             result.submitIndex = executeTask.submitIndex;
-            result.runResult = executeTask.workflow->workflow->run(effectiveSettings);
+            result.runResult = executeTask.workflow->workflow->run(executeTask.request.settings);
 
             if (!result.runResult.success) {
                 finish_result(executeTask.handle, std::move(result));
@@ -634,6 +908,33 @@ BatchJobHandle::wait() const
     return m_state->result;
 }
 
+bool
+BatchJobHandle::isReady() const
+{
+    if (!m_state) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->ready;
+}
+
+bool
+BatchJobHandle::waitFor(const std::chrono::milliseconds timeout, BatchResult& outResult) const
+{
+    if (!m_state) {
+        outResult = wait();
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    if (!m_state->condition.wait_for(lock, timeout, [this]() { return m_state->ready; })) {
+        return false;
+    }
+    outResult = m_state->result;
+    return true;
+}
+
 BatchRunner::BatchRunner(Session& session, const BatchRunnerOptions& options)
     : m_state(std::make_unique<State>(session, nullptr, options))
 {
@@ -666,11 +967,26 @@ BatchRunner::prepare(const Workflow& workflow,
     std::shared_ptr<PrepareWaitState> waitState = std::make_shared<PrepareWaitState>();
     State::GpuTask task;
     task.kind = State::GpuTask::Kind::prepare;
-    task.prepareTask.workflow = clone_batch_workflow(workflow);
-    task.prepareTask.fileInputs = fileInputs;
-    task.prepareTask.fileOutputs = fileOutputs;
     task.prepareTask.waitState = waitState;
 
+    // File decode runs on the calling thread so the GPU worker only prepares GPU resources.
+    if (m_state->ioRuntime) {
+        io::WorkflowMaterializationResult materialized =
+            m_state->ioRuntime->materializeWorkflow(workflow, fileInputs, fileOutputs);
+        if (!materialized.success) {
+            BatchPrepareResult result;
+            result.success = false;
+            result.errorMessage = materialized.errorMessage.empty() ? "batch workflow materialization failed"
+                                                                    : materialized.errorMessage;
+            return result;
+        }
+        task.prepareTask.workflow = std::move(materialized.workflow);
+        task.prepareTask.outputSaves = std::move(materialized.outputSaves);
+        task.prepareTask.materialized = true;
+    } else {
+        task.prepareTask.workflow = workflow;
+    }
+
     if (!m_state->gpuQueue.push(std::move(task))) {
         BatchPrepareResult result;
         result.success = false;
@@ -697,17 +1013,24 @@ BatchRunner::submit(const BatchPreparedWorkflow& workflow,
         return m_state->make_ready_handle(0, "batch prepared workflow is empty", false);
     }
 
+    const BatchJobFootprint footprint = workflow.m_state->estimate_job_footprint(request);
+
     std::unique_lock<std::mutex> progressLock(m_state->progressMutex);
-    while (!m_state->stopping && m_state->progress.inFlightJobs >= m_state->options.maxInFlightJobs) {
+    while (!m_state->stopping
+           && (m_state->progress.inFlightJobs >= m_state->options.maxInFlightJobs
+               || !m_state->fits_memory_budget(footprint))) {
         m_state->progressCondition.wait(progressLock);
     }
 
     const size_t submitIndex = m_state->nextSubmitIndex;
     ++m_state->nextSubmitIndex;
+    m_state->register_completion();
 
     if (m_state->stopping) {
         progressLock.unlock();
-        return m_state->make_ready_handle(submitIndex, "batch runner stopped", true);
+        BatchJobHandle handle = m_state->make_ready_handle(submitIndex, "batch runner stopped", true);
+        m_state->publish_completion(handle.m_state, submitIndex);
+        return handle;
     }
 
     if (cancellation && m_state->cancellation_requested(cancellation->m_state)) {
@@ -715,42 +1038,37 @@ BatchRunner::submit(const BatchPreparedWorkflow& workflow,
         ++m_state->progress.cancelledJobs;
         progressLock.unlock();
         m_state->progressCondition.notify_all();
-        return m_state->make_ready_handle(submitIndex, "batch job cancelled before submission", true);
+        BatchJobHandle handle = m_state->make_ready_handle(submitIndex, "batch job cancelled before submission", true);
+        m_state->publish_completion(handle.m_state, submitIndex);
+        return handle;
     }
 
     std::shared_ptr<BatchJobHandle::State> handleState = std::make_shared<BatchJobHandle::State>();
+    handleState->footprint = footprint;
     ++m_state->progress.submittedJobs;
     ++m_state->progress.inFlightJobs;
+    m_state->progress.reservedHostBytes += footprint.hostBytes;
+    m_state->progress.reservedGpuBytes += footprint.gpuBytes;
+    const size_t pipelineIndex = m_state->nextPipelineIndex;
+    ++m_state->nextPipelineIndex;
     progressLock.unlock();
 
-    State::GpuTask task;
-    task.kind = State::GpuTask::Kind::execute;
-    task.executeTask.submitIndex = submitIndex;
-    task.executeTask.request = clone_batch_submit_request(request);
-    task.executeTask.workflow = workflow.m_state;
-    task.executeTask.handle = handleState;
+    State::ExecuteTask task;
+    task.submitIndex = submitIndex;
+    task.pipelineIndex = pipelineIndex;
+    task.request = request;
+    task.workflow = workflow.m_state;
+    task.handle = handleState;
+    task.materialized = !workflow.m_state->ioRuntime || request.fileInputs.empty();
     if (cancellation) {
-        task.executeTask.cancellation = cancellation->m_state;
+        task.cancellation = cancellation->m_state;
     }
 
-    if (!m_state->gpuQueue.push(std::move(task))) {
-        BatchResult result;
-        result.submitIndex = submitIndex;
-        result.runResult.success = false;
-        result.runResult.errorMessage = "batch execute queue is closed";
-        {
-            std::lock_guard<std::mutex> lock(handleState->mutex);
-            handleState->ready = true;
-            handleState->result = result;
-        }
-        handleState->condition.notify_all();
-
-        std::lock_guard<std::mutex> lock(m_state->progressMutex);
-        ++m_state->progress.failedJobs;
-        if (m_state->progress.inFlightJobs > 0) {
-            --m_state->progress.inFlightJobs;
-        }
-        m_state->progressCondition.notify_all();
+    if (task.materialized || m_state->prepareWorkers.empty()) {
+        m_state->forward_to_gpu(std::move(task));
+    } else if (!m_state->prepareQueue.push(std::move(task))) {
+        m_state->finish_cancelled(handleState, submitIndex, "batch runner stopped");
+        m_state->forward_skipped(pipelineIndex);
     }
 
     return BatchJobHandle(handleState);
@@ -767,6 +1085,53 @@ BatchRunner::progress() const
     return m_state->progress;
 }
 
+bool
+BatchRunner::waitNextCompleted(BatchResult& outResult)
+{
+    if (!m_state) {
+        return false;
+    }
+
+    if (!m_state->options.collectCompletions) {
+        return false;
+    }
+
+    std::shared_ptr<BatchJobHandle::State> handle;
+    {
+        std::unique_lock<std::mutex> lock(m_state->completionMutex);
+        while (m_state->completedJobs.empty() && m_state->undeliveredJobs > 0) {
+            m_state->completionCondition.wait(lock);
+        }
+        if (m_state->completedJobs.empty()) {
+            return false;
+        }
+
+        handle = std::move(m_state->completedJobs.front());
+        m_state->completedJobs.pop_front();
+        --m_state->undeliveredJobs;
+    }
+
+    outResult = State::take_completed_result(std::move(handle));
+    return true;
+}
+
+std::vector<BatchResult>
+BatchRunner::drain()
+{
+    if (m_state && !m_state->options.collectCompletions) {
+        std::unique_lock<std::mutex> lock(m_state->completionMutex);
+        m_state->completionCondition.wait(lock, [this]() { return m_state->undeliveredJobs == 0; });
+        return {};
+    }
+
+    std::vector<BatchResult> results;
+    BatchResult result;
+    while (waitNextCompleted(result)) {
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
 void
 BatchRunner::close()
 {
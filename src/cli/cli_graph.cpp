@@ -223,6 +223,22 @@ parse_jpeg_load_color_transform(const std::string& text, const char* context)
     throw std::runtime_error(std::string(context) + ": unsupported JPEG color transform: " + text);
 }
 
+static io::JpegDctMethod
+parse_jpeg_dct_method(const std::string& text, const char* context)
+{
+    const std::string value = normalize_option_value(text);
+    if (value == "accurate" || value == "islow") {
+        return io::JpegDctMethod::Accurate;
+    }
+    if (value == "fast" || value == "ifast") {
+        return io::JpegDctMethod::Fast;
+    }
+    if (value == "float") {
+        return io::JpegDctMethod::Float;
+    }
+    throw std::runtime_error(std::string(context) + ": unsupported JPEG DCT method: " + text);
+}
+
 static io::OpenExrChannelSelection
 parse_openexr_channel_selection(const std::string& text, const char* context)
 {
@@ -715,10 +731,12 @@ translate_input_attribute_option(const CommandLineParsedOption& option, GraphTra
 static bool
 is_input_codec_option(const std::string& optionName)
 {
-    return optionName == "in_backend" || optionName == "in_jpeg_color_transform"
+    return optionName == "in_backend" || optionName == "in_decode_scale" || optionName == "in_jpeg_color_transform"
+        || optionName == "in_jpeg_dct_method" || optionName == "in_jpeg_fancy_upsampling"
         || optionName == "in_png_expand_transparency" || optionName == "in_tiff_directory_index"
-        || optionName == "in_exr_channels" || optionName == "in_jpeg2000_reduce_factor"
-        || optionName == "in_jpeg2000_layer_limit";
+        || optionName == "in_exr_channels" || optionName == "in_exr_threads"
+        || optionName == "in_jpeg2000_reduce_factor" || optionName == "in_jpeg2000_layer_limit"
+        || optionName == "in_jpeg2000_region" || optionName == "in_jpeg2000_threads";
 }
 
 static bool
@@ -726,6 +744,7 @@ is_output_codec_option(const std::string& optionName)
 {
     return optionName == "out_jpeg_quality" || optionName == "out_jpeg_progressive"
         || optionName == "out_jpeg_optimize" || optionName == "out_jpeg_subsampling"
+        || optionName == "out_jpeg_dct_method"
         || optionName == "out_png_compression" || optionName == "out_png_interlace"
         || optionName == "out_tiff_compression" || optionName == "out_tiff_predictor"
         || optionName == "out_tiff_layout" || optionName == "out_tiff_tile_size"
@@ -736,8 +755,10 @@ is_output_codec_option(const std::string& optionName)
         || optionName == "out_tiff_webp_lossless" || optionName == "out_tiff_webp_lossless_exact"
         || optionName == "out_exr_compression" || optionName == "out_exr_layout"
         || optionName == "out_exr_tile_size" || optionName == "out_exr_line_order"
-        || optionName == "out_exr_dwa_level" || optionName == "out_jpeg2000_lossless"
-        || optionName == "out_jpeg2000_compression_ratio" || optionName == "out_jpeg2000_quality";
+        || optionName == "out_exr_dwa_level" || optionName == "out_exr_threads"
+        || optionName == "out_jpeg2000_lossless"
+        || optionName == "out_jpeg2000_compression_ratio" || optionName == "out_jpeg2000_quality"
+        || optionName == "out_jpeg2000_threads";
 }
 
 static void
@@ -757,6 +778,12 @@ translate_input_codec_option(const CommandLineParsedOption& option, GraphTransla
         return;
     }
 
+    if (option.string_key == "in_decode_scale") {
+        codecOptions.hasDecodeScale = true;
+        codecOptions.decodeScale = parse_positive_u32(option.value[0], "in_decode_scale");
+        return;
+    }
+
     if (option.string_key == "in_jpeg_color_transform") {
         codecOptions.hasJpeg = true;
         codecOptions.jpeg.hasColorTransform = true;
@@ -765,6 +792,20 @@ translate_input_codec_option(const CommandLineParsedOption& option, GraphTransla
         return;
     }
 
+    if (option.string_key == "in_jpeg_dct_method") {
+        codecOptions.hasJpeg = true;
+        codecOptions.jpeg.hasDctMethod = true;
+        codecOptions.jpeg.dctMethod = parse_jpeg_dct_method(option.value[0], "in_jpeg_dct_method");
+        return;
+    }
+
+    if (option.string_key == "in_jpeg_fancy_upsampling") {
+        codecOptions.hasJpeg = true;
+        codecOptions.jpeg.hasFancyUpsampling = true;
+        codecOptions.jpeg.fancyUpsampling = parse_bool_value(option.value[0], "in_jpeg_fancy_upsampling");
+        return;
+    }
+
     if (option.string_key == "in_png_expand_transparency") {
         codecOptions.hasPng = true;
         codecOptions.png.hasExpandTransparency = true;
@@ -787,6 +828,13 @@ translate_input_codec_option(const CommandLineParsedOption& option, GraphTransla
         return;
     }
 
+    if (option.string_key == "in_exr_threads") {
+        codecOptions.hasOpenExr = true;
+        codecOptions.openExr.hasThreadCount = true;
+        codecOptions.openExr.threadCount = parse_positive_u32(option.value[0], "in_exr_threads");
+        return;
+    }
+
     if (option.string_key == "in_jpeg2000_reduce_factor") {
         codecOptions.hasJpeg2000 = true;
         codecOptions.jpeg2000.hasReduceFactor = true;
@@ -800,6 +848,26 @@ translate_input_codec_option(const CommandLineParsedOption& option, GraphTransla
         codecOptions.jpeg2000.layerLimit = parse_non_negative_u32(option.value[0], "in_jpeg2000_layer_limit");
         return;
     }
+
+    if (option.string_key == "in_jpeg2000_region") {
+        if (option.value.size() != 4u) {
+            throw std::runtime_error("in_jpeg2000_region: must have 4 parameters.");
+        }
+        codecOptions.hasJpeg2000 = true;
+        codecOptions.jpeg2000.hasRegion = true;
+        codecOptions.jpeg2000.regionX = parse_non_negative_u32(option.value[0], "in_jpeg2000_region");
+        codecOptions.jpeg2000.regionY = parse_non_negative_u32(option.value[1], "in_jpeg2000_region");
+        codecOptions.jpeg2000.regionWidth = parse_positive_u32(option.value[2], "in_jpeg2000_region");
+        codecOptions.jpeg2000.regionHeight = parse_positive_u32(option.value[3], "in_jpeg2000_region");
+        return;
+    }
+
+    if (option.string_key == "in_jpeg2000_threads") {
+        codecOptions.hasJpeg2000 = true;
+        codecOptions.jpeg2000.hasThreadCount = true;
+        codecOptions.jpeg2000.threadCount = parse_positive_u32(option.value[0], "in_jpeg2000_threads");
+        return;
+    }
 }
 
 static void
@@ -871,6 +939,13 @@ translate_output_codec_option(const CommandLineParsedOption& option, GraphTransl
         return;
     }
 
+    if (option.string_key == "out_jpeg_dct_method") {
+        codecOptions.hasJpeg = true;
+        codecOptions.jpeg.hasDctMethod = true;
+        codecOptions.jpeg.dctMethod = parse_jpeg_dct_method(option.value[0], "out_jpeg_dct_method");
+        return;
+    }
+
     if (option.string_key == "out_png_compression") {
         codecOptions.hasPng = true;
         codecOptions.png.hasCompressionLevel = true;
@@ -1022,6 +1097,13 @@ translate_output_codec_option(const CommandLineParsedOption& option, GraphTransl
         return;
     }
 
+    if (option.string_key == "out_exr_threads") {
+        codecOptions.hasOpenExr = true;
+        codecOptions.openExr.hasThreadCount = true;
+        codecOptions.openExr.threadCount = parse_positive_u32(option.value[0], "out_exr_threads");
+        return;
+    }
+
     if (option.string_key == "out_jpeg2000_lossless") {
         codecOptions.hasJpeg2000 = true;
         codecOptions.jpeg2000.hasLossless = true;
@@ -1043,6 +1125,13 @@ translate_output_codec_option(const CommandLineParsedOption& option, GraphTransl
         codecOptions.jpeg2000.quality = parse_numeric_value<float_t>(option.value[0], "out_jpeg2000_quality");
         return;
     }
+
+    if (option.string_key == "out_jpeg2000_threads") {
+        codecOptions.hasJpeg2000 = true;
+        codecOptions.jpeg2000.hasThreadCount = true;
+        codecOptions.jpeg2000.threadCount = parse_positive_u32(option.value[0], "out_jpeg2000_threads");
+        return;
+    }
 }
 
 static void
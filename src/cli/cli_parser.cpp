@@ -34,6 +34,7 @@ static const ParsedOptionSpec RAWGL_OPTION_SPECS[] = {
     { "version", 'v', ParsedOptionMode::flag },
     { "doctor", '\0', ParsedOptionMode::flag },
     { "gl_platform", '\0', ParsedOptionMode::single },
+    { "gl_errors", '\0', ParsedOptionMode::single },
     { "verbosity", 'V', ParsedOptionMode::single },
     { "pass_vertfrag", 'P', ParsedOptionMode::multi },
     { "pass_comp", 'C', ParsedOptionMode::single },
@@ -44,12 +45,18 @@ static const ParsedOptionSpec RAWGL_OPTION_SPECS[] = {
     { "pass_mesh", 'M', ParsedOptionMode::multi },
     { "in", 'i', ParsedOptionMode::multi },
     { "in_backend", '\0', ParsedOptionMode::single },
+    { "in_decode_scale", '\0', ParsedOptionMode::single },
     { "in_jpeg_color_transform", '\0', ParsedOptionMode::single },
+    { "in_jpeg_dct_method", '\0', ParsedOptionMode::single },
+    { "in_jpeg_fancy_upsampling", '\0', ParsedOptionMode::single },
     { "in_png_expand_transparency", '\0', ParsedOptionMode::single },
     { "in_tiff_directory_index", '\0', ParsedOptionMode::single },
     { "in_exr_channels", '\0', ParsedOptionMode::single },
+    { "in_exr_threads", '\0', ParsedOptionMode::single },
     { "in_jpeg2000_reduce_factor", '\0', ParsedOptionMode::single },
     { "in_jpeg2000_layer_limit", '\0', ParsedOptionMode::single },
+    { "in_jpeg2000_region", '\0', ParsedOptionMode::multi },
+    { "in_jpeg2000_threads", '\0', ParsedOptionMode::single },
     { "atomic", 'B', ParsedOptionMode::multi },
     { "in_attr", 't', ParsedOptionMode::multi },
     { "out", 'o', ParsedOptionMode::multi },
@@ -62,6 +69,7 @@ static const ParsedOptionSpec RAWGL_OPTION_SPECS[] = {
     { "out_jpeg_progressive", '\0', ParsedOptionMode::single },
     { "out_jpeg_optimize", '\0', ParsedOptionMode::single },
     { "out_jpeg_subsampling", '\0', ParsedOptionMode::single },
+    { "out_jpeg_dct_method", '\0', ParsedOptionMode::single },
     { "out_png_compression", '\0', ParsedOptionMode::single },
     { "out_png_interlace", '\0', ParsedOptionMode::single },
     { "out_tiff_compression", '\0', ParsedOptionMode::single },
@@ -83,9 +91,11 @@ static const ParsedOptionSpec RAWGL_OPTION_SPECS[] = {
     { "out_exr_tile_size", '\0', ParsedOptionMode::multi },
     { "out_exr_line_order", '\0', ParsedOptionMode::single },
     { "out_exr_dwa_level", '\0', ParsedOptionMode::single },
+    { "out_exr_threads", '\0', ParsedOptionMode::single },
     { "out_jpeg2000_lossless", '\0', ParsedOptionMode::single },
     { "out_jpeg2000_compression_ratio", '\0', ParsedOptionMode::single },
     { "out_jpeg2000_quality", '\0', ParsedOptionMode::single },
+    { "out_jpeg2000_threads", '\0', ParsedOptionMode::single },
 };
 
 static const ParsedOptionSpec*
@@ -139,6 +149,7 @@ build_help_text()
            << "  --version, -v\n"
            << "  --doctor\n"
            << "  --gl_platform <auto|x11|wayland>\n"
+           << "  --gl_errors <call|pass|off>\n"
            << "  --verbosity, -V <0-5>\n"
            << "  --pass_vertfrag, -P <file> [file]\n"
            << "  --pass_comp, -C <file>\n"
@@ -149,12 +160,18 @@ build_help_text()
            << "  --pass_mesh, -M <quad|mesh> ...\n"
            << "  --in, -i <uniform> <value...>\n"
            << "  --in_backend <auto|native|native_only|openimageio|openimageio_only>\n"
+           << "  --in_decode_scale <1|2|4|8|...>\n"
            << "  --in_jpeg_color_transform <auto|rgb|grayscale>\n"
+           << "  --in_jpeg_dct_method <accurate|fast|float>\n"
+           << "  --in_jpeg_fancy_upsampling <true|false>\n"
            << "  --in_png_expand_transparency <true|false>\n"
            << "  --in_tiff_directory_index <index>\n"
            << "  --in_exr_channels <auto|luminance|rgb|rgba|all>\n"
+           << "  --in_exr_threads <count>\n"
            << "  --in_jpeg2000_reduce_factor <levels>\n"
            << "  --in_jpeg2000_layer_limit <layers>\n"
+           << "  --in_jpeg2000_region <x> <y> <width> <height>\n"
+           << "  --in_jpeg2000_threads <count>\n"
            << "  --atomic, -B <mode> <args...>\n"
            << "  --in_attr, -t <name> <value>\n"
            << "  --out, -o <name> <path>\n"
@@ -167,6 +184,7 @@ build_help_text()
            << "  --out_jpeg_progressive <true|false>\n"
            << "  --out_jpeg_optimize <true|false>\n"
            << "  --out_jpeg_subsampling <default|444|422|420|440|411>\n"
+           << "  --out_jpeg_dct_method <accurate|fast|float>\n"
            << "  --out_png_compression <0-9>\n"
            << "  --out_png_interlace <true|false>\n"
            << "  --out_tiff_compression <none|lzw|packbits|deflate|jpeg|zstd|...>\n"
@@ -188,9 +206,11 @@ build_help_text()
            << "  --out_exr_tile_size <width> [height]\n"
            << "  --out_exr_line_order <increasing_y|decreasing_y|random_y>\n"
            << "  --out_exr_dwa_level <float>\n"
+           << "  --out_exr_threads <count>\n"
            << "  --out_jpeg2000_lossless <true|false>\n"
            << "  --out_jpeg2000_compression_ratio <float>\n"
-           << "  --out_jpeg2000_quality <float>\n\n"
+           << "  --out_jpeg2000_quality <float>\n"
+           << "  --out_jpeg2000_threads <count>\n\n"
            << "Supported texture attributes:\n"
            << GetTextureAttributeHelpText() << '\n'
            << "Supported mesh attributes:\n"
@@ -228,6 +248,7 @@ print_runtime_info(const rawgl::RuntimeInfo& info)
         std::cout << "  OpenGL version: " << info.version << '\n';
         std::cout << "  GLSL version: " << info.shadingLanguageVersion << '\n';
         std::cout << "  Software renderer: " << (info.softwareRenderer ? "yes" : "no") << '\n';
+        std::cout << "  OpenGL error checks: " << info.glErrorPolicy << '\n';
         if (info.softwareRenderer) {
             std::cout << "  Warning: RawGL is running through a software OpenGL renderer.\n";
         }
@@ -296,6 +317,12 @@ ParseCommandLineArguments(int argc, const char* argv[])
             continue;
         }
 
+        if (option.string_key == "gl_errors") {
+            parsed.glErrors    = option.value[0];
+            parsed.hasGlErrors = true;
+            continue;
+        }
+
         parsed.options.push_back(std::move(option));
     }
 
@@ -320,7 +347,9 @@ HandleImmediateParsedArguments(const CommandLineParsedArguments& parsedArguments
     }
 
     if (parsedArguments.showDoctor) {
-        const rawgl::RuntimeInfo info = rawgl::ProbeRuntimeInfo();
+        rawgl::ContextOptions contextOptions;
+        contextOptions.glErrorPolicy = parsedArguments.glErrors;
+        const rawgl::RuntimeInfo info = rawgl::ProbeRuntimeInfo(contextOptions);
         print_runtime_info(info);
         exitCode      = info.success ? 0 : 1;
         immediateExit = true;
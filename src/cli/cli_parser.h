@@ -17,6 +17,8 @@ struct CommandLineParsedArguments {
     bool showDoctor  = false;
     bool hasGlPlatform = false;
     std::string glPlatform;
+    bool hasGlErrors = false;
+    std::string glErrors;
     int verbosity    = 3;
     std::vector<CommandLineParsedOption> options;
 };
@@ -29,75 +29,28 @@ const int APP_VERSION[] = { RAWGL_VERSION_MAJOR, RAWGL_VERSION_MINOR, RAWGL_VERS
 namespace rawgl {
 
 namespace {
-static GLenum
-infer_texture_type_from_internal_format(const GLenum internalFormat)
-{
-    switch (internalFormat) {
-    case GL_R8:
-    case GL_RG8:
-    case GL_RGB8:
-    case GL_RGBA8: return GL_UNSIGNED_BYTE;
-    case GL_R16:
-    case GL_RG16:
-    case GL_RGB16:
-    case GL_RGBA16: return GL_UNSIGNED_SHORT;
-    case GL_R32UI:
-    case GL_RG32UI:
-    case GL_RGB32UI:
-    case GL_RGBA32UI: return GL_UNSIGNED_INT;
-    case GL_R16F:
-    case GL_RG16F:
-    case GL_RGB16F:
-    case GL_RGBA16F: return GL_HALF_FLOAT;
-    case GL_R32F:
-    case GL_RG32F:
-    case GL_RGB32F:
-    case GL_RGBA32F: return GL_FLOAT;
-    default: return GL_FLOAT;
-    }
-}
-
-static size_t
-byte_size_for_gl_type(const GLenum type)
-{
-    switch (type) {
-    case GL_UNSIGNED_BYTE: return 1u;
-    case GL_UNSIGNED_SHORT:
-    case GL_HALF_FLOAT: return 2u;
-    case GL_UNSIGNED_INT:
-    case GL_FLOAT: return 4u;
-    default: break;
-    }
-
-    return 0u;
-}
-
 static HostImageData
-capture_texture_to_host_image(const Texture& texture)
+capture_output_to_host_image(Sequence& sequence, const size_t passIndex, const std::string& outputName)
 {
-    HostImageData hostImage;
-    hostImage.width            = texture.getWidth();
-    hostImage.height           = texture.getHeight();
-    hostImage.channels         = texture.getChannels();
-    hostImage.alphaChannel     = texture.getAlphaChannel();
-    hostImage.glInternalFormat = texture.getInternalFormat();
-    hostImage.glType           = infer_texture_type_from_internal_format(texture.getInternalFormat());
-
-    const size_t bytesPerComponent = byte_size_for_gl_type(hostImage.glType);
-    if (bytesPerComponent == 0u) {
-        throw std::runtime_error("Unsupported texture readback type");
+    std::shared_ptr<Texture> outputTexture = sequence.getPassOutputTexture(passIndex, outputName);
+    if (!outputTexture) {
+        throw std::runtime_error("output capture failed for " + outputName);
     }
 
-    const size_t byteCount = static_cast<size_t>(hostImage.width) * static_cast<size_t>(hostImage.height)
-                             * static_cast<size_t>(hostImage.channels) * bytesPerComponent;
-    void* data             = texture.getData(hostImage.glType);
-    if (!data) {
-        throw std::runtime_error("Texture readback failed");
+    HostImageData hostImage;
+    hostImage.width            = outputTexture->getWidth();
+    hostImage.height           = outputTexture->getHeight();
+    hostImage.channels         = outputTexture->getChannels();
+    hostImage.alphaChannel     = outputTexture->getAlphaChannel();
+    hostImage.glInternalFormat = outputTexture->getInternalFormat();
+    hostImage.glType           = sequence.getPassOutputReadbackType(passIndex, outputName);
+    if (hostImage.glType != texture_readback_type(hostImage.glInternalFormat)) {
+        // Packed on the GPU into the sample type the output requested, so describe it as that unorm format.
+        hostImage.glInternalFormat = texture_unorm_internal_format(hostImage.channels, hostImage.glType);
     }
 
-    hostImage.bytes.resize(byteCount);
-    std::memcpy(hostImage.bytes.data(), data, byteCount);
-    std::free(data);
+    // Completes the transfer queued at the end of Sequence::run when one is pending.
+    sequence.readPassOutputData(passIndex, outputName, hostImage.glType, hostImage.bytes);
     return hostImage;
 }
 
@@ -113,13 +66,8 @@ ensure_captured_output_image(Sequence& sequence,
         return imageIt->second;
     }
 
-    std::shared_ptr<Texture> outputTexture = sequence.getPassOutputTexture(passIndex, outputName);
-    if (!outputTexture) {
-        throw std::runtime_error("output capture failed for " + outputName);
-    }
-
     auto [insertedIt, inserted] =
-        capturedImages.insert({ outputKey, capture_texture_to_host_image(*outputTexture) });
+        capturedImages.insert({ outputKey, capture_output_to_host_image(sequence, passIndex, outputName) });
     (void)inserted;
     return insertedIt->second;
 }
@@ -131,7 +79,7 @@ clone_texture_resource(const std::shared_ptr<Texture>& sourceTexture)
         sourceTexture->getWidth(),
         sourceTexture->getHeight(),
         sourceTexture->getInternalFormat(),
-        infer_texture_type_from_internal_format(sourceTexture->getInternalFormat()),
+        texture_readback_type(sourceTexture->getInternalFormat()),
         nullptr);
 
     GLCall(glCopyImageSubData(sourceTexture->getId(), GL_TEXTURE_2D, 0, 0, 0, 0,
@@ -141,6 +89,20 @@ clone_texture_resource(const std::shared_ptr<Texture>& sourceTexture)
     return cloneTexture;
 }
 
+// True when `texture` is still bound as an output of the sequence, which happens when the previous run failed before
+// its outputs were released. Reading it in place would alias the pass that writes it.
+static bool
+is_run_output_texture(const RawGLGraphState& state, const std::shared_ptr<Texture>& texture)
+{
+    for (const RawGLGraphState::PersistentOutputBinding& persistentOutput : state.executionPlan.persistentOutputs) {
+        if (state.sequence->getPassOutputTexture(persistentOutput.passIndex, persistentOutput.outputName) == texture) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 static bool
 has_sequence_override(const std::vector<SequenceExecutionInputOverride>& inputOverrides,
                       const size_t passIndex,
@@ -166,9 +128,10 @@ inspect_shader_interface_from_session(const void* userData,
 
 }  // namespace
 
-RawGLContext::RawGLContext()
-    : m_state(std::make_shared<RawGLContextState>())
+RawGLContext::RawGLContext(const ContextOptions& options)
+    : m_state(std::make_shared<RawGLContextState>(options))
 {
+    m_state->outputTexturePool = std::make_shared<TexturePool>(options.outputTexturePoolBudgetBytes);
     m_state->ioRuntime = std::make_shared<rawgl::io::IoRuntimeService>();
     Log_Init();
 }
@@ -218,7 +181,11 @@ RawGLContext::cacheStats() const
     }
     {
         std::shared_lock<std::shared_mutex> readLock(m_state->textureCacheMutex);
-        stats.textures = m_state->textureCache.size();
+        stats.textures         = m_state->textureCache.size();
+        stats.textureBytes     = m_state->textureCacheBytes;
+        stats.textureHits      = m_state->textureCacheHits;
+        stats.textureMisses    = m_state->textureCacheMisses;
+        stats.textureEvictions = m_state->textureCacheEvictions;
     }
     {
         std::shared_lock<std::shared_mutex> readLock(m_state->meshCacheMutex);
@@ -229,6 +196,13 @@ RawGLContext::cacheStats() const
         stats.meshesGpu = m_state->meshGpuCache.size();
     }
 
+    const TexturePool::Stats poolStats = m_state->outputTexturePool->stats();
+    stats.outputTexturesPooled       = poolStats.textures;
+    stats.outputTexturePoolBytes     = poolStats.bytes;
+    stats.outputTexturePoolHits      = poolStats.hits;
+    stats.outputTexturePoolMisses    = poolStats.misses;
+    stats.outputTexturePoolEvictions = poolStats.evictions;
+
     return stats;
 }
 
@@ -270,17 +244,35 @@ RawGLGraph::execute(const GraphExecutionRequest& request)
         for (const GraphMeshOverride& meshOverride : request.meshOverrides) {
             meshOverrides.push_back(build_sequence_execution_mesh_override(meshOverride));
         }
-        std::map<std::string, std::shared_ptr<Texture>> persistentTextureSnapshot;
-        for (const auto& persistentTexture : m_state->persistentTextures) {
-            persistentTextureSnapshot[persistentTexture.first] = clone_texture_resource(persistentTexture.second);
+        if (!m_state->sequence) {
+            m_state->sequence = std::make_unique<Sequence>(m_state->executionPlan.sequenceRuntimeConfig);
+        }
+
+        // Persistent textures ping-pong: this run reads each front texture and renders into its back texture.
+        std::map<std::string, std::shared_ptr<Texture>> persistentReadTextures;
+        for (const auto& [persistentTextureName, buffers] : m_state->persistentTextures) {
+            if (!buffers.front) {
+                continue;
+            }
+            persistentReadTextures[persistentTextureName] =
+                is_run_output_texture(*m_state, buffers.front) ? clone_texture_resource(buffers.front) : buffers.front;
+        }
+        for (const RawGLGraphState::PersistentOutputBinding& persistentOutput :
+             m_state->executionPlan.persistentOutputs) {
+            auto buffersIt = m_state->persistentTextures.find(persistentOutput.persistentTextureName);
+            if (buffersIt != m_state->persistentTextures.end() && buffersIt->second.back) {
+                m_state->sequence->setNextRunOutputTexture(persistentOutput.passIndex,
+                                                           persistentOutput.outputName,
+                                                           std::move(buffersIt->second.back));
+            }
         }
         for (const RawGLGraphState::PersistentInputBinding& persistentInput : m_state->executionPlan.persistentInputs) {
             if (has_sequence_override(inputOverrides, persistentInput.passIndex, persistentInput.inputName)) {
                 continue;
             }
 
-            auto textureIt = persistentTextureSnapshot.find(persistentInput.persistentTextureName);
-            if (textureIt == persistentTextureSnapshot.end() || !textureIt->second) {
+            auto textureIt = persistentReadTextures.find(persistentInput.persistentTextureName);
+            if (textureIt == persistentReadTextures.end()) {
                 continue;
             }
 
@@ -292,10 +284,6 @@ RawGLGraph::execute(const GraphExecutionRequest& request)
             inputOverrides.push_back(std::move(inputOverride));
         }
 
-        if (!m_state->sequence) {
-            m_state->sequence = std::make_unique<Sequence>(m_state->executionPlan.sequenceRuntimeConfig);
-        }
-
         for (const RawGLGraphState::PersistentAtomicCounterBinding& persistentCounter :
              m_state->executionPlan.persistentAtomicCounters) {
             auto counterIt = m_state->persistentAtomicCounters.find(persistentCounter.persistentCounterName);
@@ -320,7 +308,12 @@ RawGLGraph::execute(const GraphExecutionRequest& request)
             if (!outputTexture) {
                 throw std::runtime_error("persistent output capture failed for " + persistentOutput.outputName);
             }
-            m_state->persistentTextures[persistentOutput.persistentTextureName] = outputTexture;
+            RawGLGraphState::PersistentTextureBuffers& buffers =
+                m_state->persistentTextures[persistentOutput.persistentTextureName];
+            if (buffers.front != outputTexture) {
+                buffers.back  = std::move(buffers.front);
+                buffers.front = std::move(outputTexture);
+            }
         }
         for (const RawGLGraphState::PersistentAtomicCounterBinding& persistentCounter :
              m_state->executionPlan.persistentAtomicCounters) {
@@ -431,7 +424,9 @@ Run(const CommandLineRequest& request)
             return result;
         }
 
-        Session session;
+        SessionOptions sessionOptions;
+        sessionOptions.glErrorPolicy = parsedArguments.glErrors;
+        Session session(sessionOptions);
         const CliWorkflow workflow = BuildCliWorkflowFromCommandLine(
             request,
             ShaderInterfaceInspector { &session, inspect_shader_interface_from_session });
@@ -462,7 +457,7 @@ InspectShaderInterface(const ShaderInspectionRequest& request)
 }
 
 RuntimeInfo
-ProbeRuntimeInfo()
+ProbeRuntimeInfo(const ContextOptions& options)
 {
     RuntimeInfo result;
 
@@ -488,7 +483,7 @@ ProbeRuntimeInfo()
 
     try {
         rawgl_fill_runtime_environment_info(result);
-        OpenGLHandle handle;
+        OpenGLHandle handle(options.glErrorPolicy);
         rawgl_fill_current_runtime_info(result);
         result.success = true;
     } catch (const std::exception& exception) {
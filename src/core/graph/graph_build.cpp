@@ -18,6 +18,9 @@ build_graph_state(const RawGLContextState& contextState, const GraphBuildRequest
     graphState.resourcePlan   = build_resource_plan(contextState, graphState.validatedGraph);
     graphState.executionPlan  = build_execution_plan(graphState.resourcePlan);
     graphState.executionPlan.sequenceRuntimeConfig.ioRuntime = contextState.ioRuntime;
+    if (contextState.options.outputTexturePoolBudgetBytes > 0u) {
+        graphState.executionPlan.sequenceRuntimeConfig.outputTexturePool = contextState.outputTexturePool;
+    }
 }
 
 std::vector<SequenceExecutionInputOverride>
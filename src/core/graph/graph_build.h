@@ -9,6 +9,7 @@
 #include "rawgl/rawgl_core.h"
 #include "sequence.h"
 
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -24,17 +25,38 @@ struct RawGLContextState {
         ShaderInterface shaderInterface;
     };
 
+    struct CachedTexture {
+        std::shared_ptr<Texture> texture;
+        uint64_t byteSize = 0;
+        std::list<std::string>::iterator lruIt;
+    };
+
+    explicit RawGLContextState(const ContextOptions& contextOptions)
+        : options(contextOptions)
+        , glHandle(contextOptions.glErrorPolicy)
+    {
+    }
+
+    ContextOptions options;
+
     OpenGLHandle glHandle;
     mutable std::mutex programManagerMutex;
     mutable GLProgramManager programManager;
     mutable std::shared_mutex shaderCacheMutex;
     mutable std::map<std::string, CachedShaderInterface> shaderCache;
     mutable std::shared_mutex textureCacheMutex;
-    mutable std::map<std::string, std::shared_ptr<Texture>> textureCache;
+    mutable std::map<std::string, CachedTexture> textureCache;
+    /// Texture cache keys ordered from most to least recently used.
+    mutable std::list<std::string> textureCacheLru;
+    mutable uint64_t textureCacheBytes     = 0;
+    mutable uint64_t textureCacheHits      = 0;
+    mutable uint64_t textureCacheMisses    = 0;
+    mutable uint64_t textureCacheEvictions = 0;
     mutable std::shared_mutex meshCacheMutex;
     mutable std::map<std::string, std::shared_ptr<SequenceSharedMeshData>> meshCache;
     mutable std::shared_mutex meshGpuCacheMutex;
     mutable std::map<std::string, std::shared_ptr<SequenceSharedGpuMesh>> meshGpuCache;
+    std::shared_ptr<TexturePool> outputTexturePool;
     std::shared_ptr<rawgl::io::IoRuntimeService> ioRuntime;
 };
 
@@ -98,6 +120,14 @@ struct RawGLGraphState {
         std::string persistentCounterName;
     };
 
+    /// Ping-pong pair for one persistent texture name.
+    struct PersistentTextureBuffers {
+        /// Written by the latest execution and read by the next one.
+        std::shared_ptr<Texture> front;
+        /// Written by the next execution; it held the frame before `front`.
+        std::shared_ptr<Texture> back;
+    };
+
     struct ExecutionPlan {
         SequenceRuntimeConfig sequenceRuntimeConfig;
         std::vector<ExecutionPass> passes;
@@ -109,7 +139,7 @@ struct RawGLGraphState {
     ValidatedGraph validatedGraph;
     ResourcePlan resourcePlan;
     ExecutionPlan executionPlan;
-    std::map<std::string, std::shared_ptr<Texture>> persistentTextures;
+    std::map<std::string, PersistentTextureBuffers> persistentTextures;
     std::map<std::string, std::vector<GLuint>> persistentAtomicCounters;
     std::unique_ptr<Sequence> sequence;
 };
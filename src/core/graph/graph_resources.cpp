@@ -186,7 +186,7 @@ validate_host_image_data(const HostImageData& hostImage, const std::string& cont
 
     const size_t expectedByteCount = static_cast<size_t>(hostImage.width) * static_cast<size_t>(hostImage.height)
                                      * static_cast<size_t>(hostImage.channels) * bytesPerComponent;
-    if (hostImage.bytes.size() != expectedByteCount) {
+    if (hostImage.pixelBytes().size() != expectedByteCount) {
         throw std::runtime_error(context + ": host texture byte size does not match width, height, channels, and type");
     }
 }
@@ -288,6 +288,60 @@ load_cached_gpu_mesh_resource(const RawGLContextState& contextState,
     return sharedGpuMesh;
 }
 
+static std::shared_ptr<Texture>
+load_cached_host_texture_resource(const RawGLContextState& contextState,
+                                  const HostImageData& hostImage,
+                                  const std::string& context)
+{
+    const uint64_t budgetBytes = contextState.options.textureCacheBudgetBytes;
+    if (hostImage.sourceKey.empty() || budgetBytes == 0u) {
+        return create_host_texture_resource(hostImage, context);
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> writeLock(contextState.textureCacheMutex);
+        auto cacheIt = contextState.textureCache.find(hostImage.sourceKey);
+        if (cacheIt != contextState.textureCache.end()) {
+            contextState.textureCacheLru.splice(contextState.textureCacheLru.begin(),
+                                                contextState.textureCacheLru,
+                                                cacheIt->second.lruIt);
+            ++contextState.textureCacheHits;
+            return cacheIt->second.texture;
+        }
+    }
+
+    std::shared_ptr<Texture> texture = create_host_texture_resource(hostImage, context);
+    const uint64_t byteSize          = static_cast<uint64_t>(hostImage.pixelBytes().size());
+
+    std::unique_lock<std::shared_mutex> writeLock(contextState.textureCacheMutex);
+    ++contextState.textureCacheMisses;
+    auto cacheIt = contextState.textureCache.find(hostImage.sourceKey);
+    if (cacheIt != contextState.textureCache.end()) {
+        return cacheIt->second.texture;
+    }
+    if (byteSize > budgetBytes) {
+        return texture;
+    }
+
+    contextState.textureCacheLru.push_front(hostImage.sourceKey);
+    RawGLContextState::CachedTexture& cachedTexture = contextState.textureCache[hostImage.sourceKey];
+    cachedTexture.texture  = texture;
+    cachedTexture.byteSize = byteSize;
+    cachedTexture.lruIt    = contextState.textureCacheLru.begin();
+    contextState.textureCacheBytes += byteSize;
+
+    while (contextState.textureCacheBytes > budgetBytes) {
+        const std::string evictedKey = contextState.textureCacheLru.back();
+        contextState.textureCacheLru.pop_back();
+        auto evictedIt = contextState.textureCache.find(evictedKey);
+        contextState.textureCacheBytes -= evictedIt->second.byteSize;
+        contextState.textureCache.erase(evictedIt);
+        ++contextState.textureCacheEvictions;
+    }
+
+    return texture;
+}
+
 }  // namespace
 
 std::shared_ptr<Texture>
@@ -295,11 +349,12 @@ create_host_texture_resource(const HostImageData& hostImage, const std::string&
 {
     validate_host_image_data(hostImage, context);
 
+    const std::span<const std::byte> pixels = hostImage.pixelBytes();
     return std::make_shared<Texture>(hostImage.width,
                                      hostImage.height,
                                      hostImage.glInternalFormat,
                                      hostImage.glType,
-                                     hostImage.bytes.empty() ? nullptr : hostImage.bytes.data(),
+                                     pixels.empty() ? nullptr : pixels.data(),
                                      hostImage.alphaChannel);
 }
 
@@ -395,6 +450,21 @@ build_resource_plan(const RawGLContextState& contextState, const RawGLGraphState
         resourcePass.outputs        = validatedPass.definition.outputs;
         resourcePass.meshes         = validatedPass.definition.meshes;
 
+        for (const GraphInputDefinition& inputDefinition : resourcePass.inputs) {
+            if (inputDefinition.sourceKind != GraphInputSourceKind::hostTexture || !inputDefinition.hostTexture
+                || inputDefinition.hostTexture->sourceKey.empty()) {
+                continue;
+            }
+
+            const std::string& sourceKey = inputDefinition.hostTexture->sourceKey;
+            if (resourcePlan.sharedTextures.find(sourceKey) != resourcePlan.sharedTextures.end()) {
+                continue;
+            }
+
+            resourcePlan.sharedTextures[sourceKey] = load_cached_host_texture_resource(
+                contextState, *inputDefinition.hostTexture, "in (" + inputDefinition.name + ")");
+        }
+
         for (const GraphMeshDefinition& meshDefinition : resourcePass.meshes) {
             if (meshDefinition.sourceKind != GraphMeshSourceKind::file
                 && meshDefinition.sourceKind != GraphMeshSourceKind::hostMesh) {
@@ -51,6 +51,18 @@ ensure_output_binding(SequenceRuntimePassConfig& passConfig,
     return output;
 }
 
+static GLenum
+capture_sample_gl_type(const GraphCaptureSampleType sampleType)
+{
+    switch (sampleType) {
+    case GraphCaptureSampleType::unorm8: return GL_UNSIGNED_BYTE;
+    case GraphCaptureSampleType::unorm16: return GL_UNSIGNED_SHORT;
+    case GraphCaptureSampleType::native: return 0;
+    }
+
+    return 0;
+}
+
 static void
 apply_output_definition(SequenceRuntimePassConfig& passConfig,
                         const ShaderInterface& shaderInterface,
@@ -64,6 +76,8 @@ apply_output_definition(SequenceRuntimePassConfig& passConfig,
     output.internalFormatText = definition.format;
     output.channels           = definition.channels;
     output.alphaChannel       = definition.alphaChannel;
+    output.captureToHost      = definition.captureToHost;
+    output.captureType        = capture_sample_gl_type(definition.captureSampleType);
 }
 
 static void
@@ -142,8 +156,13 @@ build_sequence_runtime_config(const RawGLGraphState::ResourcePlan& resourcePlan)
                     if (!inputDefinition.hostTexture) {
                         throw std::runtime_error("in (" + inputDefinition.name + "): host texture payload is missing");
                     }
-                    input.texture = create_host_texture_resource(*inputDefinition.hostTexture,
-                                                                 "in (" + inputDefinition.name + ")");
+                    const auto sharedTextureIt = inputDefinition.hostTexture->sourceKey.empty()
+                        ? resourcePlan.sharedTextures.end()
+                        : resourcePlan.sharedTextures.find(inputDefinition.hostTexture->sourceKey);
+                    input.texture = sharedTextureIt != resourcePlan.sharedTextures.end()
+                        ? sharedTextureIt->second
+                        : create_host_texture_resource(*inputDefinition.hostTexture,
+                                                       "in (" + inputDefinition.name + ")");
                 } else {
                     ensure_referenced_output(runtimeConfig,
                                              inputDefinition.referencedPassIndex,
@@ -214,6 +233,51 @@ build_sequence_runtime_config(const RawGLGraphState::ResourcePlan& resourcePlan)
     return runtimeConfig;
 }
 
+// Records the last pass that reads each transient output so the sequence can hand its texture to a later output.
+// Captured and persistent outputs, and outputs read by their own or an earlier pass, keep a private texture.
+static void
+plan_transient_output_lifetimes(RawGLGraphState::ExecutionPlan& executionPlan,
+                                const RawGLGraphState::ResourcePlan& resourcePlan)
+{
+    std::vector<SequenceRuntimePassConfig>& passConfigs = executionPlan.sequenceRuntimeConfig.passes;
+    for (size_t passIndex = 0; passIndex < passConfigs.size(); ++passIndex) {
+        for (auto& [outputName, output] : passConfigs[passIndex].outputs) {
+            (void)outputName;
+            output.lastUsePass = output.captureToHost ? -1 : static_cast<int>(passIndex);
+        }
+    }
+
+    for (const RawGLGraphState::PersistentOutputBinding& persistentOutput : executionPlan.persistentOutputs) {
+        auto outputIt = passConfigs[persistentOutput.passIndex].outputs.find(persistentOutput.outputName);
+        if (outputIt != passConfigs[persistentOutput.passIndex].outputs.end()) {
+            outputIt->second.lastUsePass = -1;
+        }
+    }
+
+    for (size_t passIndex = 0; passIndex < resourcePlan.passes.size(); ++passIndex) {
+        for (const GraphInputDefinition& inputDefinition : resourcePlan.passes[passIndex].inputs) {
+            if (inputDefinition.sourceKind != GraphInputSourceKind::passOutput) {
+                continue;
+            }
+
+            std::map<std::string, PassOutput>& referencedOutputs =
+                passConfigs[inputDefinition.referencedPassIndex].outputs;
+            auto outputIt = referencedOutputs.find(
+                build_addressed_resource_name(inputDefinition.referencedOutputName,
+                                              inputDefinition.usesReferencedOutputArrayElement,
+                                              inputDefinition.referencedOutputArrayElement));
+            if (outputIt == referencedOutputs.end() || outputIt->second.lastUsePass < 0) {
+                continue;
+            }
+
+            PassOutput& output = outputIt->second;
+            output.lastUsePass = inputDefinition.referencedPassIndex < passIndex
+                                     ? std::max(output.lastUsePass, static_cast<int>(passIndex))
+                                     : -1;
+        }
+    }
+}
+
 static void
 append_unique_dependency(std::vector<size_t>& dependencies, size_t passIndex)
 {
@@ -287,6 +351,7 @@ build_execution_plan(const RawGLGraphState::ResourcePlan& resourcePlan)
         executionPlan.passes.push_back(std::move(executionPass));
     }
 
+    plan_transient_output_lifetimes(executionPlan, resourcePlan);
     return executionPlan;
 }
 
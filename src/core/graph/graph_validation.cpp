@@ -140,7 +140,7 @@ validate_host_image_data(const HostImageData& hostImage, const std::string& cont
 
     const size_t expectedByteCount = static_cast<size_t>(hostImage.width) * static_cast<size_t>(hostImage.height)
                                      * static_cast<size_t>(hostImage.channels) * bytesPerComponent;
-    if (hostImage.bytes.size() != expectedByteCount) {
+    if (hostImage.pixelBytes().size() != expectedByteCount) {
         throw std::runtime_error(context + ": host texture byte size does not match width, height, channels, and type");
     }
 }
@@ -9,19 +9,30 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <termcolor/termcolor.hpp>
 #include <utility>
+#include <vector>
 
 #include <unordered_map>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+std::atomic<bool> rawgl_gl_check_every_call { true };
+
 namespace {
 thread_local std::string rawgl_opengl_error_message;
 std::string rawgl_opengl_platform_override;
+std::atomic<GLErrorPolicy> rawgl_active_gl_error_policy { GLErrorPolicy::everyCall };
+
+// Debug output may arrive on a driver thread, so collected errors are guarded and capped between drains.
+constexpr size_t rawgl_max_collected_gl_errors = 16;
+std::mutex rawgl_collected_gl_errors_mutex;
+std::vector<std::string> rawgl_collected_gl_errors;
+size_t rawgl_dropped_gl_errors = 0;
 
 enum class RawGLOpenGLPlatform {
     automatic,
@@ -160,6 +171,94 @@ rawgl_throw_opengl_error(std::string message)
     rawgl_opengl_error_message = std::move(message);
     throw std::runtime_error(rawgl_opengl_error_message);
 }
+
+GLErrorPolicy
+rawgl_resolve_gl_error_policy(const std::string& optionPolicy)
+{
+    std::string requested = rawgl_getenv_text("RAWGL_GL_ERRORS");
+    if (requested.empty()) {
+        requested = optionPolicy;
+    }
+    if (requested.empty()) {
+#if defined(NDEBUG)
+        return GLErrorPolicy::perPass;
+#else
+        return GLErrorPolicy::everyCall;
+#endif
+    }
+
+    const std::string normalized = rawgl_normalize_platform_text(requested);
+    if (normalized == "call" || normalized == "every_call") {
+        return GLErrorPolicy::everyCall;
+    }
+    if (normalized == "pass" || normalized == "per_pass") {
+        return GLErrorPolicy::perPass;
+    }
+    if (normalized == "off") {
+        return GLErrorPolicy::off;
+    }
+
+    rawgl_throw_opengl_error("Unsupported OpenGL error policy '" + requested + "'. Expected call, pass, or off.");
+}
+
+void GLAPIENTRY
+rawgl_gl_debug_callback(GLenum source,
+                        GLenum type,
+                        GLuint id,
+                        GLenum severity,
+                        GLsizei length,
+                        const GLchar* message,
+                        const void* userParam)
+{
+    (void)source;
+    (void)severity;
+    (void)userParam;
+    if (type != GL_DEBUG_TYPE_ERROR) {
+        return;
+    }
+
+    std::string text = "[OpenGL] (" + std::to_string(id) + "): ";
+    if (message != nullptr) {
+        text.append(message, length >= 0 ? static_cast<size_t>(length) : std::char_traits<char>::length(message));
+    }
+
+    if (rawgl_active_gl_error_policy.load(std::memory_order_relaxed) == GLErrorPolicy::off) {
+        LOG(error) << text;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(rawgl_collected_gl_errors_mutex);
+    if (rawgl_collected_gl_errors.size() < rawgl_max_collected_gl_errors) {
+        rawgl_collected_gl_errors.push_back(std::move(text));
+    } else {
+        ++rawgl_dropped_gl_errors;
+    }
+}
+
+void
+rawgl_apply_gl_error_policy(GLErrorPolicy policy)
+{
+    rawgl_active_gl_error_policy.store(policy, std::memory_order_relaxed);
+    rawgl_gl_check_every_call.store(policy == GLErrorPolicy::everyCall, std::memory_order_relaxed);
+    LOG(info) << "OpenGL error checks: " << rawgl_gl_error_policy_name(policy);
+    if (policy == GLErrorPolicy::everyCall) {
+        return;
+    }
+
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major < 4 || (major == 4 && minor < 3)) {
+        LOG(warning) << "OpenGL debug output needs OpenGL 4.3, errors are only detected with glGetError.";
+        return;
+    }
+
+    glEnable(GL_DEBUG_OUTPUT);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+    glDebugMessageCallback(rawgl_gl_debug_callback, nullptr);
+}
 }  // namespace
 
 void
@@ -168,6 +267,58 @@ rawgl_set_opengl_platform_override(const char* platform)
     rawgl_opengl_platform_override = platform != nullptr ? platform : "";
 }
 
+GLErrorPolicy
+rawgl_gl_error_policy()
+{
+    return rawgl_active_gl_error_policy.load(std::memory_order_relaxed);
+}
+
+const char*
+rawgl_gl_error_policy_name(GLErrorPolicy policy)
+{
+    switch (policy) {
+    case GLErrorPolicy::everyCall: return "call";
+    case GLErrorPolicy::perPass: return "pass";
+    case GLErrorPolicy::off: return "off";
+    }
+    return "call";
+}
+
+bool
+rawgl_take_gl_errors(std::string& message)
+{
+    std::vector<std::string> errors;
+    size_t droppedErrors = 0;
+    {
+        std::lock_guard<std::mutex> lock(rawgl_collected_gl_errors_mutex);
+        errors.swap(rawgl_collected_gl_errors);
+        std::swap(droppedErrors, rawgl_dropped_gl_errors);
+    }
+
+    // Debug output does not replace glGetError: errors stay queued there as well and must be drained either way.
+    while (GLenum error = glGetError()) {
+        if (errors.empty()) {
+            errors.push_back("[OpenGL] (" + std::to_string(error) + ")");
+        }
+    }
+
+    if (errors.empty()) {
+        return false;
+    }
+
+    message.clear();
+    for (const std::string& error : errors) {
+        if (!message.empty()) {
+            message += "; ";
+        }
+        message += error;
+    }
+    if (droppedErrors > 0) {
+        message += "; " + std::to_string(droppedErrors) + " more";
+    }
+    return true;
+}
+
 void
 rawgl_fill_runtime_environment_info(rawgl::RuntimeInfo& info)
 {
@@ -195,6 +346,7 @@ rawgl_fill_current_runtime_info(rawgl::RuntimeInfo& info)
     info.version = version != nullptr ? reinterpret_cast<const char*>(version) : "";
     info.shadingLanguageVersion =
         shadingLanguageVersion != nullptr ? reinterpret_cast<const char*>(shadingLanguageVersion) : "";
+    info.glErrorPolicy = rawgl_gl_error_policy_name(rawgl_gl_error_policy());
     info.softwareRenderer = rawgl_contains_case_insensitive(info.renderer, "llvmpipe")
                             || rawgl_contains_case_insensitive(info.renderer, "softpipe")
                             || rawgl_contains_case_insensitive(info.renderer, "software rasterizer")
@@ -231,11 +383,12 @@ GL_LogCall(const char* func, const char* file, int line)
     return true;
 }
 
-OpenGLHandle::OpenGLHandle()
+OpenGLHandle::OpenGLHandle(const std::string& requestedErrorPolicy)
 {
     rawgl_clear_opengl_error_message();
     rawgl::RuntimeInfo runtimeInfo;
     rawgl_fill_runtime_environment_info(runtimeInfo);
+    const GLErrorPolicy errorPolicy = rawgl_resolve_gl_error_policy(requestedErrorPolicy);
     glfwSetErrorCallback(rawgl_glfw_error_callback);
 
 #if defined(__linux__)
@@ -307,6 +460,8 @@ OpenGLHandle::OpenGLHandle()
         rawgl_throw_opengl_error("Failed to initialize GLAD");
     }
 #endif
+
+    rawgl_apply_gl_error_policy(errorPolicy);
 }
 
 OpenGLHandle::~OpenGLHandle()
@@ -14,7 +14,9 @@ gladLoadGLLoader(GLADloadproc)
 #else
 #    include <glad/glad.h>
 #endif
+#include <atomic>
 #include <cstdlib>
+#include <string>
 #include <unordered_map>
 
 namespace rawgl {
@@ -39,22 +41,43 @@ struct RuntimeInfo;
             RAWGL_DEBUGBREAK(); \
         }                       \
     } while (false)
-#define GLCall(x)                                     \
-    do {                                              \
-        GL_ClearError();                              \
-        x;                                            \
-        GLASSERT(GL_LogCall(#x, __FILE__, __LINE__)); \
+#define GLCall(x)                                                                           \
+    do {                                                                                    \
+        const bool rawglCheckCall = rawgl_gl_check_every_call.load(std::memory_order_relaxed); \
+        if (rawglCheckCall) {                                                               \
+            GL_ClearError();                                                                \
+        }                                                                                   \
+        x;                                                                                  \
+        if (rawglCheckCall) {                                                               \
+            GLASSERT(GL_LogCall(#x, __FILE__, __LINE__));                                   \
+        }                                                                                   \
     } while (false)
 
 struct GLFWwindow;
 
+/// How OpenGL errors are detected.
+///
+/// `everyCall` brackets each GLCall with glGetError and traps on failure. `perPass` and `off` skip those round
+/// trips and collect errors through GL_KHR_debug output instead; `perPass` also drains glGetError once after each
+/// pass and fails the run on an error, while `off` only logs what the driver reports.
+enum class GLErrorPolicy {
+    everyCall,
+    perPass,
+    off,
+};
+
+/// True while the active policy is GLErrorPolicy::everyCall.
+extern std::atomic<bool> rawgl_gl_check_every_call;
+
 void
 GL_ClearError();
 bool
 GL_LogCall(const char* func, const char* file, int line);
 
 struct OpenGLHandle {
-    OpenGLHandle();
+    /// Creates a hidden window and context; `errorPolicy` is `call`, `pass`, `off`, or empty for the build
+    /// default, and `RAWGL_GL_ERRORS` overrides it.
+    explicit OpenGLHandle(const std::string& errorPolicy = {});
     ~OpenGLHandle();
 
     void makeCurrent() const;
@@ -81,6 +104,15 @@ get_GPUfeatures();
 void
 rawgl_set_opengl_platform_override(const char* platform);
 
+GLErrorPolicy
+rawgl_gl_error_policy();
+
+const char*
+rawgl_gl_error_policy_name(GLErrorPolicy policy);
+
+bool
+rawgl_take_gl_errors(std::string& message);
+
 void
 rawgl_fill_runtime_environment_info(rawgl::RuntimeInfo& info);
 
@@ -4,6 +4,13 @@
 
 #include "texture.h"
 
+#include "program.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
 Texture::Texture(GLsizei width, GLsizei height, GLenum internalFormat, GLenum type, const GLvoid* data,
                  int alphaChannel)
     : Texture()
@@ -171,28 +178,33 @@ Texture::~Texture()
         GLCall(glDeleteTextures(1, &m_id));
 }
 
-void*
-Texture::getData(GLenum type) const
+static int
+readback_component_size(GLenum type)
 {
-    int bytes;
-
     switch (type) {
-    case GL_UNSIGNED_BYTE: bytes = 1; break;
+    case GL_UNSIGNED_BYTE: return 1;
     case GL_UNSIGNED_SHORT:
-    case GL_HALF_FLOAT: bytes = 2; break;
+    case GL_HALF_FLOAT: return 2;
     case GL_INT:
     case GL_UNSIGNED_INT:
-    case GL_FLOAT: bytes = 4; break;
-    default:
-        assert(0);
-        exit(1);
-        return nullptr;
+    case GL_FLOAT: return 4;
+    default: return 0;
     }
+}
+
+std::size_t
+Texture::getDataSize(GLenum type) const
+{
+    // size_t math, othwise we have int overflow for large textures.
+    return (std::size_t)m_width * (std::size_t)m_height * (std::size_t)m_channels
+           * (std::size_t)readback_component_size(type);
+}
 
-    // malloc requred size_t (unsinged int) so we need to cast to that.
-    // othwise we have int overflow for large textures.
-    std::size_t mem_size = (std::size_t)m_width * (std::size_t)m_height * (std::size_t)(m_channels * bytes);
-    void* data           = malloc(mem_size);
+void
+Texture::getData(GLenum type, void* data) const
+{
+    const int bytes = readback_component_size(type);
+    assert(bytes != 0);
 
     //glGenerateTextureMipmap(m_id); // NOTE: OpenGL 4.5+
 
@@ -208,6 +220,390 @@ Texture::getData(GLenum type) const
     //glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glBindTexture(GL_TEXTURE_2D, m_id);
     glGetTexImage(GL_TEXTURE_2D, 0, m_baseFormat, type, data);
+}
+
+void
+Texture::clear() const
+{
+    // A null pointer clears to zero; GL_UNSIGNED_BYTE is accepted with both integer and normalized base formats.
+    GLCall(glClearTexImage(m_id, 0, m_baseFormat, GL_UNSIGNED_BYTE, nullptr));
+}
+
+GLenum
+texture_readback_type(GLenum internalFormat)
+{
+    switch (internalFormat) {
+    case GL_R8:
+    case GL_RG8:
+    case GL_RGB8:
+    case GL_RGBA8: return GL_UNSIGNED_BYTE;
+    case GL_R16:
+    case GL_RG16:
+    case GL_RGB16:
+    case GL_RGBA16: return GL_UNSIGNED_SHORT;
+    case GL_R32UI:
+    case GL_RG32UI:
+    case GL_RGB32UI:
+    case GL_RGBA32UI: return GL_UNSIGNED_INT;
+    case GL_R16F:
+    case GL_RG16F:
+    case GL_RGB16F:
+    case GL_RGBA16F: return GL_HALF_FLOAT;
+    case GL_R32F:
+    case GL_RG32F:
+    case GL_RGB32F:
+    case GL_RGBA32F: return GL_FLOAT;
+    default: return GL_FLOAT;
+    }
+}
+
+TexturePool::TexturePool(uint64_t budgetBytes)
+    : m_budgetBytes(budgetBytes)
+{
+}
+
+std::shared_ptr<Texture>
+TexturePool::acquire(GLsizei width, GLsizei height, GLenum internalFormat, GLenum uploadType, int alphaChannel)
+{
+    std::shared_ptr<Texture> texture;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entryIt = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& entry) {
+            return entry.texture->getWidth() == width && entry.texture->getHeight() == height
+                   && entry.texture->getInternalFormat() == internalFormat
+                   && entry.texture->getAlphaChannel() == alphaChannel;
+        });
+        if (entryIt != m_entries.end()) {
+            texture = std::move(entryIt->texture);
+            m_stats.bytes -= entryIt->byteSize;
+            m_entries.erase(entryIt);
+            ++m_stats.hits;
+        } else {
+            ++m_stats.misses;
+        }
+    }
+
+    if (texture) {
+        // Passes that write only part of an output must not see what the previous owner left behind.
+        texture->clear();
+        return texture;
+    }
+    return std::make_shared<Texture>(width, height, internalFormat, uploadType, nullptr, alphaChannel);
+}
+
+void
+TexturePool::release(std::shared_ptr<Texture> texture)
+{
+    if (!texture || texture.use_count() != 1) {
+        return;
+    }
+
+    const uint64_t byteSize = texture->getDataSize(texture_readback_type(texture->getInternalFormat()));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (byteSize > m_budgetBytes) {
+        return;
+    }
+
+    m_entries.push_front(Entry { std::move(texture), byteSize });
+    m_stats.bytes += byteSize;
+    while (m_stats.bytes > m_budgetBytes) {
+        m_stats.bytes -= m_entries.back().byteSize;
+        m_entries.pop_back();
+        ++m_stats.evictions;
+    }
+}
+
+TexturePool::Stats
+TexturePool::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats result    = m_stats;
+    result.textures = m_entries.size();
+    return result;
+}
+
+GLenum
+texture_unorm_internal_format(int channels, GLenum type)
+{
+    if (type == GL_UNSIGNED_BYTE) {
+        switch (channels) {
+        case 1: return GL_R8;
+        case 2: return GL_RG8;
+        case 3: return GL_RGB8;
+        case 4: return GL_RGBA8;
+        default: return 0;
+        }
+    }
+    if (type == GL_UNSIGNED_SHORT) {
+        switch (channels) {
+        case 1: return GL_R16;
+        case 2: return GL_RG16;
+        case 3: return GL_RGB16;
+        case 4: return GL_RGBA16;
+        default: return 0;
+        }
+    }
+    return 0;
+}
+
+namespace {
+static const char* kTexturePackShader = R"(#version 430 core
+layout(local_size_x = 256) in;
+layout(std430, binding = 0) writeonly buffer PackedSamples {
+    uint words[];
+};
+uniform sampler2D u_source;
+uniform int u_width;
+uniform int u_channels;
+uniform uint u_sampleBits;
+uniform uint u_sampleCount;
+uniform uint u_firstWord;
+uniform uint u_wordCount;
+
+uint quantize(uint sampleIndex)
+{
+    uint pixel = sampleIndex / uint(u_channels);
+    ivec2 texel = ivec2(int(pixel % uint(u_width)), int(pixel / uint(u_width)));
+    float value = texelFetch(u_source, texel, 0)[int(sampleIndex % uint(u_channels))];
+    if (isnan(value) || isinf(value)) {
+        value = 0.0;
+    }
+    precise float scaled = clamp(value, 0.0, 1.0) * float((1u << u_sampleBits) - 1u) + 0.5;
+    return uint(scaled);
+}
+
+void main()
+{
+    uint localWord =
+        (gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x) * gl_WorkGroupSize.x + gl_LocalInvocationID.x;
+    if (localWord >= u_wordCount) {
+        return;
+    }
+
+    uint samplesPerWord = 32u / u_sampleBits;
+    uint firstSample = (u_firstWord + localWord) * samplesPerWord;
+    uint packed = 0u;
+    for (uint i = 0u; i < samplesPerWord && firstSample + i < u_sampleCount; ++i) {
+        packed |= quantize(firstSample + i) << (i * u_sampleBits);
+    }
+    words[localWord] = packed;
+}
+)";
+
+static constexpr GLuint kTexturePackGroupSize = 256;
+static constexpr GLuint kMaxDispatchGroups   = 65535;
+}  // namespace
+
+TexturePackProgram::TexturePackProgram()
+{
+    std::vector<std::shared_ptr<GLShader>> shaders;
+    shaders.push_back(std::make_shared<GLShader>(GL_COMPUTE_SHADER, std::string(kTexturePackShader)));
+    m_program = std::make_unique<GLProgram>(shaders);
+    if (!m_program->isValid()) {
+        return;
+    }
+
+    const GLuint programId = m_program->getId();
+    m_sourceLocation       = glGetUniformLocation(programId, "u_source");
+    m_widthLocation        = glGetUniformLocation(programId, "u_width");
+    m_channelsLocation     = glGetUniformLocation(programId, "u_channels");
+    m_sampleBitsLocation   = glGetUniformLocation(programId, "u_sampleBits");
+    m_sampleCountLocation  = glGetUniformLocation(programId, "u_sampleCount");
+    m_firstWordLocation    = glGetUniformLocation(programId, "u_firstWord");
+    m_wordCountLocation    = glGetUniformLocation(programId, "u_wordCount");
+
+    // Large images are packed in several dispatches, each bound to a window of the buffer that fits one block.
+    GLint maxBlockSize    = 0;
+    GLint offsetAlignment = 4;
+    glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &maxBlockSize);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    const std::size_t alignment  = static_cast<std::size_t>(std::max(offsetAlignment, 4));
+    const std::size_t chunkBytes = static_cast<std::size_t>(std::max(maxBlockSize, 0)) / alignment * alignment;
+    m_chunkWords = std::min<std::size_t>(chunkBytes / 4,
+                                         std::size_t(kMaxDispatchGroups) * kMaxDispatchGroups * kTexturePackGroupSize);
+}
+
+TexturePackProgram::~TexturePackProgram() = default;
+
+bool
+TexturePackProgram::isValid() const
+{
+    return m_program && m_program->isValid() && m_chunkWords > 0;
+}
+
+bool
+TexturePackProgram::supports(const Texture& texture, GLenum type)
+{
+    if (type != GL_UNSIGNED_BYTE && type != GL_UNSIGNED_SHORT) {
+        return false;
+    }
+
+    const GLenum nativeType = texture_readback_type(texture.getInternalFormat());
+    if (nativeType != GL_FLOAT && nativeType != GL_HALF_FLOAT) {
+        return false;
+    }
+
+    switch (texture.getBaseFormat()) {
+    case GL_RED:
+    case GL_RG:
+    case GL_RGB:
+    case GL_RGBA: break;
+    default: return false;
+    }
+
+    const std::size_t sampleCount = texture.getDataSize(GL_UNSIGNED_BYTE);
+    return sampleCount > 0 && sampleCount <= std::numeric_limits<GLuint>::max();
+}
+
+bool
+TexturePackProgram::dispatch(const Texture& texture, GLenum type, GLuint buffer) const
+{
+    if (!isValid() || !supports(texture, type)) {
+        return false;
+    }
+
+    const GLuint sampleBits       = type == GL_UNSIGNED_BYTE ? 8u : 16u;
+    const std::size_t sampleCount = texture.getDataSize(GL_UNSIGNED_BYTE);
+    const std::size_t wordCount   = (texture.getDataSize(type) + 3) / 4;
+
+    GLCall(glUseProgram(m_program->getId()));
+    GLCall(glActiveTexture(GL_TEXTURE0));
+    GLCall(glBindTexture(GL_TEXTURE_2D, texture.getId()));
 
-    return data;
+    // texelFetch applies the alpha swizzle set at creation; packing must see the stored channels like getData does.
+    std::array<GLint, 4> swizzleMask = { GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA };
+    const std::array<GLint, 4> identityMask = swizzleMask;
+    GLCall(glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzleMask.data()));
+    GLCall(glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, identityMask.data()));
+
+    GLCall(glUniform1i(m_sourceLocation, 0));
+    GLCall(glUniform1i(m_widthLocation, texture.getWidth()));
+    GLCall(glUniform1i(m_channelsLocation, texture.getChannels()));
+    GLCall(glUniform1ui(m_sampleBitsLocation, sampleBits));
+    GLCall(glUniform1ui(m_sampleCountLocation, static_cast<GLuint>(sampleCount)));
+
+    for (std::size_t firstWord = 0; firstWord < wordCount; firstWord += m_chunkWords) {
+        const std::size_t chunkWords = std::min(m_chunkWords, wordCount - firstWord);
+        GLCall(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, buffer, static_cast<GLintptr>(firstWord * 4),
+                                 static_cast<GLsizeiptr>(chunkWords * 4)));
+        GLCall(glUniform1ui(m_firstWordLocation, static_cast<GLuint>(firstWord)));
+        GLCall(glUniform1ui(m_wordCountLocation, static_cast<GLuint>(chunkWords)));
+
+        const std::size_t groups = (chunkWords + kTexturePackGroupSize - 1) / kTexturePackGroupSize;
+        const GLuint groupsX     = static_cast<GLuint>(std::min<std::size_t>(groups, kMaxDispatchGroups));
+        const GLuint groupsY     = static_cast<GLuint>((groups + groupsX - 1) / groupsX);
+        GLCall(glDispatchCompute(groupsX, groupsY, 1));
+    }
+
+    GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0));
+    GLCall(glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzleMask.data()));
+    GLCall(glUseProgram(0));
+    GLCall(glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT));
+    return true;
+}
+
+TextureReadback::~TextureReadback()
+{
+    cancel();
+    if (m_buffer)
+        GLCall(glDeleteBuffers(1, &m_buffer));
+}
+
+bool
+TextureReadback::begin(const Texture& texture, GLenum type)
+{
+    cancel();
+
+    const std::size_t byteSize = texture.getDataSize(type);
+    if (byteSize == 0) {
+        return false;
+    }
+
+    reserve(byteSize);
+
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer));
+    // With a pack buffer bound the destination pointer is an offset, so the copy stays on the GPU.
+    texture.getData(type, nullptr);
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    m_fence    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_byteSize = byteSize;
+    m_type     = type;
+    return m_fence != nullptr;
+}
+
+bool
+TextureReadback::beginPacked(const Texture& texture, GLenum type, const TexturePackProgram& program)
+{
+    cancel();
+
+    const std::size_t byteSize = texture.getDataSize(type);
+    if (byteSize == 0 || !TexturePackProgram::supports(texture, type)) {
+        return false;
+    }
+
+    // The shader writes whole 32-bit words, so the tail word may extend past the tightly packed size.
+    reserve((byteSize + 3) / 4 * 4);
+    if (!program.dispatch(texture, type, m_buffer)) {
+        return false;
+    }
+
+    m_fence    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_byteSize = byteSize;
+    m_type     = type;
+    return m_fence != nullptr;
+}
+
+bool
+TextureReadback::finish(void* destination)
+{
+    if (!m_fence) {
+        return false;
+    }
+
+    GLenum waitResult = GL_TIMEOUT_EXPIRED;
+    GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (waitResult == GL_TIMEOUT_EXPIRED) {
+        waitResult = glClientWaitSync(m_fence, waitFlags, 1000000000ull);
+        waitFlags  = 0;
+    }
+    glDeleteSync(m_fence);
+    m_fence = nullptr;
+    if (waitResult == GL_WAIT_FAILED) {
+        return false;
+    }
+
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer));
+    const void* mapped =
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(m_byteSize), GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(destination, mapped, m_byteSize);
+        GLCall(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    return mapped != nullptr;
+}
+
+void
+TextureReadback::reserve(std::size_t byteSize)
+{
+    if (!m_buffer) {
+        GLCall(glGenBuffers(1, &m_buffer));
+    }
+
+    if (m_capacity < byteSize) {
+        GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer));
+        GLCall(glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteSize), nullptr, GL_STREAM_READ));
+        GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        m_capacity = byteSize;
+    }
+}
+
+void
+TextureReadback::cancel()
+{
+    if (m_fence) {
+        glDeleteSync(m_fence);
+        m_fence = nullptr;
+    }
 }
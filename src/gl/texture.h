@@ -6,6 +6,22 @@
 #include "common.h"
 #include "gl_utils.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+
+class GLProgram;
+
+/// Host element type used to read back a texture with the given internal format.
+GLenum
+texture_readback_type(GLenum internalFormat);
+
+/// Unsigned-normalized internal format with `channels` components of `type`, or 0 when there is none.
+GLenum
+texture_unorm_internal_format(int channels, GLenum type);
+
 class Texture {
 public:
     Texture()
@@ -22,7 +38,14 @@ public:
     int getChannels() const { return m_channels; }
     int getAlphaChannel() const { return m_alphaChannel; }
     GLenum getInternalFormat() const { return m_internalFormat; }
-    void* getData(GLenum type) const;
+    GLenum getBaseFormat() const { return m_baseFormat; }
+    /// Returns the tightly packed byte size of level 0 read back as `type`, or 0 for unsupported types.
+    std::size_t getDataSize(GLenum type) const;
+    /// Reads level 0 into `data`, which must hold \ref getDataSize bytes.
+    /// With a `GL_PIXEL_PACK_BUFFER` bound, `data` is a byte offset into that buffer.
+    void getData(GLenum type, void* data) const;
+    /// Fills level 0 with zeros.
+    void clear() const;
 
 private:
     GLuint m_id = 0;
@@ -36,3 +59,107 @@ private:
 
     GLenum m_internalFormat = 0;
 };
+
+/// Byte-capped pool of released render-target textures, keyed by size, internal format and alpha channel.
+///
+/// Released textures are reused by later \ref acquire calls with the same key. The least recently released
+/// textures are dropped first when the pool exceeds its budget. All methods are thread-safe; the caller must have
+/// the owning OpenGL context current.
+class TexturePool {
+public:
+    struct Stats {
+        std::size_t textures = 0;
+        uint64_t bytes       = 0;
+        uint64_t hits        = 0;
+        uint64_t misses      = 0;
+        uint64_t evictions   = 0;
+    };
+
+    explicit TexturePool(uint64_t budgetBytes);
+
+    TexturePool(const TexturePool&) = delete;
+    TexturePool& operator=(const TexturePool&) = delete;
+
+    /// Returns a zero-filled texture, reusing a pooled one when its key matches.
+    std::shared_ptr<Texture> acquire(GLsizei width, GLsizei height, GLenum internalFormat, GLenum uploadType,
+                                     int alphaChannel);
+    /// Takes `texture` back into the pool, or drops it when other owners still reference it.
+    void release(std::shared_ptr<Texture> texture);
+    Stats stats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<Texture> texture;
+        uint64_t byteSize = 0;
+    };
+
+    mutable std::mutex m_mutex;
+    /// Pooled textures ordered from most to least recently released.
+    std::list<Entry> m_entries;
+    uint64_t m_budgetBytes = 0;
+    Stats m_stats;
+};
+
+/// Built-in compute program that packs a float texture into unsigned-normalized samples on the GPU.
+///
+/// Samples keep the channel and row order of \ref Texture::getData. Each sample is cleared to 0 when not finite,
+/// clamped to [0, 1] and rounded as `uint(v * max + 0.5)`, the same quantization the CPU file encoders apply.
+class TexturePackProgram {
+public:
+    TexturePackProgram();
+    ~TexturePackProgram();
+
+    TexturePackProgram(const TexturePackProgram&) = delete;
+    TexturePackProgram& operator=(const TexturePackProgram&) = delete;
+
+    bool isValid() const;
+    /// True when `texture` samples as float and `type` is `GL_UNSIGNED_BYTE` or `GL_UNSIGNED_SHORT`.
+    static bool supports(const Texture& texture, GLenum type);
+    /// Writes level 0 of `texture` packed as `type` to the start of `buffer`, which must hold
+    /// \ref Texture::getDataSize bytes rounded up to a multiple of 4.
+    bool dispatch(const Texture& texture, GLenum type, GLuint buffer) const;
+
+private:
+    std::unique_ptr<GLProgram> m_program;
+    GLint m_sourceLocation      = -1;
+    GLint m_widthLocation       = -1;
+    GLint m_channelsLocation    = -1;
+    GLint m_sampleBitsLocation  = -1;
+    GLint m_sampleCountLocation = -1;
+    GLint m_firstWordLocation   = -1;
+    GLint m_wordCountLocation   = -1;
+    std::size_t m_chunkWords    = 0;
+};
+
+/// Asynchronous pixel-pack-buffer readback for one texture.
+///
+/// `begin` queues the transfer and a fence without waiting on the GPU. `finish`
+/// waits on the fence and copies the mapped buffer straight into caller memory.
+/// The pack buffer is kept and reused while later transfers fit in it.
+class TextureReadback {
+public:
+    TextureReadback() = default;
+    ~TextureReadback();
+
+    TextureReadback(const TextureReadback&) = delete;
+    TextureReadback& operator=(const TextureReadback&) = delete;
+
+    bool begin(const Texture& texture, GLenum type);
+    /// Like \ref begin, but packs `texture` into `type` samples with `program` instead of a pixel transfer.
+    bool beginPacked(const Texture& texture, GLenum type, const TexturePackProgram& program);
+    bool finish(void* destination);
+    void cancel();
+
+    bool isPending() const { return m_fence != nullptr; }
+    GLenum getType() const { return m_type; }
+    std::size_t getByteSize() const { return m_byteSize; }
+
+private:
+    void reserve(std::size_t byteSize);
+
+    GLuint m_buffer         = 0;
+    std::size_t m_capacity  = 0;
+    std::size_t m_byteSize  = 0;
+    GLenum m_type           = 0;
+    GLsync m_fence          = nullptr;
+};
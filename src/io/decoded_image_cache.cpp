@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#include "decoded_image_cache.h"
+
+namespace rawgl::io {
+
+DecodedImageCache::DecodedImageCache(const uint64_t budgetBytes)
+    : m_budgetBytes(budgetBytes)
+{
+}
+
+std::shared_ptr<const DecodedImageData>
+DecodedImageCache::find(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto entryIt = m_entries.find(key);
+    if (entryIt == m_entries.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, entryIt->second.lruIt);
+    ++m_hits;
+    return entryIt->second.image;
+}
+
+void
+DecodedImageCache::insert(const std::string& key, std::shared_ptr<const DecodedImageData> image)
+{
+    if (!image) {
+        return;
+    }
+
+    const uint64_t byteSize = static_cast<uint64_t>(image->bytes.size());
+    if (byteSize > m_budgetBytes) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.find(key) != m_entries.end()) {
+        return;
+    }
+
+    m_lru.push_front(key);
+    Entry& entry = m_entries[key];
+    entry.image = std::move(image);
+    entry.byteSize = byteSize;
+    entry.lruIt = m_lru.begin();
+    m_bytes += byteSize;
+
+    while (m_bytes > m_budgetBytes) {
+        auto evictedIt = m_entries.find(m_lru.back());
+        m_lru.pop_back();
+        m_bytes -= evictedIt->second.byteSize;
+        m_entries.erase(evictedIt);
+        ++m_evictions;
+    }
+}
+
+IoCacheStats
+DecodedImageCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    IoCacheStats result;
+    result.entries = m_entries.size();
+    result.bytes = m_bytes;
+    result.hits = m_hits;
+    result.misses = m_misses;
+    result.evictions = m_evictions;
+    return result;
+}
+
+}  // namespace rawgl::io
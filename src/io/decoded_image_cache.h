@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#pragma once
+
+#include "rawgl/rawgl_io.h"
+#include "image_backend.h"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace rawgl::io {
+
+/// Thread-safe, byte-capped LRU cache of decoded images keyed by \ref make_image_source_key.
+///
+/// Cached images are immutable and shared; callers copy pixels out when they
+/// need an owned buffer.
+class DecodedImageCache {
+public:
+    explicit DecodedImageCache(uint64_t budgetBytes);
+
+    DecodedImageCache(const DecodedImageCache&) = delete;
+    DecodedImageCache& operator=(const DecodedImageCache&) = delete;
+
+    /// Returns the cached image for `key` and marks it most recently used, or null on a miss.
+    std::shared_ptr<const DecodedImageData> find(const std::string& key);
+
+    /// Caches `image` under `key`, evicting least recently used entries to stay within the budget.
+    void insert(const std::string& key, std::shared_ptr<const DecodedImageData> image);
+
+    IoCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<const DecodedImageData> image;
+        uint64_t byteSize = 0;
+        std::list<std::string>::iterator lruIt;
+    };
+
+    mutable std::mutex m_mutex;
+    uint64_t m_budgetBytes = 0;
+    std::map<std::string, Entry> m_entries;
+    std::list<std::string> m_lru;
+    uint64_t m_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+};
+
+}  // namespace rawgl::io
@@ -4,6 +4,7 @@
 #include "exr_backend.h"
 
 #include "gl_utils.h"
+#include "mapped_file.h"
 
 #include <algorithm>
 #include <array>
@@ -15,6 +16,9 @@
 #include <cstring>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,12 +27,15 @@
 #include <OpenEXR/ImfChannelList.h>
 #include <OpenEXR/ImfCompression.h>
 #include <OpenEXR/ImfFrameBuffer.h>
+#include <OpenEXR/Iex.h>
 #include <OpenEXR/ImfHeader.h>
+#include <OpenEXR/ImfIO.h>
 #include <OpenEXR/ImfInputFile.h>
 #include <OpenEXR/ImfOutputFile.h>
 #include <OpenEXR/ImfStringAttribute.h>
 #include <OpenEXR/ImfTileDescription.h>
 #include <OpenEXR/ImfTiledInputFile.h>
+#include <OpenEXR/ImfThreading.h>
 #include <OpenEXR/ImfTiledOutputFile.h>
 #endif
 
@@ -37,6 +44,7 @@ namespace {
 
 #if defined(RAWGL_HAS_OPENEXR)
 static constexpr const char* kExrStringAttributePrefix = "openexr:attribute:string:";
+static constexpr uint32_t kMaxExrThreadCount = 4096u;
 
 static char
 to_lower_ascii(const unsigned char c)
@@ -91,6 +99,7 @@ struct ExrSaveOptions {
     OPENEXR_IMF_NAMESPACE::LineOrder lineOrder = OPENEXR_IMF_NAMESPACE::INCREASING_Y;
     bool hasDwaLevel = false;
     float dwaLevel = 45.0f;
+    int threadCount = 0;
 };
 
 enum class ExrChannelSelection
@@ -330,6 +339,39 @@ parse_u32_attribute(const std::map<std::string, std::string>& attributes,
     return true;
 }
 
+static bool
+parse_exr_thread_count(const std::map<std::string, std::string>& attributes,
+                       std::initializer_list<const char*> keys,
+                       int& threadCount,
+                       std::string& errorMessage)
+{
+    bool present = false;
+    uint32_t value = 0u;
+    if (!parse_u32_attribute(attributes, keys, present, value, "invalid OpenEXR thread count", errorMessage)) {
+        return false;
+    }
+
+    // One thread keeps the whole read or write on the calling thread.
+    threadCount = present && value > 1u ? static_cast<int>(std::min(value, kMaxExrThreadCount)) : 0;
+    return true;
+}
+
+static void
+reserve_exr_global_threads(const int threadCount)
+{
+    record_codec_thread_count(ImageCodecFamily::Exr, static_cast<uint32_t>(std::max(threadCount, 1)));
+    if (threadCount <= 0) {
+        return;
+    }
+
+    // The OpenEXR pool is process-wide, so it only grows to the largest count any request asked for.
+    static std::mutex poolMutex;
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (OPENEXR_IMF_NAMESPACE::globalThreadCount() < threadCount) {
+        OPENEXR_IMF_NAMESPACE::setGlobalThreadCount(threadCount);
+    }
+}
+
 static bool
 parse_exr_storage_layout(const std::map<std::string, std::string>& attributes,
                          ExrSaveOptions& options,
@@ -464,6 +506,9 @@ parse_exr_save_options(const std::map<std::string, std::string>& attributes,
     if (!parse_exr_dwa_level(attributes, options, errorMessage)) {
         return false;
     }
+    if (!parse_exr_thread_count(attributes, { "openexr:threads", "rawgl:encode_threads" }, options.threadCount, errorMessage)) {
+        return false;
+    }
 
     return true;
 }
@@ -634,16 +679,66 @@ resolve_exr_component_type(const OPENEXR_IMF_NAMESPACE::ChannelList& channelList
     return false;
 }
 
+// Memory-mapped OpenEXR input. Reports itself as memory mapped so the readers take
+// chunk data straight from the source bytes instead of copying through read().
+class ExrMemoryInputStream final : public OPENEXR_IMF_NAMESPACE::IStream {
+public:
+    explicit ExrMemoryInputStream(const std::span<const std::byte> bytes)
+        : OPENEXR_IMF_NAMESPACE::IStream("rawgl-memory.exr")
+        , m_cursor { bytes }
+    {
+    }
+
+    bool isMemoryMapped() const override { return true; }
+
+    bool read(char c[], int n) override
+    {
+        if (n < 0 || m_cursor.read(c, static_cast<size_t>(n)) != static_cast<size_t>(n)) {
+            throw IEX_NAMESPACE::InputExc("Unexpected end of OpenEXR data.");
+        }
+        return m_cursor.remaining() > 0u;
+    }
+
+    char* readMemoryMapped(int n) override
+    {
+        if (n < 0 || m_cursor.remaining() < static_cast<size_t>(n)) {
+            throw IEX_NAMESPACE::InputExc("Unexpected end of OpenEXR data.");
+        }
+        char* data = reinterpret_cast<char*>(const_cast<std::byte*>(m_cursor.current()));
+        m_cursor.position += static_cast<uint64_t>(n);
+        return data;
+    }
+
+    uint64_t tellg() override { return m_cursor.position; }
+
+    void seekg(uint64_t pos) override
+    {
+        if (!m_cursor.seek(pos)) {
+            throw IEX_NAMESPACE::InputExc("Seek past the end of OpenEXR data.");
+        }
+    }
+
+private:
+    MemoryInputCursor m_cursor;
+};
+
+static int
+select_exr_decode_level(const OPENEXR_IMF_NAMESPACE::TiledInputFile& file, const uint32_t scaleLog2)
+{
+    // Mip levels share x/y indices; rip maps are read along the diagonal to keep the aspect ratio.
+    const int levelCount = std::min(file.numXLevels(), file.numYLevels());
+    return static_cast<int>(std::min<uint32_t>(scaleLog2, static_cast<uint32_t>(levelCount - 1)));
+}
+
 static bool
 prepare_exr_decode_target(const OPENEXR_IMF_NAMESPACE::Header& header,
                           const std::map<std::string, std::string>& attributes,
-                          IMATH_NAMESPACE::Box2i& dataWindow,
+                          const IMATH_NAMESPACE::Box2i& dataWindow,
                           std::vector<std::string>& selectedNames,
                           OPENEXR_IMF_NAMESPACE::PixelType& pixelType,
                           DecodedImageData& result,
                           std::string& errorMessage)
 {
-    dataWindow = header.dataWindow();
     const int width = dataWindow.max.x - dataWindow.min.x + 1;
     const int height = dataWindow.max.y - dataWindow.min.y + 1;
     if (width <= 0 || height <= 0) {
@@ -739,22 +834,22 @@ read_source_sample_as_float(const HostImageData& image, const size_t sampleIndex
 
     switch (image.glType) {
     case GL_UNSIGNED_BYTE: {
-        const uint8_t value = reinterpret_cast<const uint8_t*>(image.bytes.data())[sampleIndex];
+        const uint8_t value = reinterpret_cast<const uint8_t*>(image.pixelBytes().data())[sampleIndex];
         return static_cast<float>(value) / 255.0f;
     }
     case GL_UNSIGNED_SHORT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return static_cast<float>(value) / 65535.0f;
     }
     case GL_HALF_FLOAT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return half_to_float(value);
     }
     case GL_FLOAT: {
         float value = 0.0f;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(float), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(float), sizeof(value));
         return value;
     }
     default: break;
@@ -883,25 +978,250 @@ convert_host_image_to_exr_bytes(const HostImageData& image,
     errorMessage = "native OpenEXR write currently supports only half and float output";
     return false;
 }
+
+class ExrStreamEncoder final : public ImageStreamEncoder {
+public:
+    ExrStreamEncoder(const HostImageData& layout,
+                     const ImageEncodeSettings& settings,
+                     const int alphaChannel,
+                     const ExrSaveOptions& options)
+        : m_layout(layout)
+        , m_settings(settings)
+        , m_alphaChannel(alphaChannel)
+        , m_options(options)
+    {
+    }
+
+    bool
+    start(const std::string& path, const std::map<std::string, std::string>& attributes, std::string& errorMessage)
+    {
+        int outputChannels = 0;
+        int resolvedAlphaChannel = -1;
+        std::array<int, 4> sourceChannelMap = { 0, 1, 2, 3 };
+        std::array<const char*, 4> channelNames = { nullptr, nullptr, nullptr, nullptr };
+        if (!resolve_exr_output_layout(m_layout,
+                                       m_alphaChannel,
+                                       outputChannels,
+                                       resolvedAlphaChannel,
+                                       sourceChannelMap,
+                                       channelNames,
+                                       errorMessage)) {
+            return false;
+        }
+
+        if (m_settings.componentType == ImageComponentType::F16) {
+            m_pixelType = OPENEXR_IMF_NAMESPACE::HALF;
+        } else if (m_settings.componentType == ImageComponentType::F32) {
+            m_pixelType = OPENEXR_IMF_NAMESPACE::FLOAT;
+        } else {
+            errorMessage = "unsupported OpenEXR output component type";
+            return false;
+        }
+        m_bytesPerComponent = byte_size_for_image_component(m_settings.componentType);
+        for (int channelIndex = 0; channelIndex < outputChannels; ++channelIndex) {
+            m_channelNames.emplace_back(channelNames[channelIndex]);
+        }
+        m_rowBytes = static_cast<size_t>(m_layout.width) * m_channelNames.size() * m_bytesPerComponent;
+        reserve_exr_global_threads(m_options.threadCount);
+
+        try {
+            OPENEXR_IMF_NAMESPACE::Header header(m_layout.width, m_layout.height);
+            header.compression() = m_options.compression;
+            if (m_options.useTiles) {
+                header.setTileDescription(OPENEXR_IMF_NAMESPACE::TileDescription(m_options.tileWidth,
+                                                                                 m_options.tileHeight,
+                                                                                 OPENEXR_IMF_NAMESPACE::ONE_LEVEL,
+                                                                                 OPENEXR_IMF_NAMESPACE::ROUND_DOWN));
+            }
+            apply_exr_writer_attributes(header, attributes, m_options);
+            for (const std::string& channelName : m_channelNames) {
+                header.channels().insert(channelName, OPENEXR_IMF_NAMESPACE::Channel(m_pixelType));
+            }
+
+            if (m_options.useTiles) {
+                m_tiledOutput = std::make_unique<OPENEXR_IMF_NAMESPACE::TiledOutputFile>(
+                    path.c_str(), header, m_options.threadCount);
+            } else {
+                m_scanlineOutput =
+                    std::make_unique<OPENEXR_IMF_NAMESPACE::OutputFile>(path.c_str(), header, m_options.threadCount);
+            }
+        } catch (const std::exception& e) {
+            errorMessage = e.what();
+            return false;
+        }
+
+        // Decreasing line order is written bottom-up, so those files are encoded once
+        // every row has arrived. Tiled bands hold whole tile rows, enough of them to
+        // give each writer thread a tile.
+        const bool decreasingY = m_options.hasLineOrder && m_options.lineOrder == OPENEXR_IMF_NAMESPACE::DECREASING_Y;
+        if (decreasingY) {
+            m_bandRows = m_layout.height;
+        } else if (m_options.useTiles) {
+            const int tilesAcross = m_tiledOutput->numXTiles(0);
+            const int threadCount = std::max(1, m_options.threadCount);
+            const int tileRowsPerBand = std::max(1, (threadCount + tilesAcross - 1) / tilesAcross);
+            m_bandRows = static_cast<int>(m_options.tileHeight) * tileRowsPerBand;
+        } else {
+            m_bandRows = 1;
+        }
+        return true;
+    }
+
+    bool
+    writeRows(const HostImageData& rows, std::string& errorMessage) override
+    {
+        if (!validate_image_stream_rows(m_layout, m_rowsReceived, rows, errorMessage)) {
+            return false;
+        }
+
+        int outputChannels = 0;
+        std::array<const char*, 4> channelNames = { nullptr, nullptr, nullptr, nullptr };
+        if (!convert_host_image_to_exr_bytes(
+                rows, m_settings, m_alphaChannel, outputChannels, channelNames, m_convertedBytes, errorMessage)) {
+            return false;
+        }
+        if (m_pendingRows == 0) {
+            m_pendingBytes.swap(m_convertedBytes);
+        } else {
+            m_pendingBytes.insert(m_pendingBytes.end(), m_convertedBytes.begin(), m_convertedBytes.end());
+        }
+        m_pendingRows += rows.height;
+        m_rowsReceived += rows.height;
+
+        const bool lastRows = m_rowsReceived == m_layout.height;
+        const int flushRows = lastRows ? m_pendingRows : (m_pendingRows / m_bandRows) * m_bandRows;
+        if (flushRows == 0) {
+            return true;
+        }
+        if (!writeBand(flushRows, errorMessage)) {
+            return false;
+        }
+
+        const size_t flushedBytes = static_cast<size_t>(flushRows) * m_rowBytes;
+        m_pendingBytes.erase(m_pendingBytes.begin(),
+                             m_pendingBytes.begin() + static_cast<std::ptrdiff_t>(flushedBytes));
+        m_pendingRows -= flushRows;
+        return true;
+    }
+
+    bool
+    finish(std::string& errorMessage) override
+    {
+        if (m_rowsReceived != m_layout.height) {
+            errorMessage = "OpenEXR stream finished before every row was written";
+            return false;
+        }
+        try {
+            m_tiledOutput.reset();
+            m_scanlineOutput.reset();
+        } catch (const std::exception& e) {
+            errorMessage = e.what();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool
+    writeBand(const int rowCount, std::string& errorMessage)
+    {
+        try {
+            const IMATH_NAMESPACE::Box2i bandWindow(IMATH_NAMESPACE::V2i(0, m_rowsWritten),
+                                                    IMATH_NAMESPACE::V2i(m_layout.width - 1,
+                                                                         m_rowsWritten + rowCount - 1));
+            const OPENEXR_IMF_NAMESPACE::FrameBuffer frameBuffer = build_exr_interleaved_frame_buffer(
+                bandWindow, m_channelNames, m_pixelType, m_bytesPerComponent, m_pendingBytes.data());
+
+            if (m_tiledOutput) {
+                const int tileHeight = static_cast<int>(m_options.tileHeight);
+                m_tiledOutput->setFrameBuffer(frameBuffer);
+                m_tiledOutput->writeTiles(0,
+                                          m_tiledOutput->numXTiles(0) - 1,
+                                          m_rowsWritten / tileHeight,
+                                          (m_rowsWritten + rowCount - 1) / tileHeight,
+                                          0);
+            } else {
+                m_scanlineOutput->setFrameBuffer(frameBuffer);
+                m_scanlineOutput->writePixels(rowCount);
+            }
+        } catch (const std::exception& e) {
+            errorMessage = e.what();
+            return false;
+        }
+
+        m_rowsWritten += rowCount;
+        return true;
+    }
+
+    HostImageData m_layout;
+    ImageEncodeSettings m_settings;
+    int m_alphaChannel = -1;
+    ExrSaveOptions m_options;
+    OPENEXR_IMF_NAMESPACE::PixelType m_pixelType = OPENEXR_IMF_NAMESPACE::FLOAT;
+    size_t m_bytesPerComponent = 0u;
+    size_t m_rowBytes = 0u;
+    std::vector<std::string> m_channelNames;
+    std::unique_ptr<OPENEXR_IMF_NAMESPACE::OutputFile> m_scanlineOutput;
+    std::unique_ptr<OPENEXR_IMF_NAMESPACE::TiledOutputFile> m_tiledOutput;
+    int m_bandRows = 1;
+    int m_rowsReceived = 0;
+    int m_rowsWritten = 0;
+    int m_pendingRows = 0;
+    std::vector<std::byte> m_pendingBytes;
+    std::vector<std::byte> m_convertedBytes;
+};
 #endif
 
 }  // namespace
 
 DecodedImageData
 decode_exr_file(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    MappedFile mappedFile;
+    DecodedImageData result;
+    if (!mappedFile.open(path, result.errorMessage)) {
+        result.errorMessage = "can't open OpenEXR file";
+        return result;
+    }
+    return decode_exr_memory(mappedFile.bytes(), attributes);
+}
+
+DecodedImageData
+decode_exr_memory(const std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes)
 {
     DecodedImageData result;
 
 #if !defined(RAWGL_HAS_OPENEXR)
-    (void)path;
+    (void)bytes;
     (void)attributes;
     result.errorMessage = "OpenEXR support is not available";
     return result;
 #else
+    int threadCount = 0;
+    if (!parse_exr_thread_count(attributes, { "openexr:threads", "rawgl:decode_threads" }, threadCount, result.errorMessage)) {
+        return result;
+    }
+    uint32_t scaleLog2 = 0u;
+    if (!parse_image_decode_scale(attributes, scaleLog2, result.errorMessage)) {
+        return result;
+    }
+    reserve_exr_global_threads(threadCount);
+
     try {
-        OPENEXR_IMF_NAMESPACE::InputFile file(path.c_str());
+        ExrMemoryInputStream stream(bytes);
+        OPENEXR_IMF_NAMESPACE::InputFile file(stream, threadCount);
         const OPENEXR_IMF_NAMESPACE::Header& header = file.header();
-        IMATH_NAMESPACE::Box2i dataWindow;
+        IMATH_NAMESPACE::Box2i dataWindow = header.dataWindow();
+        // The tiled reader keeps its own stream position over the same bytes.
+        ExrMemoryInputStream tiledStream(bytes);
+        std::unique_ptr<OPENEXR_IMF_NAMESPACE::TiledInputFile> tiledFile;
+        int level = 0;
+        if (header.hasTileDescription()) {
+            tiledFile = std::make_unique<OPENEXR_IMF_NAMESPACE::TiledInputFile>(tiledStream, threadCount);
+            level = select_exr_decode_level(*tiledFile, scaleLog2);
+            dataWindow = tiledFile->dataWindowForLevel(level, level);
+        }
+
         std::vector<std::string> selectedNames;
         std::string errorMessage;
         OPENEXR_IMF_NAMESPACE::PixelType pixelType = OPENEXR_IMF_NAMESPACE::NUM_PIXELTYPES;
@@ -919,14 +1239,9 @@ decode_exr_file(const std::string& path, const std::map<std::string, std::string
         OPENEXR_IMF_NAMESPACE::FrameBuffer frameBuffer =
             build_exr_interleaved_frame_buffer(dataWindow, selectedNames, pixelType, bytesPerComponent, result.bytes.data());
 
-        if (header.hasTileDescription()) {
-            OPENEXR_IMF_NAMESPACE::TiledInputFile tiledFile(path.c_str());
-            if (tiledFile.levelMode() != OPENEXR_IMF_NAMESPACE::ONE_LEVEL) {
-                result.errorMessage = "native OpenEXR decode supports only one-level tiled images yet";
-                return result;
-            }
-            tiledFile.setFrameBuffer(frameBuffer);
-            tiledFile.readTiles(0, tiledFile.numXTiles(0) - 1, 0, tiledFile.numYTiles(0) - 1, 0);
+        if (tiledFile) {
+            tiledFile->setFrameBuffer(frameBuffer);
+            tiledFile->readTiles(0, tiledFile->numXTiles(level) - 1, 0, tiledFile->numYTiles(level) - 1, level, level);
         } else {
             file.setFrameBuffer(frameBuffer);
             file.readPixels(dataWindow.min.y, dataWindow.max.y);
@@ -948,77 +1263,50 @@ encode_exr_file(const std::string& path,
                 const HostImageData& image,
                 const ImageEncodeSettings& settings,
                 std::string& errorMessage)
+{
+    std::unique_ptr<ImageStreamEncoder> encoder =
+        begin_exr_stream_encode(path, attributes, alphaChannel, image, settings, errorMessage);
+    if (!encoder) {
+        return false;
+    }
+    return encoder->writeRows(image, errorMessage) && encoder->finish(errorMessage);
+}
+
+std::unique_ptr<ImageStreamEncoder>
+begin_exr_stream_encode(const std::string& path,
+                        const std::map<std::string, std::string>& attributes,
+                        int alphaChannel,
+                        const HostImageData& layout,
+                        const ImageEncodeSettings& settings,
+                        std::string& errorMessage)
 {
 #if !defined(RAWGL_HAS_OPENEXR)
     (void)path;
     (void)attributes;
     (void)alphaChannel;
-    (void)image;
+    (void)layout;
     (void)settings;
     errorMessage = "OpenEXR support is not available";
-    return false;
+    return nullptr;
 #else
     ExrSaveOptions options;
     if (!parse_exr_save_options(attributes, options, errorMessage)) {
-        return false;
+        return nullptr;
     }
 
-    int outputChannels = 0;
-    std::array<const char*, 4> channelNames = { nullptr, nullptr, nullptr, nullptr };
-    std::vector<std::byte> encodedBytes;
-    if (!convert_host_image_to_exr_bytes(
-            image, settings, alphaChannel, outputChannels, channelNames, encodedBytes, errorMessage)) {
-        return false;
-    }
+    HostImageData streamLayout;
+    streamLayout.width = layout.width;
+    streamLayout.height = layout.height;
+    streamLayout.channels = layout.channels;
+    streamLayout.alphaChannel = layout.alphaChannel;
+    streamLayout.glInternalFormat = layout.glInternalFormat;
+    streamLayout.glType = layout.glType;
 
-    try {
-        OPENEXR_IMF_NAMESPACE::Header header(image.width, image.height);
-        header.compression() = options.compression;
-        if (options.useTiles) {
-            header.setTileDescription(OPENEXR_IMF_NAMESPACE::TileDescription(
-                options.tileWidth, options.tileHeight, OPENEXR_IMF_NAMESPACE::ONE_LEVEL, OPENEXR_IMF_NAMESPACE::ROUND_DOWN));
-        }
-        apply_exr_writer_attributes(header, attributes, options);
-
-        OPENEXR_IMF_NAMESPACE::PixelType pixelType = OPENEXR_IMF_NAMESPACE::FLOAT;
-        if (settings.componentType == ImageComponentType::F16) {
-            pixelType = OPENEXR_IMF_NAMESPACE::HALF;
-        } else if (settings.componentType == ImageComponentType::F32) {
-            pixelType = OPENEXR_IMF_NAMESPACE::FLOAT;
-        } else {
-            errorMessage = "unsupported OpenEXR output component type";
-            return false;
-        }
-
-        for (int channelIndex = 0; channelIndex < outputChannels; ++channelIndex) {
-            header.channels().insert(channelNames[channelIndex], OPENEXR_IMF_NAMESPACE::Channel(pixelType));
-        }
-
-        const size_t bytesPerComponent = byte_size_for_image_component(settings.componentType);
-        std::vector<std::string> selectedNames;
-        selectedNames.reserve(static_cast<size_t>(outputChannels));
-        for (int channelIndex = 0; channelIndex < outputChannels; ++channelIndex) {
-            selectedNames.emplace_back(channelNames[channelIndex]);
-        }
-        const IMATH_NAMESPACE::Box2i dataWindow(
-            IMATH_NAMESPACE::V2i(0, 0), IMATH_NAMESPACE::V2i(image.width - 1, image.height - 1));
-        OPENEXR_IMF_NAMESPACE::FrameBuffer frameBuffer =
-            build_exr_interleaved_frame_buffer(dataWindow, selectedNames, pixelType, bytesPerComponent, encodedBytes.data());
-
-        if (options.useTiles) {
-            OPENEXR_IMF_NAMESPACE::TiledOutputFile output(path.c_str(), header);
-            output.setFrameBuffer(frameBuffer);
-            output.writeTiles(0, output.numXTiles(0) - 1, 0, output.numYTiles(0) - 1, 0);
-        } else {
-            OPENEXR_IMF_NAMESPACE::OutputFile output(path.c_str(), header);
-            output.setFrameBuffer(frameBuffer);
-            output.writePixels(image.height);
-        }
-        return true;
-    } catch (const std::exception& e) {
-        errorMessage = e.what();
-        return false;
+    auto encoder = std::make_unique<ExrStreamEncoder>(streamLayout, settings, alphaChannel, options);
+    if (!encoder->start(path, attributes, errorMessage)) {
+        return nullptr;
     }
+    return encoder;
 #endif
 }
 
@@ -5,7 +5,10 @@
 
 #include "image_backend.h"
 
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 
 namespace rawgl::io {
@@ -13,6 +16,9 @@ namespace rawgl::io {
 DecodedImageData
 decode_exr_file(const std::string& path, const std::map<std::string, std::string>& attributes = {});
 
+DecodedImageData
+decode_exr_memory(std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes = {});
+
 bool
 encode_exr_file(const std::string& path,
                 const std::map<std::string, std::string>& attributes,
@@ -26,4 +32,13 @@ extract_exr_reencode_attributes(const std::string& path,
                                 std::map<std::string, std::string>& attributes,
                                 std::string& errorMessage);
 
+/// Starts a row-band OpenEXR encode; see \ref begin_image_stream_encode.
+std::unique_ptr<ImageStreamEncoder>
+begin_exr_stream_encode(const std::string& path,
+                        const std::map<std::string, std::string>& attributes,
+                        int alphaChannel,
+                        const HostImageData& layout,
+                        const ImageEncodeSettings& settings,
+                        std::string& errorMessage);
+
 }  // namespace rawgl::io
@@ -9,6 +9,7 @@
 #include "jpeg2000_backend.h"
 #include "jpg_backend.h"
 #include "log.h"
+#include "mapped_file.h"
 #include "path_utils.h"
 #include "png_backend.h"
 #include "tiff_backend.h"
@@ -17,9 +18,12 @@
 #include <OpenImageIO/imageio.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <cstdlib>
 #include <cstring>
+#include <initializer_list>
 #include <memory>
 
 namespace rawgl::io {
@@ -40,6 +44,9 @@ enum class DecodeBackendPolicy : uint8_t {
     OpenImageIoOnly,
 };
 
+// Indexed by ImageCodecFamily.
+std::array<std::atomic<uint32_t>, static_cast<size_t>(ImageCodecFamily::Webp) + 1u> s_lastCodecThreadCounts {};
+
 static char
 to_lower_ascii(const unsigned char c)
 {
@@ -316,6 +323,19 @@ resolve_output_pixel_format(const unsigned int glType, OIIO::TypeDesc& pixelForm
     return false;
 }
 
+static size_t
+host_component_byte_size(const unsigned int glType)
+{
+    switch (glType) {
+    case GL_UNSIGNED_BYTE: return 1u;
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT: return 2u;
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT: return 4u;
+    default: return 0u;
+    }
+}
+
 static DecodedImageData
 decode_image_file_oiio(const std::string& path, const std::map<std::string, std::string>& attributes)
 {
@@ -412,7 +432,7 @@ encode_image_file_oiio(const std::string& path,
     }
 
     if (!output->write_image(pixelFormat,
-                             image.bytes.data(),
+                             image.pixelBytes().data(),
                              OIIO::AutoStride,
                              OIIO::AutoStride,
                              OIIO::AutoStride,
@@ -436,6 +456,77 @@ encode_image_file_oiio(const std::string& path,
     return true;
 }
 
+static bool
+starts_with_signature(const std::span<const std::byte> bytes, const std::initializer_list<uint8_t> signature)
+{
+    if (bytes.size() < signature.size()) {
+        return false;
+    }
+    size_t index = 0u;
+    for (const uint8_t value : signature) {
+        if (static_cast<uint8_t>(bytes[index++]) != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static ImageCodecFamily
+detect_image_codec_family(const std::span<const std::byte> bytes)
+{
+    if (starts_with_signature(bytes, { 0xffu, 0xd8u, 0xffu })) {
+        return ImageCodecFamily::Jpeg;
+    }
+    if (starts_with_signature(bytes, { 0x89u, 0x50u, 0x4eu, 0x47u, 0x0du, 0x0au, 0x1au, 0x0au })) {
+        return ImageCodecFamily::Png;
+    }
+    // Classic and BigTIFF headers in either byte order.
+    if (starts_with_signature(bytes, { 0x49u, 0x49u, 0x2au, 0x00u })
+        || starts_with_signature(bytes, { 0x4du, 0x4du, 0x00u, 0x2au })
+        || starts_with_signature(bytes, { 0x49u, 0x49u, 0x2bu, 0x00u })
+        || starts_with_signature(bytes, { 0x4du, 0x4du, 0x00u, 0x2bu })) {
+        return ImageCodecFamily::Tiff;
+    }
+    if (starts_with_signature(bytes, { 0x76u, 0x2fu, 0x31u, 0x01u })) {
+        return ImageCodecFamily::Exr;
+    }
+    if (starts_with_signature(bytes, { 0x00u, 0x00u, 0x00u, 0x0cu, 0x6au, 0x50u, 0x20u, 0x20u })
+        || starts_with_signature(bytes, { 0xffu, 0x4fu, 0xffu, 0x51u })) {
+        return ImageCodecFamily::Jpeg2000;
+    }
+    return ImageCodecFamily::Unknown;
+}
+
+static bool
+parse_image_decode_request(const std::map<std::string, std::string>& attributes,
+                           DecodeBackendPolicy& policy,
+                           std::string& errorMessage)
+{
+    uint32_t scaleLog2 = 0u;
+    return parse_decode_backend_policy(attributes, policy, errorMessage)
+           && parse_image_decode_scale(attributes, scaleLog2, errorMessage);
+}
+
+static DecodedImageData
+decode_native_image_memory(const ImageBackendKind backend,
+                           const std::span<const std::byte> bytes,
+                           const std::map<std::string, std::string>& attributes)
+{
+    switch (backend) {
+    case ImageBackendKind::NativeJpegTurbo: return decode_jpg_memory(bytes, attributes);
+    case ImageBackendKind::NativePng: return decode_png_memory(bytes, attributes);
+    case ImageBackendKind::NativeTiff: return decode_tiff_memory(bytes, attributes);
+    case ImageBackendKind::NativeOpenExr: return decode_exr_memory(bytes, attributes);
+    case ImageBackendKind::NativeJpeg2000: return decode_jpeg2000_memory(bytes, attributes);
+    case ImageBackendKind::OiioFallback:
+    default: break;
+    }
+
+    DecodedImageData result;
+    result.errorMessage = "native decode backend is not available for this image family";
+    return result;
+}
+
 }  // namespace
 
 ImageCodecFamily
@@ -461,14 +552,51 @@ byte_size_for_image_component(const ImageComponentType componentType)
     return 0u;
 }
 
+void
+record_codec_thread_count(const ImageCodecFamily codec, const uint32_t threadCount)
+{
+    s_lastCodecThreadCounts[static_cast<size_t>(codec)].store(threadCount, std::memory_order_relaxed);
+}
+
+uint32_t
+last_codec_thread_count(const ImageCodecFamily codec)
+{
+    return s_lastCodecThreadCounts[static_cast<size_t>(codec)].load(std::memory_order_relaxed);
+}
+
+bool
+parse_image_decode_scale(const std::map<std::string, std::string>& attributes,
+                         uint32_t& scaleLog2,
+                         std::string& errorMessage)
+{
+    scaleLog2 = 0u;
+    const std::string* attribute = find_attribute_value(attributes, "rawgl:decode_scale");
+    if (attribute == nullptr) {
+        return true;
+    }
+
+    const bool digitsOnly = !attribute->empty() && attribute->size() <= 3u
+                            && std::all_of(attribute->begin(), attribute->end(), [](const char c) {
+                                   return std::isdigit(static_cast<unsigned char>(c)) != 0;
+                               });
+    const unsigned long denominator = digitsOnly ? std::strtoul(attribute->c_str(), nullptr, 10) : 0ul;
+    if (denominator == 0ul || denominator > 256ul || (denominator & (denominator - 1ul)) != 0ul) {
+        errorMessage = "invalid image decode scale; expected a power of two from 1 to 256";
+        return false;
+    }
+
+    while ((1ul << scaleLog2) < denominator) {
+        ++scaleLog2;
+    }
+    return true;
+}
+
 DecodedImageData
 decode_image_file(const std::string& path, const std::map<std::string, std::string>& attributes)
 {
     DecodeBackendPolicy policy = DecodeBackendPolicy::Auto;
-    std::string policyErrorMessage;
-    if (!parse_decode_backend_policy(attributes, policy, policyErrorMessage)) {
-        DecodedImageData result;
-        result.errorMessage = policyErrorMessage;
+    DecodedImageData result;
+    if (!parse_image_decode_request(attributes, policy, result.errorMessage)) {
         return result;
     }
 
@@ -481,73 +609,53 @@ decode_image_file(const std::string& path, const std::map<std::string, std::stri
     const ImageBackendKind backend = select_decode_backend(codec);
     LOG(debug) << "Image decode backend selected: " << image_backend_kind_name(backend) << " for " << path;
 
-    switch (backend) {
-    case ImageBackendKind::OiioFallback:
+    if (backend == ImageBackendKind::OiioFallback) {
         if (policy == DecodeBackendPolicy::NativeOnly) {
-            DecodedImageData result;
             result.errorMessage = "native decode backend is not available for this image family";
             return result;
         }
         return decode_image_file_oiio(path, attributes);
-    case ImageBackendKind::NativeJpegTurbo: {
-        DecodedImageData result = decode_jpg_file(path, attributes);
-        if (result.success) {
-            return result;
-        }
-        if (policy == DecodeBackendPolicy::NativeOnly) {
-            return result;
-        }
-        LOG(warning) << "Native JPEG decode failed for " << path << ", falling back to OIIO: " << result.errorMessage;
-        return decode_image_file_oiio(path, attributes);
     }
-    case ImageBackendKind::NativePng: {
-        DecodedImageData result = decode_png_file(path, attributes);
-        if (result.success) {
-            return result;
-        }
-        if (policy == DecodeBackendPolicy::NativeOnly) {
-            return result;
+
+    // Native decoders read from one shared mapping; OpenImageIO reopens the path only if it has to take over.
+    {
+        MappedFile mappedFile;
+        if (mappedFile.open(path, result.errorMessage)) {
+            result = decode_native_image_memory(backend, mappedFile.bytes(), attributes);
         }
-        LOG(warning) << "Native PNG decode failed for " << path << ", falling back to OIIO: " << result.errorMessage;
-        return decode_image_file_oiio(path, attributes);
     }
-    case ImageBackendKind::NativeTiff: {
-        DecodedImageData result = decode_tiff_file(path, attributes);
-        if (result.success) {
-            return result;
-        }
-        if (policy == DecodeBackendPolicy::NativeOnly) {
-            return result;
-        }
-        LOG(warning) << "Native TIFF decode failed for " << path << ", falling back to OIIO: " << result.errorMessage;
-        return decode_image_file_oiio(path, attributes);
+    if (result.success || policy == DecodeBackendPolicy::NativeOnly) {
+        return result;
     }
-    case ImageBackendKind::NativeOpenExr: {
-        DecodedImageData result = decode_exr_file(path, attributes);
-        if (result.success) {
-            return result;
-        }
-        if (policy == DecodeBackendPolicy::NativeOnly) {
-            return result;
-        }
-        LOG(warning) << "Native OpenEXR decode failed for " << path << ", falling back to OIIO: " << result.errorMessage;
-        return decode_image_file_oiio(path, attributes);
+
+    LOG(warning) << image_backend_kind_name(backend) << " decode failed for " << path
+                 << ", falling back to OIIO: " << result.errorMessage;
+    return decode_image_file_oiio(path, attributes);
+}
+
+DecodedImageData
+decode_image_memory(const std::span<const std::byte> bytes,
+                    const std::string& nameHint,
+                    const std::map<std::string, std::string>& attributes)
+{
+    DecodeBackendPolicy policy = DecodeBackendPolicy::Auto;
+    DecodedImageData result;
+    if (!parse_image_decode_request(attributes, policy, result.errorMessage)) {
+        return result;
     }
-    case ImageBackendKind::NativeJpeg2000: {
-        DecodedImageData result = decode_jpeg2000_file(path, attributes);
-        if (result.success) {
-            return result;
-        }
-        if (policy == DecodeBackendPolicy::NativeOnly) {
-            return result;
-        }
-        LOG(warning) << "Native JPEG-2000 decode failed for " << path << ", falling back to OIIO: "
-                     << result.errorMessage;
-        return decode_image_file_oiio(path, attributes);
+    if (policy == DecodeBackendPolicy::OpenImageIoOnly) {
+        result.errorMessage = "OpenImageIO decode is not available for in-memory images";
+        return result;
     }
-    default:
-        return decode_image_file_oiio(path, attributes);
+
+    ImageCodecFamily codec = nameHint.empty() ? ImageCodecFamily::Unknown : get_image_codec_family(nameHint);
+    if (codec == ImageCodecFamily::Unknown) {
+        codec = detect_image_codec_family(bytes);
     }
+
+    const ImageBackendKind backend = select_decode_backend(codec);
+    LOG(debug) << "In-memory image decode backend selected: " << image_backend_kind_name(backend);
+    return decode_native_image_memory(backend, bytes, attributes);
 }
 
 ImageEncodeSettings
@@ -622,4 +730,181 @@ encode_image_file(const std::string& path,
     }
 }
 
+namespace {
+
+class BufferedImageStreamEncoder final : public ImageStreamEncoder {
+public:
+    BufferedImageStreamEncoder(const std::string& path,
+                               const std::map<std::string, std::string>& attributes,
+                               const int alphaChannel,
+                               const HostImageData& layout,
+                               const ImageEncodeSettings& settings)
+        : m_path(path)
+        , m_attributes(attributes)
+        , m_alphaChannel(alphaChannel)
+        , m_settings(settings)
+    {
+        m_image.width = layout.width;
+        m_image.height = layout.height;
+        m_image.channels = layout.channels;
+        m_image.alphaChannel = layout.alphaChannel;
+        m_image.glInternalFormat = layout.glInternalFormat;
+        m_image.glType = layout.glType;
+    }
+
+    bool
+    writeRows(const HostImageData& rows, std::string& errorMessage) override
+    {
+        if (!validate_image_stream_rows(m_image, m_rowsWritten, rows, errorMessage)) {
+            return false;
+        }
+        const std::span<const std::byte> bytes = rows.pixelBytes();
+        m_image.bytes.insert(m_image.bytes.end(), bytes.begin(), bytes.end());
+        m_rowsWritten += rows.height;
+        return true;
+    }
+
+    bool
+    finish(std::string& errorMessage) override
+    {
+        if (m_rowsWritten != m_image.height) {
+            errorMessage = "image stream finished before every row was written";
+            return false;
+        }
+        return encode_image_file(m_path, m_attributes, m_alphaChannel, m_image, m_settings, errorMessage);
+    }
+
+private:
+    std::string m_path;
+    std::map<std::string, std::string> m_attributes;
+    int m_alphaChannel = -1;
+    ImageEncodeSettings m_settings;
+    HostImageData m_image;
+    int m_rowsWritten = 0;
+};
+
+}  // namespace
+
+bool
+image_encode_accepts_packed_capture(const ImageEncodeSettings& settings)
+{
+    if (settings.componentType != ImageComponentType::U8 && settings.componentType != ImageComponentType::U16) {
+        return false;
+    }
+
+    switch (select_encode_backend(settings.codec)) {
+    case ImageBackendKind::NativeJpegTurbo:
+    case ImageBackendKind::NativePng:
+    case ImageBackendKind::NativeTiff: return true;
+    default: return false;
+    }
+}
+
+bool
+image_codec_supports_stream_encode(const ImageCodecFamily codec)
+{
+    switch (select_encode_backend(codec)) {
+    case ImageBackendKind::NativePng:
+    case ImageBackendKind::NativeTiff:
+    case ImageBackendKind::NativeOpenExr: return true;
+    default: return false;
+    }
+}
+
+std::unique_ptr<ImageStreamEncoder>
+begin_image_stream_encode(const std::string& path,
+                          const std::map<std::string, std::string>& attributes,
+                          int alphaChannel,
+                          const HostImageData& layout,
+                          const ImageEncodeSettings& settings,
+                          std::string& errorMessage)
+{
+    if (layout.width <= 0 || layout.height <= 0 || layout.channels <= 0) {
+        errorMessage = "invalid image stream layout";
+        return nullptr;
+    }
+
+    const ImageBackendKind backend = select_encode_backend(settings.codec);
+    LOG(debug) << "Image stream encode backend selected: " << image_backend_kind_name(backend) << " for " << path;
+
+    std::unique_ptr<ImageStreamEncoder> encoder;
+    std::string nativeErrorMessage;
+    switch (backend) {
+    case ImageBackendKind::NativePng:
+        encoder = begin_png_stream_encode(path, attributes, alphaChannel, layout, settings, nativeErrorMessage);
+        break;
+    case ImageBackendKind::NativeTiff:
+        encoder = begin_tiff_stream_encode(path, attributes, alphaChannel, layout, settings, nativeErrorMessage);
+        break;
+    case ImageBackendKind::NativeOpenExr:
+        encoder = begin_exr_stream_encode(path, attributes, alphaChannel, layout, settings, nativeErrorMessage);
+        break;
+    default: return make_buffered_image_stream_encoder(path, attributes, alphaChannel, layout, settings);
+    }
+
+    if (!encoder) {
+        errorMessage = nativeErrorMessage.empty() ? "native image stream encode failed to start" : nativeErrorMessage;
+    }
+    return encoder;
+}
+
+std::unique_ptr<ImageStreamEncoder>
+make_buffered_image_stream_encoder(const std::string& path,
+                                   const std::map<std::string, std::string>& attributes,
+                                   const int alphaChannel,
+                                   const HostImageData& layout,
+                                   const ImageEncodeSettings& settings)
+{
+    return std::make_unique<BufferedImageStreamEncoder>(path, attributes, alphaChannel, layout, settings);
+}
+
+bool
+validate_image_stream_rows(const HostImageData& layout,
+                           const int rowsWritten,
+                           const HostImageData& rows,
+                           std::string& errorMessage)
+{
+    if (rows.width != layout.width || rows.channels != layout.channels || rows.glType != layout.glType) {
+        errorMessage = "image stream rows do not match the stream layout";
+        return false;
+    }
+    if (rows.height <= 0 || rows.height > layout.height - rowsWritten) {
+        errorMessage = "image stream rows exceed the image height";
+        return false;
+    }
+
+    const size_t componentSize = host_component_byte_size(rows.glType);
+    const size_t expectedBytes = static_cast<size_t>(rows.width) * static_cast<size_t>(rows.height)
+                                 * static_cast<size_t>(rows.channels) * componentSize;
+    if (componentSize == 0u || rows.pixelBytes().size() != expectedBytes) {
+        errorMessage = "image stream rows have an unexpected byte size";
+        return false;
+    }
+    return true;
+}
+
+HostImageData
+make_image_row_band(const HostImageData& image, const int firstRow, const int rowCount)
+{
+    HostImageData band;
+    band.width = image.width;
+    band.height = rowCount;
+    band.channels = image.channels;
+    band.alphaChannel = image.alphaChannel;
+    band.glInternalFormat = image.glInternalFormat;
+    band.glType = image.glType;
+
+    const std::span<const std::byte> bytes = image.pixelBytes();
+    const size_t rowBytes = image.height > 0 ? bytes.size() / static_cast<size_t>(image.height) : 0u;
+    const std::span<const std::byte> rows =
+        bytes.subspan(static_cast<size_t>(firstRow) * rowBytes, static_cast<size_t>(rowCount) * rowBytes);
+    if (image.sharedBytes) {
+        band.sharedBytes     = std::shared_ptr<const std::byte>(image.sharedBytes, rows.data());
+        band.sharedByteCount = rows.size();
+    } else {
+        band.bytes.assign(rows.begin(), rows.end());
+    }
+    return band;
+}
+
 }  // namespace rawgl::io
@@ -8,6 +8,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -61,9 +63,36 @@ get_image_codec_family(const std::string& path);
 size_t
 byte_size_for_image_component(const ImageComponentType componentType);
 
+/// Records the thread count a native decode or encode handed to its codec library.
+void
+record_codec_thread_count(ImageCodecFamily codec, uint32_t threadCount);
+
+/// Returns the thread count recorded by the most recent decode or encode of `codec`, or 0 before the first one.
+///
+/// Kept process-wide so the IO smoke tests can observe the threads IoRuntime resolves for a load or save.
+uint32_t
+last_codec_thread_count(ImageCodecFamily codec);
+
+/// Reads the "rawgl:decode_scale" load attribute as the base-2 log of the requested reduction.
+///
+/// The attribute is a power-of-two denominator in [1, 256]; when absent, `scaleLog2` is 0.
+bool
+parse_image_decode_scale(const std::map<std::string, std::string>& attributes,
+                         uint32_t& scaleLog2,
+                         std::string& errorMessage);
+
 DecodedImageData
 decode_image_file(const std::string& path, const std::map<std::string, std::string>& attributes);
 
+/// Decodes an image that is already resident in memory with the native codecs.
+///
+/// The codec is chosen from the extension of `nameHint` when it has a known one, otherwise from the leading
+/// signature bytes. OpenImageIO fallback is not available for in-memory sources.
+DecodedImageData
+decode_image_memory(std::span<const std::byte> bytes,
+                    const std::string& nameHint,
+                    const std::map<std::string, std::string>& attributes);
+
 ImageEncodeSettings
 resolve_image_encode_settings(const std::string& path, int bits);
 
@@ -75,4 +104,58 @@ encode_image_file(const std::string& path,
                   const ImageEncodeSettings& settings,
                   std::string& errorMessage);
 
+/// Incremental encoder that receives one image as consecutive bands of full-width rows, top to bottom.
+class ImageStreamEncoder {
+public:
+    virtual ~ImageStreamEncoder() = default;
+
+    /// Encodes the next `rows.height` rows. The band must match the width, channel count, and pixel type of the
+    /// layout the stream was started with.
+    virtual bool writeRows(const HostImageData& rows, std::string& errorMessage) = 0;
+    /// Completes the file once every row has been written.
+    virtual bool finish(std::string& errorMessage) = 0;
+};
+
+/// Returns true when the encoder for `settings` quantizes float pixels to its unorm component type the same way the
+/// GPU output packer does, so a capture packed to that type before readback encodes to the same file.
+bool
+image_encode_accepts_packed_capture(const ImageEncodeSettings& settings);
+
+/// Returns true when `codec` is encoded row band by row band instead of being buffered whole.
+bool
+image_codec_supports_stream_encode(ImageCodecFamily codec);
+
+/// Starts a streaming encode of an image shaped like `layout`; the pixel bytes of `layout` are ignored.
+///
+/// Native PNG, TIFF, and OpenEXR writers encode bands as they arrive. Other codecs, and writer options that need
+/// the whole image at once, collect the bands and encode them in `finish`.
+std::unique_ptr<ImageStreamEncoder>
+begin_image_stream_encode(const std::string& path,
+                          const std::map<std::string, std::string>& attributes,
+                          int alphaChannel,
+                          const HostImageData& layout,
+                          const ImageEncodeSettings& settings,
+                          std::string& errorMessage);
+
+/// Returns a stream encoder that collects every band and writes the image through \ref encode_image_file.
+std::unique_ptr<ImageStreamEncoder>
+make_buffered_image_stream_encoder(const std::string& path,
+                                   const std::map<std::string, std::string>& attributes,
+                                   int alphaChannel,
+                                   const HostImageData& layout,
+                                   const ImageEncodeSettings& settings);
+
+/// Checks that `rows` continues a stream shaped like `layout` after `rowsWritten` rows.
+bool
+validate_image_stream_rows(const HostImageData& layout,
+                           int rowsWritten,
+                           const HostImageData& rows,
+                           std::string& errorMessage);
+
+/// Returns a band of `rowCount` rows starting at `firstRow` of `image`.
+///
+/// Shared pixels are aliased and kept alive through the band's own reference; owned pixels are copied.
+HostImageData
+make_image_row_band(const HostImageData& image, int firstRow, int rowCount);
+
 }  // namespace rawgl::io
@@ -3,13 +3,19 @@
 
 #include "rawgl/rawgl_io.h"
 
+#include "image_backend.h"
+#include "io_runtime.h"
 #include "output_writer.h"
 #include "texture_loader.h"
 
 #include <OpenImageIO/oiioversion.h>
 
+#include <algorithm>
+#include <cstring>
 #include <exception>
+#include <future>
 #include <map>
+#include <span>
 #include <sstream>
 #include <utility>
 
@@ -91,6 +97,21 @@ to_attribute_value(const JpegLoadColorTransform colorTransform)
     return "auto";
 }
 
+static const char*
+to_attribute_value(const JpegDctMethod dctMethod)
+{
+    switch (dctMethod) {
+        case JpegDctMethod::Accurate:
+            return "accurate";
+        case JpegDctMethod::Fast:
+            return "fast";
+        case JpegDctMethod::Float:
+            return "float";
+    }
+
+    return "accurate";
+}
+
 static const char*
 to_attribute_value(const OpenExrChannelSelection channelSelection)
 {
@@ -259,6 +280,12 @@ apply_jpeg_load_options(std::map<std::string, std::string>& attributes, const Jp
     if (options.hasColorTransform) {
         attributes["jpeg:color_transform"] = to_attribute_value(options.colorTransform);
     }
+    if (options.hasDctMethod) {
+        attributes["jpeg:dct_method"] = to_attribute_value(options.dctMethod);
+    }
+    if (options.hasFancyUpsampling) {
+        attributes["jpeg:fancy_upsampling"] = to_attribute_value(options.fancyUpsampling);
+    }
 }
 
 static void
@@ -283,6 +310,9 @@ apply_openexr_load_options(std::map<std::string, std::string>& attributes, const
     if (options.hasChannelSelection) {
         attributes["openexr:channel_selection"] = to_attribute_value(options.channelSelection);
     }
+    if (options.hasThreadCount) {
+        attributes["openexr:threads"] = std::to_string(options.threadCount);
+    }
 }
 
 static void
@@ -294,15 +324,27 @@ apply_jpeg2000_load_options(std::map<std::string, std::string>& attributes, cons
     if (options.hasLayerLimit) {
         attributes["jpeg2000:layer_limit"] = std::to_string(options.layerLimit);
     }
+    if (options.hasRegion) {
+        attributes["jpeg2000:region"] = std::to_string(options.regionX) + "," + std::to_string(options.regionY) + ","
+                                        + std::to_string(options.regionWidth) + ","
+                                        + std::to_string(options.regionHeight);
+    }
+    if (options.hasThreadCount) {
+        attributes["jpeg2000:threads"] = std::to_string(options.threadCount);
+    }
 }
 
+template<typename LoadRequest>
 static std::map<std::string, std::string>
-to_load_attribute_map(const ImageLoadRequest& request)
+to_load_attribute_map(const LoadRequest& request)
 {
     std::map<std::string, std::string> result = to_attribute_map(request.attributes);
     if (request.codecOptions.hasBackendPolicy) {
         result["rawgl:load_backend"] = to_attribute_value(request.codecOptions.backendPolicy);
     }
+    if (request.codecOptions.hasDecodeScale) {
+        result["rawgl:decode_scale"] = std::to_string(request.codecOptions.decodeScale);
+    }
     if (request.codecOptions.hasJpeg) {
         apply_jpeg_load_options(result, request.codecOptions.jpeg);
     }
@@ -336,6 +378,9 @@ apply_jpeg_codec_options(std::map<std::string, std::string>& attributes, const J
     if (options.hasSubsampling) {
         attributes["jpeg:subsampling"] = to_attribute_value(options.subsampling);
     }
+    if (options.hasDctMethod) {
+        attributes["jpeg:dct_method"] = to_attribute_value(options.dctMethod);
+    }
 }
 
 static void
@@ -420,6 +465,9 @@ apply_openexr_codec_options(std::map<std::string, std::string>& attributes, cons
     if (options.hasDwaCompressionLevel) {
         attributes["openexr:dwa_compression_level"] = std::to_string(options.dwaCompressionLevel);
     }
+    if (options.hasThreadCount) {
+        attributes["openexr:threads"] = std::to_string(options.threadCount);
+    }
 }
 
 static void
@@ -434,6 +482,9 @@ apply_jpeg2000_codec_options(std::map<std::string, std::string>& attributes, con
     if (options.hasQuality) {
         attributes["jpeg2000:quality"] = std::to_string(options.quality);
     }
+    if (options.hasThreadCount) {
+        attributes["jpeg2000:threads"] = std::to_string(options.threadCount);
+    }
 }
 
 static std::map<std::string, std::string>
@@ -458,6 +509,20 @@ to_save_attribute_map(const ImageSaveRequest& request)
     return result;
 }
 
+static size_t
+host_image_pixel_size(const HostImageData& image)
+{
+    if (image.width <= 0 || image.height <= 0) {
+        return 0u;
+    }
+    const size_t pixelCount = static_cast<size_t>(image.width) * static_cast<size_t>(image.height);
+    const size_t byteCount = image.pixelBytes().size();
+    if (byteCount == 0u || byteCount % pixelCount != 0u) {
+        return 0u;
+    }
+    return byteCount / pixelCount;
+}
+
 static std::string
 build_addressed_output_name(const FileOutputBinding& output)
 {
@@ -610,11 +675,13 @@ add_jpeg_capabilities(ImageIoCapabilities& result)
     codec.fallbackWrite = false;
     codec.nativeReadComponentTypes = { "u8" };
     codec.nativeWriteComponentTypes = { "u8" };
-    codec.nativeReadOptions = { "rawgl:load_backend", "rawgl:decode_backend", "jpeg:color_transform" };
+    codec.nativeReadOptions = { "rawgl:load_backend", "rawgl:decode_backend", "rawgl:decode_scale",
+                                "jpeg:color_transform", "jpeg:dct_method", "jpeg:fancy_upsampling" };
     codec.nativeWriteOptions = { "jpeg:quality", "jpg:quality", "oiio:Compression",
                                  "jpeg:progressive", "jpg:progressive",
                                  "jpeg:optimize", "jpg:optimize",
-                                 "jpeg:subsampling", "jpg:subsampling" };
+                                 "jpeg:subsampling", "jpg:subsampling",
+                                 "jpeg:dct_method", "jpg:dct_method" };
     codec.nativeWriteCompressionModes = { "baseline", "progressive" };
     add_detail(codec, "libjpeg.enabled", "true");
 #    if defined(LIBJPEG_TURBO_VERSION)
@@ -655,12 +722,14 @@ add_jpeg2000_capabilities(ImageIoCapabilities& result)
     codec.fallbackWrite = false;
     codec.nativeReadComponentTypes = { "u8", "u16" };
     codec.nativeWriteComponentTypes = { "u8", "u16" };
-    codec.nativeReadOptions = { "rawgl:load_backend", "rawgl:decode_backend",
+    codec.nativeReadOptions = { "rawgl:load_backend", "rawgl:decode_backend", "rawgl:decode_scale",
                                 "jpeg2000:reduce_factor", "jpeg2000:reduce",
-                                "jpeg2000:layer_limit", "jpeg2000:layers" };
+                                "jpeg2000:layer_limit", "jpeg2000:layers",
+                                "jpeg2000:region", "jpeg2000:threads" };
     codec.nativeWriteOptions = { "jpeg2000:lossless",
                                  "jpeg2000:compression_ratio", "jpeg2000:rate",
-                                 "jpeg2000:quality", "jpeg2000:psnr" };
+                                 "jpeg2000:quality", "jpeg2000:psnr",
+                                 "jpeg2000:threads" };
     codec.nativeWriteCompressionModes = { "lossless", "rate", "quality" };
     add_detail(codec, "openjpeg.enabled", "true");
     add_detail(codec, "openjpeg.version", opj_version());
@@ -760,7 +829,9 @@ add_openexr_capabilities(ImageIoCapabilities& result)
     codec.nativeReadComponentTypes = { "f16", "f32", "u32" };
     codec.nativeWriteComponentTypes = { "f16", "f32" };
     codec.nativeReadOptions = { "rawgl:load_backend", "rawgl:decode_backend",
-                                "openexr:channel_selection", "openexr:channelSelection" };
+                                "rawgl:decode_scale",
+                                "openexr:channel_selection", "openexr:channelSelection",
+                                "openexr:threads" };
     codec.nativeWriteOptions = { "openexr:compression", "compression", "oiio:Compression",
                                  "openexr:layout", "openexr:storageLayout", "openexr:storage_layout",
                                  "openexr:tiled",
@@ -769,12 +840,14 @@ add_openexr_capabilities(ImageIoCapabilities& result)
                                  "openexr:tileLength", "openexr:tile_length",
                                  "openexr:lineOrder", "openexr:line_order",
                                  "openexr:dwaCompressionLevel", "openexr:dwa_compression_level",
+                                 "openexr:threads",
                                  "openexr:attribute:string:<name>" };
     add_detail(codec, "openexr.enabled", "true");
 #    if defined(OPENEXR_VERSION_STRING)
     add_detail(codec, "openexr.version", OPENEXR_VERSION_STRING);
 #    endif
     add_detail(codec, "openexr.tiled_one_level", "true");
+    add_detail(codec, "openexr.read_tile_levels", "true");
     add_detail(codec, "openexr.multipart", "false");
 #else
     codec.nativeWrite = false;
@@ -839,10 +912,33 @@ add_fallback_only_codec(ImageIoCapabilities& result,
 }
 
 static ImageSaveResult
-save_image_file_impl(const ImageSaveRequest& request)
+save_image_file_impl(const IoRuntimeService& service, const ImageSaveRequest& request, const HostImageData& image)
 {
     ImageSaveResult result;
 
+    try {
+        OutputWriteRequest writeRequest;
+        writeRequest.path         = request.path;
+        writeRequest.attributes   = to_save_attribute_map(request);
+        writeRequest.alphaChannel = request.alphaChannel;
+        writeRequest.bits         = request.bits;
+        writeRequest.image        = &image;
+        if (!service.saveImageOutput(writeRequest, result.errorMessage)) {
+            return result;
+        }
+        result.success = true;
+    } catch (const std::exception& exception) {
+        result.errorMessage = exception.what();
+    }
+
+    return result;
+}
+
+static ImageStreamBeginResult
+begin_image_file_stream_impl(const IoRuntimeService& service, const ImageSaveRequest& request)
+{
+    ImageStreamBeginResult result;
+
     try {
         OutputWriteRequest writeRequest;
         writeRequest.path         = request.path;
@@ -850,9 +946,12 @@ save_image_file_impl(const ImageSaveRequest& request)
         writeRequest.alphaChannel = request.alphaChannel;
         writeRequest.bits         = request.bits;
         writeRequest.image        = &request.image;
-        if (!save_image_output(writeRequest, result.errorMessage)) {
+        std::unique_ptr<ImageStreamEncoder> encoder =
+            service.beginImageOutputStream(writeRequest, result.errorMessage);
+        if (!encoder) {
             return result;
         }
+        result.stream  = ImageFileStream(std::move(encoder));
         result.success = true;
     } catch (const std::exception& exception) {
         result.errorMessage = exception.what();
@@ -862,12 +961,12 @@ save_image_file_impl(const ImageSaveRequest& request)
 }
 
 static ImageLoadResult
-load_image_file_impl(const ImageLoadRequest& request)
+load_shared_image_file(const IoRuntimeService& service, const ImageLoadRequest& request)
 {
     ImageLoadResult result;
 
     try {
-        result.image   = load_host_image_data(request.path, to_load_attribute_map(request));
+        result.image   = service.loadHostImageData(request.path, to_load_attribute_map(request));
         result.success = true;
     } catch (const std::exception& exception) {
         result.errorMessage = exception.what();
@@ -876,23 +975,204 @@ load_image_file_impl(const ImageLoadRequest& request)
     return result;
 }
 
+static ImageLoadResult
+load_image_file_impl(const IoRuntimeService& service, const ImageLoadRequest& request)
+{
+    ImageLoadResult result = load_shared_image_file(service, request);
+    if (result.image.sharedBytes) {
+        // Public loads hand back editable pixels; only materialized inputs keep the shared buffer.
+        const std::span<const std::byte> pixels = result.image.pixelBytes();
+        result.image.bytes.assign(pixels.begin(), pixels.end());
+        result.image.sharedBytes.reset();
+        result.image.sharedByteCount = 0;
+    }
+    return result;
+}
+
+static ImageLoadResult
+load_image_memory_impl(const IoRuntimeService& service, const ImageMemoryLoadRequest& request)
+{
+    ImageLoadResult result;
+
+    try {
+        auto decoded = std::make_shared<const DecodedImageData>(
+            service.decodeImageMemory(request.bytes, request.nameHint, to_load_attribute_map(request)));
+        if (!decoded->success) {
+            result.errorMessage = decoded->errorMessage.empty() ? "failed to decode in-memory image"
+                                                                : decoded->errorMessage;
+            return result;
+        }
+        result.image = to_host_image_data(make_loaded_texture_data(std::move(decoded)));
+        if (result.image.sharedBytes) {
+            const std::span<const std::byte> pixels = result.image.pixelBytes();
+            result.image.bytes.assign(pixels.begin(), pixels.end());
+            result.image.sharedBytes.reset();
+            result.image.sharedByteCount = 0;
+        }
+        result.success = true;
+    } catch (const std::exception& exception) {
+        result.errorMessage = exception.what();
+    }
+
+    return result;
+}
+
+template<typename FileInput>
+static ImageLoadRequest
+make_file_input_load_request(const FileInput& fileInput)
+{
+    ImageLoadRequest loadRequest;
+    loadRequest.path = fileInput.path;
+    loadRequest.attributes = fileInput.attributes;
+    loadRequest.codecOptions = fileInput.codecOptions;
+    return loadRequest;
+}
+
+template<typename FileInput>
+static ImageLoadResult
+load_file_input(const IoRuntimeService& service, const FileInput& fileInput)
+{
+    const ImageLoadRequest loadRequest = make_file_input_load_request(fileInput);
+    // Keyed before decode so a file rewritten mid-load is never cached under its new identity.
+    const std::string sourceKey = make_image_source_key(loadRequest.path, to_load_attribute_map(loadRequest));
+
+    ImageLoadResult result = load_shared_image_file(service, loadRequest);
+    if (result.success) {
+        result.image.sourceKey = sourceKey;
+    }
+    return result;
+}
+
+static CaptureSampleType
+file_output_capture_sample_type(const FileOutputBinding& fileOutput)
+{
+    const ImageEncodeSettings settings = resolve_image_encode_settings(fileOutput.path, fileOutput.bits);
+    if (!image_encode_accepts_packed_capture(settings)) {
+        return CaptureSampleType::native;
+    }
+    return settings.componentType == ImageComponentType::U8 ? CaptureSampleType::unorm8 : CaptureSampleType::unorm16;
+}
+
+template<typename FileInput>
+static std::vector<ImageLoadResult>
+load_file_inputs(const IoRuntimeService& service, const std::vector<FileInput>& fileInputs)
+{
+    std::vector<ImageLoadResult> results(fileInputs.size());
+    if (fileInputs.size() == 1u) {
+        results[0] = load_file_input(service, fileInputs[0]);
+        return results;
+    }
+
+    // Queued loads reference the caller's inputs, so every submitted load is waited for before returning.
+    std::vector<std::future<ImageLoadResult>> pendingLoads;
+    pendingLoads.reserve(fileInputs.size());
+    for (const FileInput& fileInput : fileInputs) {
+        try {
+            pendingLoads.push_back(
+                service.decodePool().submit([&service, &fileInput]() { return load_file_input(service, fileInput); }));
+        } catch (const std::exception& exception) {
+            results[pendingLoads.size()].errorMessage = exception.what();
+            break;
+        }
+    }
+    for (size_t loadIndex = 0; loadIndex < pendingLoads.size(); ++loadIndex) {
+        try {
+            results[loadIndex] = pendingLoads[loadIndex].get();
+        } catch (const std::exception& exception) {
+            results[loadIndex].errorMessage = exception.what();
+        }
+    }
+    return results;
+}
+
 }  // namespace
 
 IoRuntime::IoRuntime(const IoRuntimeOptions& options)
     : m_options(options)
+    , m_service(std::make_shared<IoRuntimeService>(options))
 {
 }
 
 ImageLoadResult
 IoRuntime::loadImageFile(const ImageLoadRequest& request) const
 {
-    return load_image_file_impl(request);
+    return load_image_file_impl(*m_service, request);
+}
+
+ImageLoadResult
+IoRuntime::loadImageMemory(const ImageMemoryLoadRequest& request) const
+{
+    return load_image_memory_impl(*m_service, request);
+}
+
+IoCacheStats
+IoRuntime::cacheStats() const
+{
+    return m_service->decodeCacheStats();
 }
 
 ImageSaveResult
 IoRuntime::saveImageFile(const ImageSaveRequest& request) const
 {
-    return save_image_file_impl(request);
+    return save_image_file_impl(*m_service, request, request.image);
+}
+
+ImageStreamBeginResult
+IoRuntime::beginImageFileStream(const ImageSaveRequest& request) const
+{
+    return begin_image_file_stream_impl(*m_service, request);
+}
+
+ImageFileStream::ImageFileStream() = default;
+
+ImageFileStream::ImageFileStream(std::unique_ptr<ImageStreamEncoder> encoder)
+    : m_encoder(std::move(encoder))
+{
+}
+
+ImageFileStream::~ImageFileStream() = default;
+
+ImageFileStream::ImageFileStream(ImageFileStream&& other) noexcept = default;
+
+ImageFileStream&
+ImageFileStream::operator=(ImageFileStream&& other) noexcept = default;
+
+ImageSaveResult
+ImageFileStream::writeRows(const HostImageData& rows)
+{
+    ImageSaveResult result;
+    if (!m_encoder) {
+        result.errorMessage = "image stream is not open";
+        return result;
+    }
+
+    try {
+        result.success = m_encoder->writeRows(rows, result.errorMessage);
+    } catch (const std::exception& exception) {
+        result.errorMessage = exception.what();
+    }
+    if (!result.success) {
+        m_encoder.reset();
+    }
+    return result;
+}
+
+ImageSaveResult
+ImageFileStream::finish()
+{
+    ImageSaveResult result;
+    if (!m_encoder) {
+        result.errorMessage = "image stream is not open";
+        return result;
+    }
+
+    try {
+        result.success = m_encoder->finish(result.errorMessage);
+    } catch (const std::exception& exception) {
+        result.errorMessage = exception.what();
+    }
+    m_encoder.reset();
+    return result;
 }
 
 WorkflowMaterializationResult
@@ -909,12 +1189,12 @@ IoRuntime::materializeWorkflow(const Workflow& workflow,
                 result.errorMessage = "file input references an out-of-range pass index";
                 return result;
             }
+        }
 
-            ImageLoadRequest loadRequest;
-            loadRequest.path = fileInput.path;
-            loadRequest.attributes = fileInput.attributes;
-            loadRequest.codecOptions = fileInput.codecOptions;
-            const ImageLoadResult loadResult = loadImageFile(loadRequest);
+        std::vector<ImageLoadResult> loadResults = load_file_inputs(*m_service, fileInputs);
+        for (size_t inputIndex = 0; inputIndex < fileInputs.size(); ++inputIndex) {
+            const FileInputBinding& fileInput = fileInputs[inputIndex];
+            ImageLoadResult& loadResult = loadResults[inputIndex];
             if (!loadResult.success) {
                 result.errorMessage = loadResult.errorMessage.empty() ? "workflow input materialization failed"
                                                                      : loadResult.errorMessage;
@@ -938,7 +1218,7 @@ IoRuntime::materializeWorkflow(const Workflow& workflow,
             input.attributes = fileInput.attributes;
             input.usesArrayElement = fileInput.usesArrayElement;
             input.arrayElement = fileInput.arrayElement;
-            input.hostTexture = std::make_shared<HostImageData>(loadResult.image);
+            input.hostTexture = std::make_shared<HostImageData>(std::move(loadResult.image));
             pass.inputs.push_back(std::move(input));
         }
 
@@ -956,6 +1236,12 @@ IoRuntime::materializeWorkflow(const Workflow& workflow,
                     continue;
                 }
 
+                // Outputs captured for the host or for another file keep one sample type, so conflicts read natively.
+                if (!output.captureToHost) {
+                    output.captureSampleType = file_output_capture_sample_type(fileOutput);
+                } else if (output.captureSampleType != file_output_capture_sample_type(fileOutput)) {
+                    output.captureSampleType = CaptureSampleType::native;
+                }
                 output.captureToHost = true;
                 matchedOutput = true;
                 break;
@@ -970,6 +1256,7 @@ IoRuntime::materializeWorkflow(const Workflow& workflow,
                 output.bits = fileOutput.bits;
                 output.attributes = fileOutput.attributes;
                 output.captureToHost = true;
+                output.captureSampleType = file_output_capture_sample_type(fileOutput);
                 output.usesArrayElement = fileOutput.usesArrayElement;
                 output.arrayElement = fileOutput.arrayElement;
                 pass.outputs.push_back(std::move(output));
@@ -993,12 +1280,10 @@ IoRuntime::materializeRunSettings(const RunRequest& request) const
     result.settings = request.settings;
 
     try {
-        for (const FileInputOverride& fileInput : request.fileInputs) {
-            ImageLoadRequest loadRequest;
-            loadRequest.path = fileInput.path;
-            loadRequest.attributes = fileInput.attributes;
-            loadRequest.codecOptions = fileInput.codecOptions;
-            const ImageLoadResult loadResult = loadImageFile(loadRequest);
+        std::vector<ImageLoadResult> loadResults = load_file_inputs(*m_service, request.fileInputs);
+        for (size_t inputIndex = 0; inputIndex < request.fileInputs.size(); ++inputIndex) {
+            const FileInputOverride& fileInput = request.fileInputs[inputIndex];
+            ImageLoadResult& loadResult = loadResults[inputIndex];
             if (!loadResult.success) {
                 result.errorMessage = loadResult.errorMessage.empty() ? "run settings materialization failed"
                                                                      : loadResult.errorMessage;
@@ -1023,7 +1308,7 @@ IoRuntime::materializeRunSettings(const RunRequest& request) const
             inputOverride.attributes = fileInput.attributes;
             inputOverride.usesArrayElement = fileInput.usesArrayElement;
             inputOverride.arrayElement = fileInput.arrayElement;
-            inputOverride.hostTexture = std::make_shared<HostImageData>(loadResult.image);
+            inputOverride.hostTexture = std::make_shared<HostImageData>(std::move(loadResult.image));
             result.settings.overrides.push_back(std::move(inputOverride));
         }
     } catch (const std::exception& exception) {
@@ -1046,18 +1331,18 @@ IoRuntime::saveCapturedOutput(const OutputSaveBinding& outputSave, const RunResu
         return saveResult;
     }
 
+    // The request carries only save settings; the capture is encoded in place rather than copied into it.
     ImageSaveRequest request;
     request.path         = outputSave.output.path;
     request.alphaChannel = outputSave.output.alphaChannel;
     request.bits         = outputSave.output.bits;
-    request.image        = captureIt->second;
     request.codecOptions = outputSave.output.codecOptions;
     request.attributes.reserve(outputSave.output.attributes.size());
     for (const Attribute& attribute : outputSave.output.attributes) {
         request.attributes.push_back(attribute);
     }
 
-    return saveImageFile(request);
+    return save_image_file_impl(*m_service, request, captureIt->second);
 }
 
 SaveOutputsResult
@@ -1065,17 +1350,38 @@ IoRuntime::saveCapturedOutputs(const std::vector<OutputSaveBinding>& outputSaves
 {
     SaveOutputsResult saveResult;
 
-    for (const OutputSaveBinding& outputSave : outputSaves) {
-        const ImageSaveResult singleSaveResult = saveCapturedOutput(outputSave, result);
+    std::vector<ImageSaveResult> singleSaveResults(outputSaves.size());
+    if (outputSaves.size() == 1u) {
+        singleSaveResults[0] = saveCapturedOutput(outputSaves[0], result);
+    } else {
+        std::vector<std::future<ImageSaveResult>> pendingSaves;
+        pendingSaves.reserve(outputSaves.size());
+        for (const OutputSaveBinding& outputSave : outputSaves) {
+            pendingSaves.push_back(m_service->encodePool().submit(
+                [this, &outputSave, &result]() { return saveCapturedOutput(outputSave, result); }));
+        }
+        for (size_t saveIndex = 0; saveIndex < pendingSaves.size(); ++saveIndex) {
+            try {
+                singleSaveResults[saveIndex] = pendingSaves[saveIndex].get();
+            } catch (const std::exception& exception) {
+                singleSaveResults[saveIndex].errorMessage = exception.what();
+            }
+        }
+    }
+
+    for (const ImageSaveResult& singleSaveResult : singleSaveResults) {
         if (!singleSaveResult.success) {
-            saveResult.errorMessage = singleSaveResult.errorMessage;
-            return saveResult;
+            if (saveResult.errorMessage.empty()) {
+                saveResult.errorMessage = singleSaveResult.errorMessage.empty() ? "captured output save failed"
+                                                                                : singleSaveResult.errorMessage;
+            }
+            continue;
         }
 
         ++saveResult.savedCount;
     }
 
-    saveResult.success = true;
+    saveResult.success = saveResult.errorMessage.empty();
     return saveResult;
 }
 
@@ -1085,12 +1391,322 @@ LoadImageFile(const ImageLoadRequest& request)
     return IoRuntime().loadImageFile(request);
 }
 
+ImageLoadResult
+LoadImageMemory(const ImageMemoryLoadRequest& request)
+{
+    return IoRuntime().loadImageMemory(request);
+}
+
 ImageSaveResult
 SaveImageFile(const ImageSaveRequest& request)
 {
     return IoRuntime().saveImageFile(request);
 }
 
+std::vector<ImageTileRegion>
+PlanImageTiles(const int width, const int height, const int tileWidth, const int tileHeight)
+{
+    std::vector<ImageTileRegion> result;
+    if (width <= 0 || height <= 0 || tileWidth <= 0 || tileHeight <= 0) {
+        return result;
+    }
+
+    for (int y = 0; y < height; y += tileHeight) {
+        for (int x = 0; x < width; x += tileWidth) {
+            result.push_back(ImageTileRegion { x, y, std::min(tileWidth, width - x), std::min(tileHeight, height - y) });
+        }
+    }
+    return result;
+}
+
+HostImageData
+ExtractImageTile(const HostImageData& source, const int x, const int y, const int width, const int height)
+{
+    const size_t pixelSize = host_image_pixel_size(source);
+    if (pixelSize == 0u || width <= 0 || height <= 0) {
+        return HostImageData {};
+    }
+
+    HostImageData tile;
+    tile.width = width;
+    tile.height = height;
+    tile.channels = source.channels;
+    tile.alphaChannel = source.alphaChannel;
+    tile.glInternalFormat = source.glInternalFormat;
+    tile.glType = source.glType;
+    tile.bytes.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * pixelSize);
+
+    const std::span<const std::byte> sourceBytes = source.pixelBytes();
+    const size_t sourceRowSize = static_cast<size_t>(source.width) * pixelSize;
+    const int innerBegin = std::clamp(-x, 0, width);
+    const int innerEnd = std::clamp(source.width - x, innerBegin, width);
+    for (int row = 0; row < height; ++row) {
+        const int sourceY = std::clamp(y + row, 0, source.height - 1);
+        const std::byte* sourceRow = sourceBytes.data() + static_cast<size_t>(sourceY) * sourceRowSize;
+        std::byte* tileRow = tile.bytes.data() + static_cast<size_t>(row) * static_cast<size_t>(width) * pixelSize;
+
+        for (int column = 0; column < innerBegin; ++column) {
+            std::memcpy(tileRow + static_cast<size_t>(column) * pixelSize, sourceRow, pixelSize);
+        }
+        if (innerEnd > innerBegin) {
+            std::memcpy(tileRow + static_cast<size_t>(innerBegin) * pixelSize,
+                        sourceRow + static_cast<size_t>(x + innerBegin) * pixelSize,
+                        static_cast<size_t>(innerEnd - innerBegin) * pixelSize);
+        }
+        const std::byte* lastPixel = sourceRow + sourceRowSize - pixelSize;
+        for (int column = innerEnd; column < width; ++column) {
+            std::memcpy(tileRow + static_cast<size_t>(column) * pixelSize, lastPixel, pixelSize);
+        }
+    }
+    return tile;
+}
+
+bool
+StitchImageTile(HostImageData& target,
+                const HostImageData& tile,
+                const ImageTileRegion& region,
+                const int halo,
+                std::string& errorMessage)
+{
+    const size_t pixelSize = host_image_pixel_size(tile);
+    if (pixelSize == 0u) {
+        errorMessage = "tile output has no pixel data";
+        return false;
+    }
+    if (halo < 0 || region.x < 0 || region.y < 0 || region.x + region.width > target.width
+        || region.y + region.height > target.height || halo + region.width > tile.width
+        || halo + region.height > tile.height) {
+        errorMessage = "tile region does not fit the stitched image";
+        return false;
+    }
+
+    if (target.bytes.empty()) {
+        target.channels = tile.channels;
+        target.alphaChannel = tile.alphaChannel;
+        target.glInternalFormat = tile.glInternalFormat;
+        target.glType = tile.glType;
+        target.bytes.resize(static_cast<size_t>(target.width) * static_cast<size_t>(target.height) * pixelSize);
+    } else if (target.glInternalFormat != tile.glInternalFormat || target.glType != tile.glType
+               || target.channels != tile.channels) {
+        errorMessage = "tile output format differs from the stitched image";
+        return false;
+    }
+
+    const std::span<const std::byte> tileBytes = tile.pixelBytes();
+    const size_t rowBytes = static_cast<size_t>(region.width) * pixelSize;
+    for (int row = 0; row < region.height; ++row) {
+        const size_t tileOffset =
+            (static_cast<size_t>(halo + row) * static_cast<size_t>(tile.width) + static_cast<size_t>(halo)) * pixelSize;
+        const size_t targetOffset = (static_cast<size_t>(region.y + row) * static_cast<size_t>(target.width)
+                                     + static_cast<size_t>(region.x))
+                                    * pixelSize;
+        std::memcpy(target.bytes.data() + targetOffset, tileBytes.data() + tileOffset, rowBytes);
+    }
+    return true;
+}
+
+TiledRunResult
+IoRuntime::runTiledWith(const Workflow& workflow,
+                        const TiledRunRequest& request,
+                        const std::function<bool(const Workflow&, std::string&)>& prepareTiles,
+                        const std::function<RunResult(const RunSettings&)>& runTile) const
+{
+    TiledRunResult result;
+    if (request.tileWidth <= 0 || request.tileHeight <= 0 || request.halo < 0) {
+        result.errorMessage = "tiled run requires a positive tile size and a non-negative halo";
+        return result;
+    }
+    if (request.input.passIndex >= workflow.passes.size()) {
+        result.errorMessage = "tiled run input references an out-of-range pass index";
+        return result;
+    }
+    if (!request.tileInfoInputName.empty()) {
+        const bool declared = std::any_of(workflow.passes.begin(), workflow.passes.end(), [&](const Pass& pass) {
+            return std::any_of(pass.inputs.begin(), pass.inputs.end(), [&](const InputBinding& input) {
+                return input.name == request.tileInfoInputName;
+            });
+        });
+        if (!declared) {
+            result.errorMessage =
+                "tiled run tile info input '" + request.tileInfoInputName + "' is not declared by any pass";
+            return result;
+        }
+    }
+
+    ImageLoadRequest loadRequest;
+    loadRequest.path = request.input.path;
+    loadRequest.attributes = request.input.attributes;
+    loadRequest.codecOptions = request.input.codecOptions;
+    const ImageLoadResult source = loadImageFile(loadRequest);
+    if (!source.success) {
+        result.errorMessage = source.errorMessage.empty() ? "tiled run input load failed" : source.errorMessage;
+        return result;
+    }
+
+    for (size_t passIndex = 0; passIndex < workflow.passes.size(); ++passIndex) {
+        const Pass& pass = workflow.passes[passIndex];
+        if (pass.sizeX != source.image.width || pass.sizeY != source.image.height) {
+            result.errorMessage = "tiled run requires every pass to match the source image size: pass "
+                                  + std::to_string(passIndex) + " is " + std::to_string(pass.sizeX) + "x"
+                                  + std::to_string(pass.sizeY) + ", source is " + std::to_string(source.image.width)
+                                  + "x" + std::to_string(source.image.height);
+            return result;
+        }
+    }
+
+    const std::vector<ImageTileRegion> tiles =
+        PlanImageTiles(source.image.width, source.image.height, request.tileWidth, request.tileHeight);
+    if (tiles.empty()) {
+        result.errorMessage = "tiled run input image is empty";
+        return result;
+    }
+
+    const int paddedWidth = std::min(request.tileWidth, source.image.width) + request.halo * 2;
+    const int paddedHeight = std::min(request.tileHeight, source.image.height) + request.halo * 2;
+    const auto makeTile = [&](const ImageTileRegion& region) {
+        return std::make_shared<HostImageData>(ExtractImageTile(
+            source.image, region.x - request.halo, region.y - request.halo, paddedWidth, paddedHeight));
+    };
+
+    Workflow tiledWorkflow = workflow;
+    for (Pass& pass : tiledWorkflow.passes) {
+        pass.sizeX = paddedWidth;
+        pass.sizeY = paddedHeight;
+    }
+
+    WorkflowMaterializationResult materialized = materializeWorkflow(tiledWorkflow, {}, { request.output });
+    if (!materialized.success) {
+        result.errorMessage =
+            materialized.errorMessage.empty() ? "workflow materialization failed" : materialized.errorMessage;
+        return result;
+    }
+
+    InputBinding tileInput;
+    tileInput.name = request.input.name;
+    tileInput.sourceKind = InputSourceKind::hostTexture;
+    tileInput.attributes = request.input.attributes;
+    tileInput.usesArrayElement = request.input.usesArrayElement;
+    tileInput.arrayElement = request.input.arrayElement;
+    tileInput.hostTexture = makeTile(tiles.front());
+    if (tileInput.hostTexture->bytes.empty()) {
+        result.errorMessage = "tiled run input image has no pixel data";
+        return result;
+    }
+    materialized.workflow.passes[request.input.passIndex].inputs.push_back(tileInput);
+
+    if (!prepareTiles(materialized.workflow, result.errorMessage)) {
+        return result;
+    }
+
+    std::string captureKey = request.output.name;
+    if (request.output.usesArrayElement) {
+        captureKey += "[" + std::to_string(request.output.arrayElement) + "]";
+    }
+    captureKey += "::" + std::to_string(request.output.passIndex);
+
+    // Each finished row of tiles is stitched into a band and streamed to the output file, so the full-size result
+    // never has to fit in host memory.
+    ImageFileStream outputStream;
+    HostImageData band;
+    for (size_t tileIndex = 0; tileIndex < tiles.size(); ++tileIndex) {
+        const ImageTileRegion& region = tiles[tileIndex];
+        if (region.x == 0) {
+            band = HostImageData {};
+            band.width = source.image.width;
+            band.height = region.height;
+        }
+
+        RunSettings settings = request.settings;
+        if (tileIndex > 0u) {
+            InputOverride tileOverride = HostTextureOverride(
+                request.input.passIndex, request.input.name, makeTile(region), request.input.attributes);
+            tileOverride.usesArrayElement = request.input.usesArrayElement;
+            tileOverride.arrayElement = request.input.arrayElement;
+            settings.overrides.push_back(std::move(tileOverride));
+        }
+        if (!request.tileInfoInputName.empty()) {
+            for (size_t passIndex = 0; passIndex < workflow.passes.size(); ++passIndex) {
+                for (const InputBinding& input : workflow.passes[passIndex].inputs) {
+                    if (input.name != request.tileInfoInputName) {
+                        continue;
+                    }
+                    InputOverride tileInfo;
+                    tileInfo.passIndex = passIndex;
+                    tileInfo.name = request.tileInfoInputName;
+                    tileInfo.sourceKind = InputSourceKind::intValues;
+                    tileInfo.intValues = { region.x - request.halo,
+                                           region.y - request.halo,
+                                           source.image.width,
+                                           source.image.height };
+                    settings.overrides.push_back(std::move(tileInfo));
+                    break;
+                }
+            }
+        }
+
+        const RunResult runResult = runTile(settings);
+        if (!runResult.success) {
+            result.errorMessage = runResult.errorMessage.empty() ? "tiled run failed" : runResult.errorMessage;
+            return result;
+        }
+
+        const auto captureIt = runResult.capturedOutputs.find(captureKey);
+        if (captureIt == runResult.capturedOutputs.end()) {
+            result.errorMessage = "captured output not found for tiled run";
+            return result;
+        }
+        const ImageTileRegion bandRegion { region.x, 0, region.width, region.height };
+        if (!StitchImageTile(band, captureIt->second, bandRegion, request.halo, result.errorMessage)) {
+            return result;
+        }
+        ++result.tileCount;
+
+        const bool bandComplete = tileIndex + 1u == tiles.size() || tiles[tileIndex + 1u].y != region.y;
+        if (!bandComplete) {
+            continue;
+        }
+        if (region.y == 0) {
+            ImageSaveRequest saveRequest;
+            saveRequest.path = request.output.path;
+            saveRequest.attributes = request.output.attributes;
+            saveRequest.codecOptions = request.output.codecOptions;
+            saveRequest.alphaChannel = request.output.alphaChannel;
+            saveRequest.bits = request.output.bits;
+            saveRequest.image.width = source.image.width;
+            saveRequest.image.height = source.image.height;
+            saveRequest.image.channels = band.channels;
+            saveRequest.image.alphaChannel = band.alphaChannel;
+            saveRequest.image.glInternalFormat = band.glInternalFormat;
+            saveRequest.image.glType = band.glType;
+            ImageStreamBeginResult streamResult = beginImageFileStream(saveRequest);
+            if (!streamResult.success) {
+                result.errorMessage =
+                    streamResult.errorMessage.empty() ? "tiled output save failed" : streamResult.errorMessage;
+                return result;
+            }
+            outputStream = std::move(streamResult.stream);
+        }
+
+        const ImageSaveResult bandResult = outputStream.writeRows(band);
+        if (!bandResult.success) {
+            result.errorMessage =
+                bandResult.errorMessage.empty() ? "tiled output save failed" : bandResult.errorMessage;
+            return result;
+        }
+    }
+
+    const ImageSaveResult saveResult = outputStream.finish();
+    if (!saveResult.success) {
+        result.errorMessage = saveResult.errorMessage.empty() ? "tiled output save failed" : saveResult.errorMessage;
+        return result;
+    }
+
+    result.width = source.image.width;
+    result.height = source.image.height;
+    result.success = true;
+    return result;
+}
+
 ImageIoCapabilities
 GetImageIoCapabilities()
 {
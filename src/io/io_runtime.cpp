@@ -3,31 +3,158 @@
 
 #include "io_runtime.h"
 
+#include "image_backend.h"
+
+#include <filesystem>
+#include <sstream>
+
 namespace rawgl::io {
+namespace {
+
+class ActiveIoWork {
+public:
+    explicit ActiveIoWork(std::atomic<size_t>& counter)
+        : m_counter(counter)
+        , m_count(counter.fetch_add(1u) + 1u)
+    {
+    }
+
+    ~ActiveIoWork() { m_counter.fetch_sub(1u); }
+
+    ActiveIoWork(const ActiveIoWork&) = delete;
+    ActiveIoWork& operator=(const ActiveIoWork&) = delete;
+
+    size_t count() const { return m_count; }
+
+private:
+    std::atomic<size_t>& m_counter;
+    size_t m_count = 1u;
+};
+
+}  // namespace
 
 IoRuntimeService::IoRuntimeService(const IoRuntimeOptions& options)
     : m_options(options)
+    , m_decodePool(std::make_unique<IoWorkerPool>(options.decodeWorkerCount))
+    , m_encodePool(std::make_unique<IoWorkerPool>(options.encodeWorkerCount))
+{
+    if (options.decodeCacheBudgetBytes > 0u) {
+        m_decodeCache = std::make_unique<DecodedImageCache>(options.decodeCacheBudgetBytes);
+    }
+}
+
+IoRuntimeService::~IoRuntimeService() = default;
+
+std::shared_ptr<const DecodedImageData>
+IoRuntimeService::decodeImageFile(const std::string& path, const std::map<std::string, std::string>& attributes) const
+{
+    // Keyed before decode so a file rewritten mid-load is never cached under its new identity.
+    const std::string cacheKey = m_decodeCache ? make_image_source_key(path, attributes) : std::string();
+    if (!cacheKey.empty()) {
+        std::shared_ptr<const DecodedImageData> cached = m_decodeCache->find(cacheKey);
+        if (cached) {
+            return cached;
+        }
+    }
+
+    const ActiveIoWork activeDecode(m_activeDecodes);
+    std::shared_ptr<const DecodedImageData> decoded = std::make_shared<const DecodedImageData>(
+        decode_image_file(path, withDecodeThreads(attributes, activeDecode.count())));
+    if (!cacheKey.empty() && decoded->success) {
+        m_decodeCache->insert(cacheKey, decoded);
+    }
+    return decoded;
+}
+
+DecodedImageData
+IoRuntimeService::decodeImageMemory(std::span<const std::byte> bytes,
+                                    const std::string& nameHint,
+                                    const std::map<std::string, std::string>& attributes) const
 {
+    const ActiveIoWork activeDecode(m_activeDecodes);
+    return decode_image_memory(bytes, nameHint, withDecodeThreads(attributes, activeDecode.count()));
+}
+
+std::map<std::string, std::string>
+IoRuntimeService::withDecodeThreads(const std::map<std::string, std::string>& attributes,
+                                    const size_t activeDecodes) const
+{
+    std::map<std::string, std::string> decodeAttributes = attributes;
+    decodeAttributes.emplace(
+        "rawgl:decode_threads",
+        std::to_string(resolve_io_threads_per_image(m_options.decodeThreadsPerImage, activeDecodes)));
+    return decodeAttributes;
+}
+
+IoCacheStats
+IoRuntimeService::decodeCacheStats() const
+{
+    return m_decodeCache ? m_decodeCache->stats() : IoCacheStats {};
 }
 
 LoadedTextureData
 IoRuntimeService::loadTextureFileData(const std::string& path,
                                       const std::map<std::string, std::string>& attributes) const
 {
-    return rawgl::io::load_texture_file_data(path, attributes);
+    return make_loaded_texture_data(decodeImageFile(path, attributes));
 }
 
 HostImageData
 IoRuntimeService::loadHostImageData(const std::string& path,
                                     const std::map<std::string, std::string>& attributes) const
 {
-    return rawgl::io::load_host_image_data(path, attributes);
+    return to_host_image_data(loadTextureFileData(path, attributes));
 }
 
 bool
 IoRuntimeService::saveImageOutput(const OutputWriteRequest& request, std::string& errorMessage) const
 {
-    return rawgl::io::save_image_output(request, errorMessage);
+    const ActiveIoWork activeEncode(m_activeEncodes);
+    return rawgl::io::save_image_output(withEncodeThreads(request, activeEncode.count()), errorMessage);
+}
+
+std::unique_ptr<ImageStreamEncoder>
+IoRuntimeService::beginImageOutputStream(const OutputWriteRequest& request, std::string& errorMessage) const
+{
+    // A stream outlives this call, so its share is sized from the saves running when it starts.
+    const ActiveIoWork activeEncode(m_activeEncodes);
+    return rawgl::io::begin_image_output_stream(withEncodeThreads(request, activeEncode.count()), errorMessage);
+}
+
+OutputWriteRequest
+IoRuntimeService::withEncodeThreads(const OutputWriteRequest& request, const size_t activeEncodes) const
+{
+    OutputWriteRequest encodeRequest = request;
+    encodeRequest.attributes.emplace(
+        "rawgl:encode_threads",
+        std::to_string(resolve_io_threads_per_image(m_options.encodeThreadsPerImage, activeEncodes)));
+    return encodeRequest;
+}
+
+std::string
+make_image_source_key(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    std::error_code error;
+    const std::filesystem::path canonicalPath = std::filesystem::canonical(path, error);
+    if (error) {
+        return std::string();
+    }
+    const std::uintmax_t fileSize = std::filesystem::file_size(canonicalPath, error);
+    if (error) {
+        return std::string();
+    }
+    const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(canonicalPath, error);
+    if (error) {
+        return std::string();
+    }
+
+    std::ostringstream stream;
+    stream << "file:" << canonicalPath.string();
+    for (const auto& attribute : attributes) {
+        stream << '\x1F' << attribute.first << '=' << attribute.second;
+    }
+    stream << '\x1F' << "size=" << fileSize << '\x1F' << "mtime=" << writeTime.time_since_epoch().count();
+    return stream.str();
 }
 
 }  // namespace rawgl::io
@@ -4,17 +4,45 @@
 #pragma once
 
 #include "rawgl/rawgl_io.h"
+#include "decoded_image_cache.h"
+#include "io_worker_pool.h"
 #include "output_writer.h"
 #include "texture_loader.h"
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+
 namespace rawgl::io {
 
 class IoRuntimeService {
 public:
     explicit IoRuntimeService(const IoRuntimeOptions& options = {});
+    ~IoRuntimeService();
+
+    IoRuntimeService(const IoRuntimeService&) = delete;
+    IoRuntimeService& operator=(const IoRuntimeService&) = delete;
 
     const IoRuntimeOptions& options() const { return m_options; }
 
+    /// Bounded pool used for file decode work, sized from `decodeWorkerCount`.
+    IoWorkerPool& decodePool() const { return *m_decodePool; }
+    /// Bounded pool used for file encode work, sized from `encodeWorkerCount`.
+    IoWorkerPool& encodePool() const { return *m_encodePool; }
+
+    /// Decodes one file, serving repeated loads of an unchanged file from the decoded-image cache.
+    std::shared_ptr<const DecodedImageData> decodeImageFile(const std::string& path,
+                                                            const std::map<std::string, std::string>& attributes) const;
+
+    /// Decodes one in-memory encoded image with the native codecs; the decoded-image cache is not consulted.
+    DecodedImageData decodeImageMemory(std::span<const std::byte> bytes,
+                                       const std::string& nameHint,
+                                       const std::map<std::string, std::string>& attributes) const;
+
+    IoCacheStats decodeCacheStats() const;
+
     LoadedTextureData loadTextureFileData(const std::string& path,
                                           const std::map<std::string, std::string>& attributes) const;
 
@@ -23,8 +51,29 @@ public:
 
     bool saveImageOutput(const OutputWriteRequest& request, std::string& errorMessage) const;
 
+    /// Starts a row-band save with the same per-image encode threads as \ref saveImageOutput.
+    std::unique_ptr<ImageStreamEncoder> beginImageOutputStream(const OutputWriteRequest& request,
+                                                               std::string& errorMessage) const;
+
 private:
+    std::map<std::string, std::string> withDecodeThreads(const std::map<std::string, std::string>& attributes,
+                                                         size_t activeDecodes) const;
+    OutputWriteRequest withEncodeThreads(const OutputWriteRequest& request, size_t activeEncodes) const;
+
     IoRuntimeOptions m_options;
+    std::unique_ptr<IoWorkerPool> m_decodePool;
+    std::unique_ptr<IoWorkerPool> m_encodePool;
+    std::unique_ptr<DecodedImageCache> m_decodeCache;
+    /// Decodes currently running through this service; their count sizes each decode's share of the cores.
+    mutable std::atomic<size_t> m_activeDecodes { 0 };
+    /// Saves and row-band streams currently being started or written, counted the same way as decodes.
+    mutable std::atomic<size_t> m_activeEncodes { 0 };
 };
 
+/// Builds a content key for a decoded file from its canonical path, load attributes, size, and write time.
+///
+/// Returns an empty string when the file cannot be inspected.
+std::string
+make_image_source_key(const std::string& path, const std::map<std::string, std::string>& attributes);
+
 }  // namespace rawgl::io
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#include "io_worker_pool.h"
+
+#include <algorithm>
+
+namespace rawgl::io {
+namespace {
+
+thread_local const IoWorkerPool* t_currentWorkerPool = nullptr;
+
+}  // namespace
+
+size_t
+resolve_io_worker_count(const int requestedCount)
+{
+    if (requestedCount > 0) {
+        return static_cast<size_t>(requestedCount);
+    }
+
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 0 ? static_cast<size_t>(hardwareThreads) : 1u;
+}
+
+size_t
+resolve_io_threads_per_image(const int requestedCount, const size_t activeImageCount)
+{
+    if (requestedCount > 0) {
+        return static_cast<size_t>(requestedCount);
+    }
+    return std::max<size_t>(1u, resolve_io_worker_count(0) / std::max<size_t>(1u, activeImageCount));
+}
+
+IoWorkerPool::IoWorkerPool(const int workerCount)
+    : m_workerCount(resolve_io_worker_count(workerCount))
+{
+}
+
+IoWorkerPool::~IoWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool
+IoWorkerPool::isWorkerThread() const
+{
+    return t_currentWorkerPool == this;
+}
+
+void
+IoWorkerPool::enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+
+        // Grow by one worker per submission until the configured bound is reached.
+        if (m_workers.size() < m_workerCount) {
+            m_workers.emplace_back(&IoWorkerPool::workerMain, this);
+        }
+    }
+    m_condition.notify_one();
+}
+
+void
+IoWorkerPool::workerMain()
+{
+    t_currentWorkerPool = this;
+
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                break;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        job();
+    }
+
+    t_currentWorkerPool = nullptr;
+}
+
+}  // namespace rawgl::io
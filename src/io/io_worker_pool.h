@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rawgl::io {
+
+/// Fixed-size worker pool for CPU-side image decode and encode work.
+///
+/// Worker threads are started on the first submission so idle runtimes do not
+/// hold threads. Submissions issued from one of the pool's own workers run
+/// inline to avoid self-deadlock when a task waits on nested work.
+class IoWorkerPool {
+public:
+    explicit IoWorkerPool(int workerCount);
+    ~IoWorkerPool();
+
+    IoWorkerPool(const IoWorkerPool&) = delete;
+    IoWorkerPool& operator=(const IoWorkerPool&) = delete;
+
+    size_t workerCount() const { return m_workerCount; }
+
+    template<typename Function>
+    std::future<std::invoke_result_t<std::decay_t<Function>>>
+    submit(Function&& function)
+    {
+        using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> future = task->get_future();
+        if (isWorkerThread()) {
+            (*task)();
+            return future;
+        }
+
+        enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+private:
+    bool isWorkerThread() const;
+    void enqueue(std::function<void()> job);
+    void workerMain();
+
+    size_t m_workerCount = 1;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_jobs;
+    std::vector<std::thread> m_workers;
+    bool m_stopping = false;
+};
+
+/// Resolves a configured worker count, treating values <= 0 as "one per hardware thread".
+size_t
+resolve_io_worker_count(int requestedCount);
+
+/// Resolves the threads one image may use while `activeImageCount` images, itself included, are processed at once.
+///
+/// Values > 0 are used as given. Values <= 0 split the hardware threads evenly between the active images, so a lone
+/// large image gets every core and a busy pool falls back towards one thread per image.
+size_t
+resolve_io_threads_per_image(int requestedCount, size_t activeImageCount);
+
+}  // namespace rawgl::io
@@ -4,9 +4,11 @@
 #include "jpeg2000_backend.h"
 
 #include "gl_utils.h"
+#include "mapped_file.h"
 #include "path_utils.h"
 
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <cctype>
 #include <cmath>
@@ -78,6 +80,20 @@ parse_positive_float_text(const std::string& text, float& value)
     return true;
 }
 
+static bool
+parse_u32_list_text(const std::string& text, std::array<uint32_t, 4>& values)
+{
+    size_t start = 0u;
+    for (size_t index = 0; index < values.size(); ++index) {
+        const size_t end = index + 1u < values.size() ? text.find(',', start) : text.size();
+        if (end == std::string::npos || end == start || !parse_u32_text(text.substr(start, end - start), values[index])) {
+            return false;
+        }
+        start = end + 1u;
+    }
+    return start == text.size() + 1u;
+}
+
 static const std::string*
 find_attribute_value(const std::map<std::string, std::string>& attributes, const char* firstKey, const char* secondKey)
 {
@@ -133,22 +149,22 @@ read_source_sample_as_unit_float(const HostImageData& image, const size_t sample
 
     switch (image.glType) {
     case GL_UNSIGNED_BYTE: {
-        const uint8_t value = reinterpret_cast<const uint8_t*>(image.bytes.data())[sampleIndex];
+        const uint8_t value = reinterpret_cast<const uint8_t*>(image.pixelBytes().data())[sampleIndex];
         return static_cast<float>(value) / 255.0f;
     }
     case GL_UNSIGNED_SHORT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return static_cast<float>(value) / 65535.0f;
     }
     case GL_FLOAT: {
         float value = 0.0f;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(float), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(float), sizeof(value));
         return value;
     }
     case GL_HALF_FLOAT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return half_to_float(value);
     }
     default: break;
@@ -185,8 +201,13 @@ struct OpenJpegMessageState {
 };
 
 struct Jpeg2000LoadSettings {
+    bool hasReduceFactor = false;
     uint32_t reduceFactor = 0;
     uint32_t layerLimit = 0;
+    uint32_t decodeScaleLog2 = 0;
+    uint32_t threadCount = 0;
+    bool hasRegion = false;
+    std::array<uint32_t, 4> region = { 0, 0, 0, 0 };
 };
 
 struct Jpeg2000SaveSettings {
@@ -195,6 +216,7 @@ struct Jpeg2000SaveSettings {
     float compressionRatio = 0.0f;
     bool hasQuality = false;
     float quality = 0.0f;
+    uint32_t threadCount = 0;
 };
 
 static void
@@ -231,6 +253,59 @@ resolve_openjpeg_codec_format(const std::string& path)
     return OPJ_CODEC_JP2;
 }
 
+static OPJ_CODEC_FORMAT
+detect_openjpeg_codec_format(const std::span<const std::byte> bytes)
+{
+    // A raw codestream starts with SOC followed by SIZ; everything else is treated as a JP2 container.
+    static constexpr std::array<uint8_t, 4> kCodestreamSignature = { 0xffu, 0x4fu, 0xffu, 0x51u };
+    if (bytes.size() >= kCodestreamSignature.size()
+        && std::memcmp(bytes.data(), kCodestreamSignature.data(), kCodestreamSignature.size()) == 0) {
+        return OPJ_CODEC_J2K;
+    }
+    return OPJ_CODEC_JP2;
+}
+
+static OPJ_SIZE_T
+openjpeg_memory_read(void* destination, OPJ_SIZE_T byteCount, void* userData)
+{
+    MemoryInputCursor& cursor = *static_cast<MemoryInputCursor*>(userData);
+    const size_t copied = cursor.read(destination, static_cast<size_t>(byteCount));
+    return copied == 0u && byteCount > 0u ? static_cast<OPJ_SIZE_T>(-1) : static_cast<OPJ_SIZE_T>(copied);
+}
+
+static OPJ_OFF_T
+openjpeg_memory_skip(OPJ_OFF_T byteCount, void* userData)
+{
+    MemoryInputCursor& cursor = *static_cast<MemoryInputCursor*>(userData);
+    const int64_t target = static_cast<int64_t>(cursor.position) + byteCount;
+    if (target < 0 || !cursor.seek(static_cast<uint64_t>(target))) {
+        return -1;
+    }
+    return byteCount;
+}
+
+static OPJ_BOOL
+openjpeg_memory_seek(OPJ_OFF_T offset, void* userData)
+{
+    MemoryInputCursor& cursor = *static_cast<MemoryInputCursor*>(userData);
+    return offset >= 0 && cursor.seek(static_cast<uint64_t>(offset)) ? OPJ_TRUE : OPJ_FALSE;
+}
+
+static opj_stream_t*
+create_openjpeg_memory_stream(MemoryInputCursor& cursor)
+{
+    opj_stream_t* stream = opj_stream_create(OPJ_J2K_STREAM_CHUNK_SIZE, OPJ_TRUE);
+    if (stream == nullptr) {
+        return nullptr;
+    }
+    opj_stream_set_read_function(stream, openjpeg_memory_read);
+    opj_stream_set_skip_function(stream, openjpeg_memory_skip);
+    opj_stream_set_seek_function(stream, openjpeg_memory_seek);
+    opj_stream_set_user_data(stream, &cursor, nullptr);
+    opj_stream_set_user_data_length(stream, static_cast<OPJ_UINT64>(cursor.bytes.size()));
+    return stream;
+}
+
 static bool
 parse_jpeg2000_load_settings(const std::map<std::string, std::string>& attributes,
                              Jpeg2000LoadSettings& settings,
@@ -241,6 +316,7 @@ parse_jpeg2000_load_settings(const std::map<std::string, std::string>& attribute
         errorMessage = "invalid JPEG-2000 reduce factor";
         return false;
     }
+    settings.hasReduceFactor = reduce != nullptr;
 
     const std::string* layer = find_attribute_value(attributes, "jpeg2000:layer_limit", "jpeg2000:layers");
     if (layer != nullptr && !parse_u32_text(*layer, settings.layerLimit)) {
@@ -248,9 +324,66 @@ parse_jpeg2000_load_settings(const std::map<std::string, std::string>& attribute
         return false;
     }
 
+    const std::string* threads = find_attribute_value(attributes, "jpeg2000:threads", "rawgl:decode_threads");
+    if (threads != nullptr && !parse_u32_text(*threads, settings.threadCount)) {
+        errorMessage = "invalid JPEG-2000 decode thread count";
+        return false;
+    }
+
+    const std::string* region = find_attribute_value(attributes, "jpeg2000:region", nullptr);
+    if (region != nullptr) {
+        if (!parse_u32_list_text(*region, settings.region) || settings.region[2] == 0u || settings.region[3] == 0u) {
+            errorMessage = "invalid JPEG-2000 decode region; expected x,y,width,height";
+            return false;
+        }
+        settings.hasRegion = true;
+    }
+
+    return parse_image_decode_scale(attributes, settings.decodeScaleLog2, errorMessage);
+}
+
+static bool
+apply_openjpeg_decode_region(opj_codec_t* codec,
+                             opj_image_t* image,
+                             const Jpeg2000LoadSettings& settings,
+                             std::string& errorMessage)
+{
+    // The region is given in full-resolution pixels relative to the image origin.
+    const uint64_t imageWidth = static_cast<uint64_t>(image->x1) - image->x0;
+    const uint64_t imageHeight = static_cast<uint64_t>(image->y1) - image->y0;
+    const uint64_t x1 = static_cast<uint64_t>(settings.region[0]) + settings.region[2];
+    const uint64_t y1 = static_cast<uint64_t>(settings.region[1]) + settings.region[3];
+    if (x1 > imageWidth || y1 > imageHeight) {
+        errorMessage = "JPEG-2000 decode region is outside the image";
+        return false;
+    }
+
+    if (!opj_set_decode_area(codec,
+                             image,
+                             static_cast<OPJ_INT32>(image->x0 + settings.region[0]),
+                             static_cast<OPJ_INT32>(image->y0 + settings.region[1]),
+                             static_cast<OPJ_INT32>(image->x0 + x1),
+                             static_cast<OPJ_INT32>(image->y0 + y1))) {
+        if (errorMessage.empty()) {
+            errorMessage = "OpenJPEG rejected the decode region";
+        }
+        return false;
+    }
     return true;
 }
 
+static uint32_t
+resolve_openjpeg_decode_scale_reduce(opj_codec_t* codec, const uint32_t scaleLog2)
+{
+    opj_codestream_info_v2_t* info = opj_get_cstr_info(codec);
+    uint32_t resolutionCount = 1u;
+    if (info != nullptr && info->m_default_tile_info.tccp_info != nullptr) {
+        resolutionCount = std::max<uint32_t>(info->m_default_tile_info.tccp_info[0].numresolutions, 1u);
+    }
+    opj_destroy_cstr_info(&info);
+    return std::min(scaleLog2, resolutionCount - 1u);
+}
+
 static bool
 parse_jpeg2000_save_settings(const std::map<std::string, std::string>& attributes,
                              Jpeg2000SaveSettings& settings,
@@ -289,6 +422,12 @@ parse_jpeg2000_save_settings(const std::map<std::string, std::string>& attribute
         return false;
     }
 
+    const std::string* threads = find_attribute_value(attributes, "jpeg2000:threads", "rawgl:encode_threads");
+    if (threads != nullptr && !parse_u32_text(*threads, settings.threadCount)) {
+        errorMessage = "invalid JPEG-2000 encode thread count";
+        return false;
+    }
+
     return true;
 }
 
@@ -409,10 +548,10 @@ fill_openjpeg_image_component_data(opj_image_t* image,
                 pixelIndex * static_cast<size_t>(source.channels) + static_cast<size_t>(channel);
             uint32_t sample = 0u;
             if (source.glType == GL_UNSIGNED_BYTE && componentType == ImageComponentType::U8) {
-                sample = reinterpret_cast<const uint8_t*>(source.bytes.data())[sourceSampleIndex];
+                sample = reinterpret_cast<const uint8_t*>(source.pixelBytes().data())[sourceSampleIndex];
             } else if (source.glType == GL_UNSIGNED_SHORT && componentType == ImageComponentType::U16) {
                 uint16_t value = 0u;
-                std::memcpy(&value, source.bytes.data() + sourceSampleIndex * sizeof(uint16_t), sizeof(value));
+                std::memcpy(&value, source.pixelBytes().data() + sourceSampleIndex * sizeof(uint16_t), sizeof(value));
                 sample = value;
             } else {
                 bool supported = false;
@@ -530,11 +669,23 @@ configure_openjpeg_encoder(opj_cparameters_t& parameters,
 
 DecodedImageData
 decode_jpeg2000_file(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    MappedFile mappedFile;
+    DecodedImageData result;
+    if (!mappedFile.open(path, result.errorMessage)) {
+        result.errorMessage = "can't open JPEG-2000 file";
+        return result;
+    }
+    return decode_jpeg2000_memory(mappedFile.bytes(), attributes);
+}
+
+DecodedImageData
+decode_jpeg2000_memory(const std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes)
 {
     DecodedImageData result;
 
 #if !defined(RAWGL_HAS_OPENJPEG)
-    (void)path;
+    (void)bytes;
     (void)attributes;
     result.errorMessage = "OpenJPEG support is not available";
     return result;
@@ -550,7 +701,7 @@ decode_jpeg2000_file(const std::string& path, const std::map<std::string, std::s
     parameters.cp_layer = settings.layerLimit;
 
     OpenJpegMessageState messageState;
-    opj_codec_t* codec = opj_create_decompress(resolve_openjpeg_codec_format(path));
+    opj_codec_t* codec = opj_create_decompress(detect_openjpeg_codec_format(bytes));
     if (codec == nullptr) {
         result.errorMessage = "OpenJPEG decompressor allocation failed";
         return result;
@@ -558,16 +709,32 @@ decode_jpeg2000_file(const std::string& path, const std::map<std::string, std::s
     opj_set_error_handler(codec, openjpeg_error_callback, &messageState);
     opj_set_warning_handler(codec, openjpeg_warning_callback, &messageState);
 
-    opj_stream_t* stream = opj_stream_create_default_file_stream(path.c_str(), OPJ_TRUE);
+    MemoryInputCursor cursor { bytes };
+    opj_stream_t* stream = create_openjpeg_memory_stream(cursor);
     if (stream == nullptr) {
         opj_destroy_codec(codec);
-        result.errorMessage = "can't open JPEG-2000 file";
+        result.errorMessage = "OpenJPEG stream allocation failed";
         return result;
     }
 
     opj_image_t* image = nullptr;
-    if (!opj_setup_decoder(codec, &parameters) || !opj_read_header(stream, codec, &image)
-        || !opj_decode(codec, stream, image)) {
+    bool decoded = opj_setup_decoder(codec, &parameters);
+    record_codec_thread_count(ImageCodecFamily::Jpeg2000, std::max(settings.threadCount, 1u));
+    if (decoded && settings.threadCount > 1u) {
+        // Builds without thread support refuse the request and decode on the calling thread.
+        opj_codec_set_threads(codec, static_cast<int>(std::min(settings.threadCount, 4096u)));
+    }
+    decoded = decoded && opj_read_header(stream, codec, &image);
+    // An explicit reduce factor wins; the generic decode scale is clamped to the available resolutions.
+    if (decoded && !settings.hasReduceFactor && settings.decodeScaleLog2 > 0u) {
+        decoded = opj_set_decoded_resolution_factor(
+            codec, resolve_openjpeg_decode_scale_reduce(codec, settings.decodeScaleLog2));
+    }
+    if (decoded && settings.hasRegion) {
+        decoded = apply_openjpeg_decode_region(codec, image, settings, messageState.error);
+    }
+    decoded = decoded && opj_decode(codec, stream, image);
+    if (!decoded) {
         if (image != nullptr) {
             opj_image_destroy(image);
         }
@@ -649,8 +816,13 @@ encode_jpeg2000_file(const std::string& path,
         return false;
     }
 
-    const bool encoded = opj_setup_encoder(codec, &parameters, openJpegImage)
-                         && opj_start_compress(codec, openJpegImage, stream)
+    bool encoded = opj_setup_encoder(codec, &parameters, openJpegImage);
+    record_codec_thread_count(ImageCodecFamily::Jpeg2000, std::max(saveSettings.threadCount, 1u));
+    if (encoded && saveSettings.threadCount > 1u) {
+        // OpenJPEG before 2.4 only threads decoding and refuses this call; encoding then stays serial.
+        opj_codec_set_threads(codec, static_cast<int>(std::min(saveSettings.threadCount, 4096u)));
+    }
+    encoded = encoded && opj_start_compress(codec, openJpegImage, stream)
                          && opj_encode(codec, stream)
                          && opj_end_compress(codec, stream);
 
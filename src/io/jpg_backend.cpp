@@ -4,6 +4,7 @@
 #include "jpg_backend.h"
 
 #include "gl_utils.h"
+#include "mapped_file.h"
 
 #include <algorithm>
 #include <array>
@@ -56,6 +57,15 @@ struct JpegSaveOptions {
     bool hasOptimizeCoding = false;
     JpegSubsampling subsampling = JpegSubsampling::Default;
     bool hasSubsampling = false;
+    J_DCT_METHOD dctMethod = JDCT_ISLOW;
+    bool hasDctMethod = false;
+};
+
+struct JpegLoadSettings {
+    JpegLoadColorMode colorMode = JpegLoadColorMode::Auto;
+    J_DCT_METHOD dctMethod = JDCT_ISLOW;
+    bool fancyUpsampling = true;
+    uint32_t scaleLog2 = 0u;
 };
 
 static bool
@@ -260,6 +270,47 @@ parse_jpeg_subsampling(const std::map<std::string, std::string>& attributes,
     return true;
 }
 
+static bool
+parse_jpeg_dct_method(const std::map<std::string, std::string>& attributes,
+                      const char* jpegKey,
+                      const char* jpgKey,
+                      J_DCT_METHOD& dctMethod,
+                      bool& present,
+                      std::string& errorMessage)
+{
+    present = false;
+    dctMethod = JDCT_ISLOW;
+
+    const std::string* attribute = nullptr;
+    const auto jpegValue = attributes.find(jpegKey);
+    if (jpegValue != attributes.end()) {
+        attribute = &jpegValue->second;
+    } else if (jpgKey != nullptr) {
+        const auto jpgValue = attributes.find(jpgKey);
+        if (jpgValue != attributes.end()) {
+            attribute = &jpgValue->second;
+        }
+    }
+    if (attribute == nullptr) {
+        return true;
+    }
+
+    present = true;
+    const std::string normalized = to_lower_copy(*attribute);
+    if (normalized == "accurate" || normalized == "islow" || normalized == "int") {
+        dctMethod = JDCT_ISLOW;
+    } else if (normalized == "fast" || normalized == "ifast") {
+        dctMethod = JDCT_IFAST;
+    } else if (normalized == "float") {
+        dctMethod = JDCT_FLOAT;
+    } else {
+        errorMessage = "unsupported JPEG DCT method";
+        return false;
+    }
+
+    return true;
+}
+
 static bool
 parse_jpeg_save_options(const std::map<std::string, std::string>& attributes,
                         JpegSaveOptions& options,
@@ -293,6 +344,14 @@ parse_jpeg_save_options(const std::map<std::string, std::string>& attributes,
     if (!parse_jpeg_subsampling(attributes, options, errorMessage)) {
         return false;
     }
+    if (!parse_jpeg_dct_method(attributes,
+                               "jpeg:dct_method",
+                               "jpg:dct_method",
+                               options.dctMethod,
+                               options.hasDctMethod,
+                               errorMessage)) {
+        return false;
+    }
 
     return true;
 }
@@ -385,12 +444,12 @@ read_source_sample(const HostImageData& image, const size_t sampleIndex, bool& s
 
     switch (image.glType) {
     case GL_UNSIGNED_BYTE: {
-        const uint8_t value = reinterpret_cast<const uint8_t*>(image.bytes.data())[sampleIndex];
+        const uint8_t value = reinterpret_cast<const uint8_t*>(image.pixelBytes().data())[sampleIndex];
         return static_cast<float>(value) / 255.0f;
     }
     case GL_UNSIGNED_SHORT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         if (!host_is_little_endian()) {
             value = static_cast<uint16_t>((value >> 8u) | (value << 8u));
         }
@@ -398,12 +457,12 @@ read_source_sample(const HostImageData& image, const size_t sampleIndex, bool& s
     }
     case GL_FLOAT: {
         float value = 0.0f;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(float), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(float), sizeof(value));
         return value;
     }
     case GL_HALF_FLOAT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         if (!host_is_little_endian()) {
             value = static_cast<uint16_t>((value >> 8u) | (value << 8u));
         }
@@ -516,6 +575,39 @@ parse_jpeg_load_color_mode(const std::map<std::string, std::string>& attributes,
     return false;
 }
 
+static bool
+parse_jpeg_load_settings(const std::map<std::string, std::string>& attributes,
+                         JpegLoadSettings& settings,
+                         std::string& errorMessage)
+{
+    settings = JpegLoadSettings();
+    if (!parse_jpeg_load_color_mode(attributes, settings.colorMode, errorMessage)) {
+        return false;
+    }
+
+    bool hasDctMethod = false;
+    if (!parse_jpeg_dct_method(attributes, "jpeg:dct_method", nullptr, settings.dctMethod, hasDctMethod, errorMessage)) {
+        return false;
+    }
+
+    bool hasFancyUpsampling = false;
+    bool fancyUpsampling = true;
+    if (!parse_jpeg_bool_setting(attributes,
+                                 "jpeg:fancy_upsampling",
+                                 "jpg:fancy_upsampling",
+                                 fancyUpsampling,
+                                 hasFancyUpsampling,
+                                 "invalid JPEG fancy upsampling value",
+                                 errorMessage)) {
+        return false;
+    }
+    if (hasFancyUpsampling) {
+        settings.fancyUpsampling = fancyUpsampling;
+    }
+
+    return parse_image_decode_scale(attributes, settings.scaleLog2, errorMessage);
+}
+
 static bool
 close_file(FILE* file)
 {
@@ -530,18 +622,33 @@ close_file(FILE* file)
 
 DecodedImageData
 decode_jpg_file(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    MappedFile mappedFile;
+    DecodedImageData result;
+    if (!mappedFile.open(path, result.errorMessage)) {
+        result.errorMessage = "can't open JPEG file";
+        return result;
+    }
+    return decode_jpg_memory(mappedFile.bytes(), attributes);
+}
+
+DecodedImageData
+decode_jpg_memory(const std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes)
 {
     DecodedImageData result;
 
 #if !defined(RAWGL_HAS_LIBJPEG)
-    (void)path;
+    (void)bytes;
     (void)attributes;
     result.errorMessage = "libjpeg support is not available";
     return result;
 #else
-    FILE* file = fopen(path.c_str(), "rb");
-    if (file == nullptr) {
-        result.errorMessage = "can't open JPEG file";
+    JpegLoadSettings settings;
+    if (!parse_jpeg_load_settings(attributes, settings, result.errorMessage)) {
+        return result;
+    }
+    if (bytes.empty()) {
+        result.errorMessage = "JPEG source is empty";
         return result;
     }
 
@@ -549,28 +656,25 @@ decode_jpg_file(const std::string& path, const std::map<std::string, std::string
     JpegErrorState errorState {};
     initialize_jpeg_error_state(errorState);
     cinfo.err = &errorState.base;
+    std::vector<JSAMPROW> rowPointers;
 
     if (setjmp(errorState.jumpBuffer) != 0) {
         jpeg_destroy_decompress(&cinfo);
-        close_file(file);
+        result = DecodedImageData();
         result.errorMessage = errorState.message[0] != '\0' ? errorState.message : "libjpeg read failed";
         return result;
     }
 
     jpeg_create_decompress(&cinfo);
-    jpeg_stdio_src(&cinfo, file);
+    // Older jpeglib.h declares the source buffer non-const; libjpeg never writes through it.
+    jpeg_mem_src(&cinfo,
+                 const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(bytes.data())),
+                 static_cast<unsigned long>(bytes.size()));
     jpeg_read_header(&cinfo, TRUE);
 
-    JpegLoadColorMode colorMode = JpegLoadColorMode::Auto;
-    if (!parse_jpeg_load_color_mode(attributes, colorMode, result.errorMessage)) {
-        jpeg_destroy_decompress(&cinfo);
-        close_file(file);
-        return result;
-    }
-
-    if (colorMode == JpegLoadColorMode::Grayscale) {
+    if (settings.colorMode == JpegLoadColorMode::Grayscale) {
         cinfo.out_color_space = JCS_GRAYSCALE;
-    } else if (colorMode == JpegLoadColorMode::Rgb) {
+    } else if (settings.colorMode == JpegLoadColorMode::Rgb) {
         cinfo.out_color_space = JCS_RGB;
     } else if (cinfo.jpeg_color_space == JCS_GRAYSCALE) {
         cinfo.out_color_space = JCS_GRAYSCALE;
@@ -578,11 +682,17 @@ decode_jpg_file(const std::string& path, const std::map<std::string, std::string
         cinfo.out_color_space = JCS_RGB;
     } else {
         jpeg_destroy_decompress(&cinfo);
-        close_file(file);
         result.errorMessage = "unsupported JPEG color space";
         return result;
     }
 
+    // libjpeg reduces in the IDCT, down to 1/8 of the full size.
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = 1u << std::min<uint32_t>(settings.scaleLog2, 3u);
+    cinfo.dct_method = settings.dctMethod;
+    // Without fancy upsampling libjpeg-turbo merges chroma upsampling into its SIMD colour converter.
+    cinfo.do_fancy_upsampling = settings.fancyUpsampling ? TRUE : FALSE;
+
     jpeg_start_decompress(&cinfo);
 
     const int width = static_cast<int>(cinfo.output_width);
@@ -597,15 +707,17 @@ decode_jpg_file(const std::string& path, const std::map<std::string, std::string
     result.componentType = ImageComponentType::U8;
     result.bytes.resize(static_cast<size_t>(height) * rowStride);
 
+    rowPointers.resize(static_cast<size_t>(height));
+    for (size_t row = 0; row < rowPointers.size(); ++row) {
+        rowPointers[row] = reinterpret_cast<JSAMPROW>(result.bytes.data() + row * rowStride);
+    }
     while (cinfo.output_scanline < cinfo.output_height) {
-        JSAMPROW rowPointer =
-            reinterpret_cast<JSAMPROW>(result.bytes.data() + static_cast<size_t>(cinfo.output_scanline) * rowStride);
-        jpeg_read_scanlines(&cinfo, &rowPointer, 1);
+        const JDIMENSION scanline = cinfo.output_scanline;
+        jpeg_read_scanlines(&cinfo, rowPointers.data() + scanline, cinfo.output_height - scanline);
     }
 
     jpeg_finish_decompress(&cinfo);
     jpeg_destroy_decompress(&cinfo);
-    close_file(file);
 
     result.success = true;
     return result;
@@ -672,6 +784,10 @@ encode_jpg_file(const std::string& path,
         cinfo.optimize_coding = options.optimizeCoding ? TRUE : FALSE;
     }
 
+    if (options.hasDctMethod) {
+        cinfo.dct_method = options.dctMethod;
+    }
+
     if (!apply_jpeg_subsampling(cinfo, outputChannels, options, errorMessage)) {
         jpeg_destroy_compress(&cinfo);
         close_file(file);
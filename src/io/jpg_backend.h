@@ -5,7 +5,9 @@
 
 #include "image_backend.h"
 
+#include <cstddef>
 #include <map>
+#include <span>
 #include <string>
 
 namespace rawgl::io {
@@ -13,6 +15,9 @@ namespace rawgl::io {
 DecodedImageData
 decode_jpg_file(const std::string& path, const std::map<std::string, std::string>& attributes = {});
 
+DecodedImageData
+decode_jpg_memory(std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes = {});
+
 bool
 encode_jpg_file(const std::string& path,
                 const std::map<std::string, std::string>& attributes,
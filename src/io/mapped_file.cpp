@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace rawgl::io {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0u);
+        m_open = std::exchange(other.m_open, false);
+#if defined(_WIN32)
+        m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+        m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+bool
+MappedFile::open(const std::string& path, std::string& errorMessage)
+{
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        errorMessage = "can't open image file";
+        return false;
+    }
+
+    LARGE_INTEGER fileSize {};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < 0
+        || static_cast<unsigned long long>(fileSize.QuadPart) > std::numeric_limits<size_t>::max()) {
+        CloseHandle(file);
+        errorMessage = "can't read image file size";
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_open = true;
+    if (fileSize.QuadPart == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        errorMessage = "can't map image file";
+        return false;
+    }
+    m_mappingHandle = mapping;
+
+    m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_data == nullptr) {
+        close();
+        errorMessage = "can't map image file";
+        return false;
+    }
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void
+MappedFile::close()
+{
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+    m_data = nullptr;
+    m_size = 0u;
+    m_open = false;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+#else
+bool
+MappedFile::open(const std::string& path, std::string& errorMessage)
+{
+    close();
+
+    const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        errorMessage = "can't open image file";
+        return false;
+    }
+
+    struct stat fileStat {};
+    if (fstat(descriptor, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size < 0
+        || static_cast<unsigned long long>(fileStat.st_size) > std::numeric_limits<size_t>::max()) {
+        ::close(descriptor);
+        errorMessage = "can't read image file size";
+        return false;
+    }
+
+    const size_t byteCount = static_cast<size_t>(fileStat.st_size);
+    if (byteCount == 0u) {
+        ::close(descriptor);
+        m_open = true;
+        return true;
+    }
+
+    void* data = mmap(nullptr, byteCount, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(descriptor);
+    if (data == MAP_FAILED) {
+        errorMessage = "can't map image file";
+        return false;
+    }
+    // Decoders walk most containers front to back; let the kernel read ahead.
+    posix_madvise(data, byteCount, POSIX_MADV_SEQUENTIAL);
+
+    m_data = data;
+    m_size = byteCount;
+    m_open = true;
+    return true;
+}
+
+void
+MappedFile::close()
+{
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0u;
+    m_open = false;
+}
+#endif
+
+size_t
+MemoryInputCursor::read(void* destination, const size_t byteCount)
+{
+    const size_t copied = std::min(byteCount, remaining());
+    if (copied > 0u) {
+        std::memcpy(destination, current(), copied);
+        position += copied;
+    }
+    return copied;
+}
+
+bool
+MemoryInputCursor::seek(const uint64_t offset)
+{
+    if (offset > bytes.size()) {
+        return false;
+    }
+    position = offset;
+    return true;
+}
+
+}  // namespace rawgl::io
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace rawgl::io {
+
+/// Read-only memory mapping of one input file.
+///
+/// Native decoders read straight from the mapping instead of through `FILE*` streams. An empty file opens
+/// successfully with an empty byte span.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& path, std::string& errorMessage);
+    void close();
+
+    bool isOpen() const { return m_open; }
+    std::span<const std::byte> bytes() const { return { static_cast<const std::byte*>(m_data), m_size }; }
+
+private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+#if defined(_WIN32)
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
+
+/// Seekable read cursor over an in-memory image source, used by the codec stream callbacks.
+struct MemoryInputCursor {
+    std::span<const std::byte> bytes;
+    uint64_t position = 0;
+
+    /// Copies up to `byteCount` bytes from the current position and returns the number copied.
+    size_t read(void* destination, size_t byteCount);
+    /// Moves to `offset`; fails without moving when `offset` is past the end.
+    bool seek(uint64_t offset);
+
+    size_t remaining() const { return position < bytes.size() ? bytes.size() - static_cast<size_t>(position) : 0u; }
+    const std::byte* current() const { return bytes.data() + (bytes.size() - remaining()); }
+};
+
+}  // namespace rawgl::io
@@ -6,7 +6,26 @@
 #include "image_backend.h"
 #include "log.h"
 
+#include <algorithm>
+
 namespace rawgl::io {
+namespace {
+
+// Streaming writers convert this many rows at a time instead of the whole image.
+constexpr int kOutputStreamBandRows = 256;
+
+static ImageEncodeSettings
+resolve_output_encode_settings(const OutputWriteRequest& request)
+{
+    const ImageEncodeSettings settings = resolve_image_encode_settings(request.path, request.bits);
+    if (settings.defaulted) {
+        LOG(warning) << "Output bit depth " << request.bits << " is not supported for " << request.path
+                     << ", using the closest supported format instead.";
+    }
+    return settings;
+}
+
+}  // namespace
 
 bool
 save_image_output(const OutputWriteRequest& request, std::string& errorMessage)
@@ -16,10 +35,21 @@ save_image_output(const OutputWriteRequest& request, std::string& errorMessage)
         return false;
     }
 
-    const ImageEncodeSettings settings = resolve_image_encode_settings(request.path, request.bits);
-    if (settings.defaulted) {
-        LOG(warning) << "Output bit depth " << request.bits << " is not supported for " << request.path
-                     << ", using the closest supported format instead.";
+    const ImageEncodeSettings settings = resolve_output_encode_settings(request);
+    if (image_codec_supports_stream_encode(settings.codec) && request.image->height > kOutputStreamBandRows) {
+        const HostImageData& image = *request.image;
+        std::unique_ptr<ImageStreamEncoder> encoder = begin_image_stream_encode(
+            request.path, request.attributes, request.alphaChannel, image, settings, errorMessage);
+        bool saved = encoder != nullptr;
+        for (int firstRow = 0; saved && firstRow < image.height; firstRow += kOutputStreamBandRows) {
+            const int rowCount = std::min(kOutputStreamBandRows, image.height - firstRow);
+            saved = encoder->writeRows(make_image_row_band(image, firstRow, rowCount), errorMessage);
+        }
+        if (!saved || !encoder->finish(errorMessage)) {
+            LOG(error) << errorMessage;
+            return false;
+        }
+        return true;
     }
 
     if (!encode_image_file(request.path,
@@ -35,4 +65,21 @@ save_image_output(const OutputWriteRequest& request, std::string& errorMessage)
     return true;
 }
 
+std::unique_ptr<ImageStreamEncoder>
+begin_image_output_stream(const OutputWriteRequest& request, std::string& errorMessage)
+{
+    if (request.path.empty() || request.image == nullptr) {
+        errorMessage = "invalid image output request";
+        return nullptr;
+    }
+
+    const ImageEncodeSettings settings = resolve_output_encode_settings(request);
+    std::unique_ptr<ImageStreamEncoder> encoder = begin_image_stream_encode(
+        request.path, request.attributes, request.alphaChannel, *request.image, settings, errorMessage);
+    if (!encoder) {
+        LOG(error) << errorMessage;
+    }
+    return encoder;
+}
+
 }  // namespace rawgl::io
@@ -6,6 +6,7 @@
 #include "rawgl/rawgl_core.h"
 
 #include <map>
+#include <memory>
 #include <string>
 
 namespace rawgl::io {
@@ -18,7 +19,13 @@ struct OutputWriteRequest {
     const HostImageData* image = nullptr;
 };
 
+class ImageStreamEncoder;
+
 bool
 save_image_output(const OutputWriteRequest& request, std::string& errorMessage);
 
+/// Starts a row-band save; `request.image` describes the layout and its pixels are ignored.
+std::unique_ptr<ImageStreamEncoder>
+begin_image_output_stream(const OutputWriteRequest& request, std::string& errorMessage);
+
 }  // namespace rawgl::io
@@ -4,6 +4,7 @@
 #include "png_backend.h"
 
 #include "gl_utils.h"
+#include "mapped_file.h"
 
 #include <algorithm>
 #include <array>
@@ -83,22 +84,22 @@ read_source_sample(const HostImageData& image, const size_t sampleIndex, bool& s
 
     switch (image.glType) {
     case GL_UNSIGNED_BYTE: {
-        const uint8_t value = reinterpret_cast<const uint8_t*>(image.bytes.data())[sampleIndex];
+        const uint8_t value = reinterpret_cast<const uint8_t*>(image.pixelBytes().data())[sampleIndex];
         return static_cast<float>(value) / 255.0f;
     }
     case GL_UNSIGNED_SHORT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return static_cast<float>(value) / 65535.0f;
     }
     case GL_FLOAT: {
         float value = 0.0f;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(float), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(float), sizeof(value));
         return value;
     }
     case GL_HALF_FLOAT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return half_to_float(value);
     }
     default: break;
@@ -145,7 +146,7 @@ convert_host_image_to_png_bytes(const HostImageData& image,
     if (componentType == ImageComponentType::U8) {
         bytes.resize(sampleCount);
         if (image.glType == GL_UNSIGNED_BYTE) {
-            std::memcpy(bytes.data(), image.bytes.data(), sampleCount);
+            std::memcpy(bytes.data(), image.pixelBytes().data(), sampleCount);
             return true;
         }
 
@@ -170,12 +171,12 @@ convert_host_image_to_png_bytes(const HostImageData& image,
             if (host_is_little_endian()) {
                 for (size_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
                     uint16_t value = 0u;
-                    std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+                    std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
                     destination[sampleIndex * 2u] = static_cast<uint8_t>((value >> 8u) & 0xffu);
                     destination[sampleIndex * 2u + 1u] = static_cast<uint8_t>(value & 0xffu);
                 }
             } else {
-                std::memcpy(bytes.data(), image.bytes.data(), sampleCount * sizeof(uint16_t));
+                std::memcpy(bytes.data(), image.pixelBytes().data(), sampleCount * sizeof(uint16_t));
             }
         } else {
             for (size_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
@@ -217,6 +218,15 @@ close_file(FILE* file)
     }
 }
 
+static void
+read_png_memory(png_structp pngPtr, png_bytep destination, const png_size_t byteCount)
+{
+    MemoryInputCursor& cursor = *static_cast<MemoryInputCursor*>(png_get_io_ptr(pngPtr));
+    if (cursor.read(destination, static_cast<size_t>(byteCount)) != static_cast<size_t>(byteCount)) {
+        png_error(pngPtr, "unexpected end of PNG data");
+    }
+}
+
 static std::string
 to_lower_copy(const std::string& value)
 {
@@ -324,38 +334,209 @@ parse_png_save_options(const std::map<std::string, std::string>& attributes,
 
     return true;
 }
+
+class PngStreamEncoder final : public ImageStreamEncoder {
+public:
+    PngStreamEncoder(const HostImageData& layout, const ImageComponentType componentType)
+        : m_layout(layout)
+        , m_componentType(componentType)
+    {
+    }
+
+    ~PngStreamEncoder() override
+    {
+        if (m_pngPtr != nullptr) {
+            png_destroy_write_struct(&m_pngPtr, &m_infoPtr);
+        }
+        close_file(m_file);
+    }
+
+    PngStreamEncoder(const PngStreamEncoder&) = delete;
+    PngStreamEncoder&
+    operator=(const PngStreamEncoder&) = delete;
+
+    bool
+    start(const std::string& path, const PngSaveOptions& options, const int colorType, std::string& errorMessage)
+    {
+        m_file = fopen(path.c_str(), "wb");
+        if (m_file == nullptr) {
+            errorMessage = "can't open PNG file for writing";
+            return false;
+        }
+
+        m_pngPtr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        if (m_pngPtr == nullptr) {
+            errorMessage = "failed to create PNG write struct";
+            return false;
+        }
+        m_infoPtr = png_create_info_struct(m_pngPtr);
+        if (m_infoPtr == nullptr) {
+            errorMessage = "failed to create PNG info struct";
+            return false;
+        }
+
+        if (setjmp(png_jmpbuf(m_pngPtr)) != 0) {
+            errorMessage = "libpng write failed";
+            return false;
+        }
+
+        png_init_io(m_pngPtr, m_file);
+        png_set_compression_level(m_pngPtr, options.compressionLevel);
+        m_interlaced = options.interlaced;
+        const int bitDepth = m_componentType == ImageComponentType::U16 ? 16 : 8;
+        png_set_IHDR(m_pngPtr,
+                     m_infoPtr,
+                     static_cast<png_uint_32>(m_layout.width),
+                     static_cast<png_uint_32>(m_layout.height),
+                     bitDepth,
+                     colorType,
+                     m_interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
+                     PNG_COMPRESSION_TYPE_DEFAULT,
+                     PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(m_pngPtr, m_infoPtr);
+
+        m_rowBytes = static_cast<size_t>(png_get_rowbytes(m_pngPtr, m_infoPtr));
+        const size_t expectedRowBytes = static_cast<size_t>(m_layout.width) * static_cast<size_t>(m_layout.channels)
+                                        * (bitDepth == 16 ? sizeof(uint16_t) : sizeof(uint8_t));
+        if (m_rowBytes != expectedRowBytes) {
+            errorMessage = "unexpected PNG row byte size";
+            return false;
+        }
+        if (m_interlaced) {
+            m_interlacedBytes.reserve(m_rowBytes * static_cast<size_t>(m_layout.height));
+        }
+        return true;
+    }
+
+    bool
+    writeRows(const HostImageData& rows, std::string& errorMessage) override
+    {
+        if (!validate_image_stream_rows(m_layout, m_rowsWritten, rows, errorMessage)) {
+            return false;
+        }
+        if (!convert_host_image_to_png_bytes(rows, m_componentType, m_encodedBytes, errorMessage)) {
+            return false;
+        }
+        m_rowsWritten += rows.height;
+
+        // Adam7 passes revisit every row, so interlaced output is collected and written by finish.
+        if (m_interlaced) {
+            m_interlacedBytes.insert(m_interlacedBytes.end(), m_encodedBytes.begin(), m_encodedBytes.end());
+            return true;
+        }
+        if (!writeEncodedRows(m_encodedBytes, rows.height)) {
+            errorMessage = "libpng write failed";
+            return false;
+        }
+        return true;
+    }
+
+    bool
+    finish(std::string& errorMessage) override
+    {
+        if (m_rowsWritten != m_layout.height) {
+            errorMessage = "PNG stream finished before every row was written";
+            return false;
+        }
+        if (m_interlaced && !writeInterlacedImage()) {
+            errorMessage = "libpng write failed";
+            return false;
+        }
+        if (setjmp(png_jmpbuf(m_pngPtr)) != 0) {
+            errorMessage = "libpng write failed";
+            return false;
+        }
+        png_write_end(m_pngPtr, m_infoPtr);
+        png_destroy_write_struct(&m_pngPtr, &m_infoPtr);
+        m_pngPtr = nullptr;
+        m_infoPtr = nullptr;
+
+        const bool closed = fclose(m_file) == 0;
+        m_file = nullptr;
+        if (!closed) {
+            errorMessage = "failed to close PNG file";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool
+    writeEncodedRows(const std::vector<std::byte>& encodedBytes, const int rowCount)
+    {
+        if (setjmp(png_jmpbuf(m_pngPtr)) != 0) {
+            return false;
+        }
+        for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+            png_write_row(m_pngPtr,
+                          reinterpret_cast<png_const_bytep>(encodedBytes.data())
+                              + static_cast<size_t>(rowIndex) * m_rowBytes);
+        }
+        return true;
+    }
+
+    bool
+    writeInterlacedImage()
+    {
+        std::vector<png_bytep> rows(static_cast<size_t>(m_layout.height));
+        for (size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex) {
+            rows[rowIndex] = reinterpret_cast<png_bytep>(m_interlacedBytes.data()) + rowIndex * m_rowBytes;
+        }
+
+        if (setjmp(png_jmpbuf(m_pngPtr)) != 0) {
+            return false;
+        }
+        png_write_image(m_pngPtr, rows.data());
+        return true;
+    }
+
+    HostImageData m_layout;
+    ImageComponentType m_componentType = ImageComponentType::U8;
+    FILE* m_file = nullptr;
+    png_structp m_pngPtr = nullptr;
+    png_infop m_infoPtr = nullptr;
+    size_t m_rowBytes = 0u;
+    int m_rowsWritten = 0;
+    bool m_interlaced = false;
+    std::vector<std::byte> m_encodedBytes;
+    std::vector<std::byte> m_interlacedBytes;
+};
 #endif
 
 }  // namespace
 
 DecodedImageData
 decode_png_file(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    MappedFile mappedFile;
+    DecodedImageData result;
+    if (!mappedFile.open(path, result.errorMessage)) {
+        result.errorMessage = "can't open PNG file";
+        return result;
+    }
+    return decode_png_memory(mappedFile.bytes(), attributes);
+}
+
+DecodedImageData
+decode_png_memory(const std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes)
 {
     DecodedImageData result;
 
 #if !defined(RAWGL_HAS_LIBPNG)
-    (void)path;
+    (void)bytes;
     (void)attributes;
     result.errorMessage = "libpng support is not available";
     return result;
 #else
-    FILE* file = fopen(path.c_str(), "rb");
-    if (file == nullptr) {
-        result.errorMessage = "can't open PNG file";
-        return result;
-    }
-
-    std::array<png_byte, 8> signature {};
-    const size_t signatureBytes = fread(signature.data(), 1u, signature.size(), file);
-    if (signatureBytes != signature.size() || png_sig_cmp(signature.data(), 0u, signature.size()) != 0) {
-        close_file(file);
+    constexpr size_t kSignatureSize = 8u;
+    if (bytes.size() < kSignatureSize
+        || png_sig_cmp(reinterpret_cast<png_const_bytep>(bytes.data()), 0u, kSignatureSize) != 0) {
         result.errorMessage = "file is not a valid PNG image";
         return result;
     }
 
     png_structp pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
     if (pngPtr == nullptr) {
-        close_file(file);
         result.errorMessage = "failed to create PNG read struct";
         return result;
     }
@@ -363,22 +544,21 @@ decode_png_file(const std::string& path, const std::map<std::string, std::string
     png_infop infoPtr = png_create_info_struct(pngPtr);
     if (infoPtr == nullptr) {
         png_destroy_read_struct(&pngPtr, nullptr, nullptr);
-        close_file(file);
         result.errorMessage = "failed to create PNG info struct";
         return result;
     }
 
+    MemoryInputCursor cursor { bytes, kSignatureSize };
     if (setjmp(png_jmpbuf(pngPtr)) != 0) {
         png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
-        close_file(file);
         if (result.errorMessage.empty()) {
             result.errorMessage = "libpng read failed";
         }
         return result;
     }
 
-    png_init_io(pngPtr, file);
-    png_set_sig_bytes(pngPtr, static_cast<int>(signature.size()));
+    png_set_read_fn(pngPtr, &cursor, read_png_memory);
+    png_set_sig_bytes(pngPtr, static_cast<int>(kSignatureSize));
     png_read_info(pngPtr, infoPtr);
 
     png_uint_32 width = 0u;
@@ -402,7 +582,6 @@ decode_png_file(const std::string& path, const std::map<std::string, std::string
                               hasExpandTransparency,
                               result.errorMessage)) {
         png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
-        close_file(file);
         return result;
     }
     (void)hasExpandTransparency;
@@ -419,7 +598,6 @@ decode_png_file(const std::string& path, const std::map<std::string, std::string
     if (bitDepth != 8 && bitDepth != 16) {
         result.errorMessage = "unsupported PNG bit depth";
         png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
-        close_file(file);
         return result;
     }
 
@@ -440,7 +618,6 @@ decode_png_file(const std::string& path, const std::map<std::string, std::string
     png_read_end(pngPtr, infoPtr);
 
     png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
-    close_file(file);
 
     result.width = static_cast<int>(width);
     result.height = static_cast<int>(height);
@@ -460,99 +637,61 @@ encode_png_file(const std::string& path,
                 const ImageEncodeSettings& settings,
                 std::string& errorMessage)
 {
-    (void)alphaChannel;
+    std::unique_ptr<ImageStreamEncoder> encoder =
+        begin_png_stream_encode(path, attributes, alphaChannel, image, settings, errorMessage);
+    if (!encoder) {
+        return false;
+    }
+    return encoder->writeRows(image, errorMessage) && encoder->finish(errorMessage);
+}
 
+std::unique_ptr<ImageStreamEncoder>
+begin_png_stream_encode(const std::string& path,
+                        const std::map<std::string, std::string>& attributes,
+                        int alphaChannel,
+                        const HostImageData& layout,
+                        const ImageEncodeSettings& settings,
+                        std::string& errorMessage)
+{
 #if !defined(RAWGL_HAS_LIBPNG)
+    (void)path;
+    (void)attributes;
+    (void)alphaChannel;
+    (void)layout;
+    (void)settings;
     errorMessage = "libpng support is not available";
-    return false;
+    return nullptr;
 #else
+    (void)alphaChannel;
     if (settings.componentType != ImageComponentType::U8 && settings.componentType != ImageComponentType::U16) {
         errorMessage = "native PNG write only supports 8-bit or 16-bit PNG output";
-        return false;
+        return nullptr;
     }
 
-    const int colorType = resolve_png_color_type(image.channels);
+    const int colorType = resolve_png_color_type(layout.channels);
     if (colorType < 0) {
         errorMessage = "unsupported PNG channel count";
-        return false;
+        return nullptr;
     }
 
     PngSaveOptions options;
     if (!parse_png_save_options(attributes, options, errorMessage)) {
-        return false;
-    }
-
-    std::vector<std::byte> encodedBytes;
-    if (!convert_host_image_to_png_bytes(image, settings.componentType, encodedBytes, errorMessage)) {
-        return false;
-    }
-
-    FILE* file = fopen(path.c_str(), "wb");
-    if (file == nullptr) {
-        errorMessage = "can't open PNG file for writing";
-        return false;
+        return nullptr;
     }
 
-    png_structp pngPtr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-    if (pngPtr == nullptr) {
-        close_file(file);
-        errorMessage = "failed to create PNG write struct";
-        return false;
-    }
+    HostImageData streamLayout;
+    streamLayout.width = layout.width;
+    streamLayout.height = layout.height;
+    streamLayout.channels = layout.channels;
+    streamLayout.alphaChannel = layout.alphaChannel;
+    streamLayout.glInternalFormat = layout.glInternalFormat;
+    streamLayout.glType = layout.glType;
 
-    png_infop infoPtr = png_create_info_struct(pngPtr);
-    if (infoPtr == nullptr) {
-        png_destroy_write_struct(&pngPtr, nullptr);
-        close_file(file);
-        errorMessage = "failed to create PNG info struct";
-        return false;
+    auto encoder = std::make_unique<PngStreamEncoder>(streamLayout, settings.componentType);
+    if (!encoder->start(path, options, colorType, errorMessage)) {
+        return nullptr;
     }
-
-    if (setjmp(png_jmpbuf(pngPtr)) != 0) {
-        png_destroy_write_struct(&pngPtr, &infoPtr);
-        close_file(file);
-        if (errorMessage.empty()) {
-            errorMessage = "libpng write failed";
-        }
-        return false;
-    }
-
-    png_init_io(pngPtr, file);
-    png_set_compression_level(pngPtr, options.compressionLevel);
-
-    const int interlaceType = options.interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE;
-    const int bitDepth = settings.componentType == ImageComponentType::U16 ? 16 : 8;
-    png_set_IHDR(pngPtr,
-                 infoPtr,
-                 static_cast<png_uint_32>(image.width),
-                 static_cast<png_uint_32>(image.height),
-                 bitDepth,
-                 colorType,
-                 interlaceType,
-                 PNG_COMPRESSION_TYPE_DEFAULT,
-                 PNG_FILTER_TYPE_DEFAULT);
-    png_write_info(pngPtr, infoPtr);
-
-    const png_size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
-    const size_t expectedRowBytes = static_cast<size_t>(image.width) * static_cast<size_t>(image.channels)
-                                    * (bitDepth == 16 ? sizeof(uint16_t) : sizeof(uint8_t));
-    if (static_cast<size_t>(rowBytes) != expectedRowBytes) {
-        png_destroy_write_struct(&pngPtr, &infoPtr);
-        close_file(file);
-        errorMessage = "unexpected PNG row byte size";
-        return false;
-    }
-
-    std::vector<png_bytep> rows(static_cast<size_t>(image.height));
-    for (size_t rowIndex = 0; rowIndex < static_cast<size_t>(image.height); ++rowIndex) {
-        rows[rowIndex] = reinterpret_cast<png_bytep>(encodedBytes.data()) + rowIndex * static_cast<size_t>(rowBytes);
-    }
-
-    png_write_image(pngPtr, rows.data());
-    png_write_end(pngPtr, infoPtr);
-    png_destroy_write_struct(&pngPtr, &infoPtr);
-    close_file(file);
-    return true;
+    return encoder;
 #endif
 }
 
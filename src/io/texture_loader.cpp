@@ -6,29 +6,13 @@
 #include "gl_utils.h"
 #include "image_backend.h"
 
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace rawgl::io {
 namespace {
 
-static HostImageData
-to_host_image_data(const LoadedTextureData& texture)
-{
-    if (!texture.valid) {
-        throw std::runtime_error("Invalid loaded texture data");
-    }
-
-    HostImageData hostImage;
-    hostImage.width            = texture.width;
-    hostImage.height           = texture.height;
-    hostImage.channels         = texture.channels;
-    hostImage.alphaChannel     = texture.alphaChannel;
-    hostImage.glInternalFormat = texture.internalFormat;
-    hostImage.glType           = texture.type;
-    hostImage.bytes            = texture.bytes;
-    return hostImage;
-}
-
 static void
 resolve_texture_storage(LoadedTextureData& texture, const ImageComponentType componentType)
 {
@@ -73,39 +57,66 @@ resolve_texture_storage(LoadedTextureData& texture, const ImageComponentType com
 
 }  // namespace
 
+HostImageData
+to_host_image_data(const LoadedTextureData& texture)
+{
+    if (!texture.valid) {
+        throw std::runtime_error("Invalid loaded texture data");
+    }
+
+    HostImageData hostImage;
+    hostImage.width            = texture.width;
+    hostImage.height           = texture.height;
+    hostImage.channels         = texture.channels;
+    hostImage.alphaChannel     = texture.alphaChannel;
+    hostImage.glInternalFormat = texture.internalFormat;
+    hostImage.glType           = texture.type;
+    if (texture.bytes) {
+        hostImage.sharedBytes     = std::shared_ptr<const std::byte>(texture.bytes, texture.bytes->data());
+        hostImage.sharedByteCount = texture.bytes->size();
+    }
+    return hostImage;
+}
+
 LoadedTextureData
-load_texture_file_data(const std::string& path, const std::map<std::string, std::string>& attributes)
+make_loaded_texture_data(std::shared_ptr<const DecodedImageData> decoded)
 {
     LoadedTextureData texture;
-    const DecodedImageData decoded = decode_image_file(path, attributes);
-    if (!decoded.success) {
+    if (!decoded || !decoded->success) {
         return texture;
     }
 
-    texture.width = decoded.width;
-    texture.height = decoded.height;
-    texture.channels = decoded.channels;
-    texture.alphaChannel = decoded.alphaChannel;
+    texture.width = decoded->width;
+    texture.height = decoded->height;
+    texture.channels = decoded->channels;
+    texture.alphaChannel = decoded->alphaChannel;
 
-    resolve_texture_storage(texture, decoded.componentType);
+    resolve_texture_storage(texture, decoded->componentType);
 
-    const size_t bytesPerComponent = byte_size_for_image_component(decoded.componentType);
+    const size_t bytesPerComponent = byte_size_for_image_component(decoded->componentType);
     if (bytesPerComponent == 0u) {
         throw std::runtime_error("Unsupported image type");
     }
 
     const size_t byteCount = static_cast<size_t>(texture.width) * static_cast<size_t>(texture.height)
                              * static_cast<size_t>(texture.channels) * bytesPerComponent;
-    if (decoded.bytes.size() != byteCount) {
+    if (decoded->bytes.size() != byteCount) {
         throw std::runtime_error("Decoded image byte size mismatch");
     }
 
-    texture.bytes = decoded.bytes;
+    const std::vector<std::byte>* decodedBytes = &decoded->bytes;
+    texture.bytes = std::shared_ptr<const std::vector<std::byte>>(std::move(decoded), decodedBytes);
 
     texture.valid = true;
     return texture;
 }
 
+LoadedTextureData
+load_texture_file_data(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    return make_loaded_texture_data(std::make_shared<const DecodedImageData>(decode_image_file(path, attributes)));
+}
+
 HostImageData
 load_host_image_data(const std::string& path, const std::map<std::string, std::string>& attributes)
 {
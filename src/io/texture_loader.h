@@ -7,11 +7,14 @@
 
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace rawgl::io {
 
+struct DecodedImageData;
+
 struct LoadedTextureData {
     bool valid = false;
     int width = 0;
@@ -20,9 +23,16 @@ struct LoadedTextureData {
     int alphaChannel = -1;
     unsigned int internalFormat = 0;
     unsigned int type = 0;
-    std::vector<std::byte> bytes;
+    /// Decoded pixels, shared with the decoder output and any decode-cache entry.
+    std::shared_ptr<const std::vector<std::byte>> bytes;
 };
 
+LoadedTextureData
+make_loaded_texture_data(std::shared_ptr<const DecodedImageData> decoded);
+
+HostImageData
+to_host_image_data(const LoadedTextureData& texture);
+
 LoadedTextureData
 load_texture_file_data(const std::string& path, const std::map<std::string, std::string>& attributes);
 
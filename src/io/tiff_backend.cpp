@@ -4,9 +4,12 @@
 #include "tiff_backend.h"
 
 #include "gl_utils.h"
+#include "mapped_file.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cerrno>
 #include <cctype>
 #include <cstdint>
@@ -16,7 +19,11 @@
 #include <cstring>
 #include <initializer_list>
 #include <limits>
+#include <mutex>
+#include <span>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 #if defined(RAWGL_HAS_LIBTIFF)
@@ -794,22 +801,22 @@ read_source_sample_as_unit_float(const HostImageData& image, const size_t sample
 
     switch (image.glType) {
     case GL_UNSIGNED_BYTE: {
-        const uint8_t value = reinterpret_cast<const uint8_t*>(image.bytes.data())[sampleIndex];
+        const uint8_t value = reinterpret_cast<const uint8_t*>(image.pixelBytes().data())[sampleIndex];
         return static_cast<float>(value) / 255.0f;
     }
     case GL_UNSIGNED_SHORT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return static_cast<float>(value) / 65535.0f;
     }
     case GL_FLOAT: {
         float value = 0.0f;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(float), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(float), sizeof(value));
         return value;
     }
     case GL_HALF_FLOAT: {
         uint16_t value = 0u;
-        std::memcpy(&value, image.bytes.data() + sampleIndex * sizeof(uint16_t), sizeof(value));
+        std::memcpy(&value, image.pixelBytes().data() + sampleIndex * sizeof(uint16_t), sizeof(value));
         return half_to_float(value);
     }
     default: break;
@@ -1142,27 +1149,888 @@ copy_tiff_interleaved_samples(const uint8_t* sourceBytes,
         }
     }
 }
+
+struct TiffChunkLayout {
+    bool tiled = false;
+    bool scanlines = false;
+    uint32_t width = 0u;
+    uint32_t height = 0u;
+    uint32_t chunkWidth = 0u;
+    uint32_t chunkHeight = 0u;
+    uint32_t chunksAcross = 0u;
+    uint32_t chunkCount = 0u;
+    size_t chunkByteSize = 0u;
+    size_t chunkRowBytes = 0u;
+    size_t chunkRowPixels = 0u;
+    uint16_t samplesPerPixel = 1u;
+    uint16_t bitsPerSample = 8u;
+    uint16_t photometric = PHOTOMETRIC_MINISBLACK;
+    ImageComponentType componentType = ImageComponentType::Unknown;
+};
+
+// Read-only TIFF client over a mapped or caller-owned buffer. The map procedure
+// hands libtiff the buffer itself, so strips and tiles are decoded in place.
+static tmsize_t
+tiff_memory_read(thandle_t handle, void* data, tmsize_t byteCount)
+{
+    MemoryInputCursor& cursor = *static_cast<MemoryInputCursor*>(handle);
+    return static_cast<tmsize_t>(cursor.read(data, static_cast<size_t>(byteCount)));
+}
+
+static tmsize_t
+tiff_memory_write(thandle_t, void*, tmsize_t)
+{
+    return 0;
+}
+
+static toff_t
+tiff_memory_seek(thandle_t handle, toff_t offset, int whence)
+{
+    MemoryInputCursor& cursor = *static_cast<MemoryInputCursor*>(handle);
+    uint64_t target = offset;
+    if (whence == SEEK_CUR) {
+        target = cursor.position + offset;
+    } else if (whence == SEEK_END) {
+        target = static_cast<uint64_t>(cursor.bytes.size()) + offset;
+    }
+    if (!cursor.seek(target)) {
+        return static_cast<toff_t>(-1);
+    }
+    return cursor.position;
+}
+
+static int
+tiff_memory_close(thandle_t)
+{
+    return 0;
+}
+
+static toff_t
+tiff_memory_size(thandle_t handle)
+{
+    return static_cast<toff_t>(static_cast<const MemoryInputCursor*>(handle)->bytes.size());
+}
+
+static int
+tiff_memory_map(thandle_t handle, void** base, toff_t* size)
+{
+    const MemoryInputCursor& cursor = *static_cast<const MemoryInputCursor*>(handle);
+    *base = const_cast<std::byte*>(cursor.bytes.data());
+    *size = static_cast<toff_t>(cursor.bytes.size());
+    return 1;
+}
+
+static void
+tiff_memory_unmap(thandle_t, void*, toff_t)
+{
+}
+
+static TIFF*
+open_tiff_memory(MemoryInputCursor& cursor)
+{
+    return TIFFClientOpen("rawgl-tiff-memory",
+                          "r",
+                          &cursor,
+                          tiff_memory_read,
+                          tiff_memory_write,
+                          tiff_memory_seek,
+                          tiff_memory_close,
+                          tiff_memory_size,
+                          tiff_memory_map,
+                          tiff_memory_unmap);
+}
+
+static TIFF*
+open_tiff_directory(MemoryInputCursor& cursor, const bool hasDirectoryIndex, const uint32_t directoryIndex)
+{
+    TIFF* tif = open_tiff_memory(cursor);
+    if (tif != nullptr && hasDirectoryIndex && TIFFSetDirectory(tif, static_cast<tdir_t>(directoryIndex)) != 1) {
+        TIFFClose(tif);
+        return nullptr;
+    }
+    return tif;
+}
+
+static bool
+resolve_tiff_chunk_layout(TIFF* tif, TiffChunkLayout& layout, std::string& errorMessage)
+{
+    const size_t bytesPerPixel =
+        static_cast<size_t>(layout.samplesPerPixel) * byte_size_for_image_component(layout.componentType);
+
+    if (TIFFIsTiled(tif) != 0) {
+        uint32_t tileWidth = 0u;
+        uint32_t tileLength = 0u;
+        TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileWidth);
+        TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileLength);
+        if (tileWidth == 0u || tileLength == 0u) {
+            errorMessage = "invalid TIFF tile geometry";
+            return false;
+        }
+
+        const tsize_t tileSize = TIFFTileSize(tif);
+        if (tileSize <= 0) {
+            errorMessage = "invalid TIFF tile size";
+            return false;
+        }
+        const tsize_t tileRowSize = TIFFTileRowSize(tif);
+        if (tileRowSize <= 0) {
+            errorMessage = "invalid TIFF tile row size";
+            return false;
+        }
+
+        layout.tiled = true;
+        layout.chunkWidth = tileWidth;
+        layout.chunkHeight = tileLength;
+        layout.chunksAcross = (layout.width + tileWidth - 1u) / tileWidth;
+        layout.chunkCount = layout.chunksAcross * ((layout.height + tileLength - 1u) / tileLength);
+        layout.chunkByteSize = static_cast<size_t>(tileSize);
+        layout.chunkRowBytes = static_cast<size_t>(tileRowSize);
+        layout.chunkRowPixels = layout.chunkRowBytes / bytesPerPixel;
+        return true;
+    }
+
+    const tsize_t scanlineSize = TIFFScanlineSize(tif);
+    if (scanlineSize <= 0) {
+        errorMessage = "invalid TIFF scanline size";
+        return false;
+    }
+    const tsize_t stripSize = TIFFStripSize(tif);
+    if (stripSize <= 0) {
+        errorMessage = "invalid TIFF strip size";
+        return false;
+    }
+
+    uint32_t rowsPerStrip = layout.height;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+    layout.chunkWidth = layout.width;
+    layout.chunkHeight = std::max(1u, std::min(rowsPerStrip, layout.height));
+    layout.chunksAcross = 1u;
+    layout.chunkCount = static_cast<uint32_t>(TIFFNumberOfStrips(tif));
+    layout.chunkRowBytes = static_cast<size_t>(scanlineSize);
+    layout.chunkRowPixels = layout.chunkRowBytes / bytesPerPixel;
+
+    // A single-strip image has nothing to split; read it a scanline at a time
+    // instead of buffering a second copy of the whole image.
+    layout.scanlines = layout.chunkCount <= 1u;
+    layout.chunkByteSize = layout.scanlines ? layout.chunkRowBytes : static_cast<size_t>(stripSize);
+    return true;
+}
+
+static bool
+decode_tiff_chunk(TIFF* tif,
+                  const TiffChunkLayout& layout,
+                  const uint32_t chunkIndex,
+                  std::vector<uint8_t>& chunkBuffer,
+                  std::byte* destinationBytes,
+                  std::string& errorMessage)
+{
+    const uint32_t originX = (chunkIndex % layout.chunksAcross) * layout.chunkWidth;
+    const uint32_t originY = (chunkIndex / layout.chunksAcross) * layout.chunkHeight;
+    if (originX >= layout.width || originY >= layout.height) {
+        return true;
+    }
+
+    const size_t copyWidth = std::min(static_cast<size_t>(layout.chunkWidth), static_cast<size_t>(layout.width - originX));
+    const size_t copyHeight =
+        std::min(static_cast<size_t>(layout.chunkHeight), static_cast<size_t>(layout.height - originY));
+
+    if (layout.scanlines) {
+        for (size_t localY = 0u; localY < copyHeight; ++localY) {
+            const uint32_t row = originY + static_cast<uint32_t>(localY);
+            if (TIFFReadScanline(tif, chunkBuffer.data(), row, 0) != 1) {
+                errorMessage = "can't read TIFF scanline";
+                return false;
+            }
+            copy_tiff_interleaved_samples(chunkBuffer.data(),
+                                          layout.chunkRowPixels,
+                                          copyWidth,
+                                          1u,
+                                          static_cast<size_t>(layout.width),
+                                          0u,
+                                          static_cast<size_t>(row),
+                                          layout.samplesPerPixel,
+                                          layout.bitsPerSample,
+                                          layout.photometric,
+                                          layout.componentType,
+                                          destinationBytes);
+        }
+        return true;
+    }
+
+    const tsize_t chunkByteSize = static_cast<tsize_t>(chunkBuffer.size());
+    const tsize_t readSize = layout.tiled ? TIFFReadEncodedTile(tif, chunkIndex, chunkBuffer.data(), chunkByteSize)
+                                          : TIFFReadEncodedStrip(tif, chunkIndex, chunkBuffer.data(), chunkByteSize);
+    if (readSize < 0 || (!layout.tiled && static_cast<size_t>(readSize) < copyHeight * layout.chunkRowBytes)) {
+        errorMessage = layout.tiled ? "can't read TIFF tile" : "can't read TIFF strip";
+        return false;
+    }
+
+    copy_tiff_interleaved_samples(chunkBuffer.data(),
+                                  layout.chunkRowPixels,
+                                  copyWidth,
+                                  copyHeight,
+                                  static_cast<size_t>(layout.width),
+                                  static_cast<size_t>(originX),
+                                  static_cast<size_t>(originY),
+                                  layout.samplesPerPixel,
+                                  layout.bitsPerSample,
+                                  layout.photometric,
+                                  layout.componentType,
+                                  destinationBytes);
+    return true;
+}
+
+static bool
+decode_tiff_chunks(TIFF* tif,
+                   const std::span<const std::byte> sourceBytes,
+                   const bool hasDirectoryIndex,
+                   const uint32_t directoryIndex,
+                   const TiffChunkLayout& layout,
+                   const size_t threadCount,
+                   std::byte* destinationBytes,
+                   std::string& errorMessage)
+{
+    std::atomic<uint32_t> nextChunk { 0u };
+    std::atomic<bool> failed { false };
+    std::mutex errorMutex;
+
+    const auto fail = [&](const std::string& message) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!failed.exchange(true)) {
+            errorMessage = message;
+        }
+    };
+
+    // Each thread decodes whole strips or tiles through its own TIFF handle over
+    // the shared source bytes, so codec state is never shared and chunks land
+    // directly in the final buffer.
+    const auto decodeWithHandle = [&](TIFF* handle) {
+        std::vector<uint8_t> chunkBuffer(layout.chunkByteSize);
+        std::string chunkError;
+        while (!failed.load()) {
+            const uint32_t chunkIndex = nextChunk.fetch_add(1u);
+            if (chunkIndex >= layout.chunkCount) {
+                return;
+            }
+            if (!decode_tiff_chunk(handle, layout, chunkIndex, chunkBuffer, destinationBytes, chunkError)) {
+                fail(chunkError);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t workerCount = std::min(threadCount, static_cast<size_t>(layout.chunkCount));
+    for (size_t workerIndex = 1u; workerIndex < workerCount; ++workerIndex) {
+        try {
+            workers.emplace_back([&]() {
+                MemoryInputCursor cursor { sourceBytes };
+                TIFF* handle = open_tiff_directory(cursor, hasDirectoryIndex, directoryIndex);
+                if (handle == nullptr) {
+                    fail("can't open TIFF file");
+                    return;
+                }
+                decodeWithHandle(handle);
+                TIFFClose(handle);
+            });
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+
+    decodeWithHandle(tif);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return !failed.load();
+}
+
+struct TiffWriteLayout {
+    uint32_t width = 0u;
+    uint32_t height = 0u;
+    uint16_t samplesPerPixel = 1u;
+    uint16_t bitsPerSample = 8u;
+    uint16_t sampleFormat = SAMPLEFORMAT_UINT;
+    uint16_t photometric = PHOTOMETRIC_MINISBLACK;
+    bool hasAlpha = false;
+    bool useTiles = false;
+    uint32_t tileWidth = 0u;
+    uint32_t tileLength = 0u;
+    uint32_t rowsPerStrip = 0u;
+};
+
+static bool
+set_tiff_image_fields(TIFF* tif, const TiffSaveOptions& options, const TiffWriteLayout& layout, std::string& errorMessage)
+{
+    TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, layout.width);
+    TIFFSetField(tif, TIFFTAG_IMAGELENGTH, layout.height);
+    TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, layout.samplesPerPixel);
+    TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, layout.bitsPerSample);
+    TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, layout.sampleFormat);
+    TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, layout.photometric);
+    TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+    TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+    TIFFSetField(tif, TIFFTAG_COMPRESSION, options.compression);
+    return set_tiff_compression_options(tif, options, errorMessage);
+}
+
+static void
+set_tiff_chunk_fields(TIFF* tif, const TiffSaveOptions& options, const TiffWriteLayout& layout)
+{
+    if (layout.useTiles) {
+        TIFFSetField(tif, TIFFTAG_TILEWIDTH, layout.tileWidth);
+        TIFFSetField(tif, TIFFTAG_TILELENGTH, layout.tileLength);
+    } else {
+        TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, layout.rowsPerStrip);
+    }
+
+    if (options.predictor != PREDICTOR_NONE) {
+        TIFFSetField(tif, TIFFTAG_PREDICTOR, options.predictor);
+    }
+
+    if (layout.hasAlpha) {
+        const uint16_t extraSample = options.unassociatedAlpha ? EXTRASAMPLE_UNASSALPHA : EXTRASAMPLE_ASSOCALPHA;
+        TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, 1, &extraSample);
+    }
+}
+
+static void
+fill_tiff_tile_buffer(const std::byte* imageBytes,
+                      const TiffWriteLayout& layout,
+                      const size_t pixelBytes,
+                      const size_t tileRowBytes,
+                      const uint32_t tileX,
+                      const uint32_t tileY,
+                      std::vector<std::byte>& tileBytes)
+{
+    std::fill(tileBytes.begin(), tileBytes.end(), std::byte { 0 });
+
+    const size_t rowBytes = static_cast<size_t>(layout.width) * pixelBytes;
+    const size_t copyWidth = std::min(static_cast<size_t>(layout.tileWidth), static_cast<size_t>(layout.width - tileX));
+    const size_t copyHeight =
+        std::min(static_cast<size_t>(layout.tileLength), static_cast<size_t>(layout.height - tileY));
+    for (size_t localY = 0; localY < copyHeight; ++localY) {
+        const std::byte* sourceRow =
+            imageBytes + (static_cast<size_t>(tileY) + localY) * rowBytes + static_cast<size_t>(tileX) * pixelBytes;
+        std::memcpy(tileBytes.data() + localY * tileRowBytes, sourceRow, copyWidth * pixelBytes);
+    }
+}
+
+static bool
+is_tiff_chunk_compression_independent(const uint16_t compression)
+{
+    // Codecs whose strips/tiles carry no shared directory state (unlike JPEG tables
+    // or LERC parameters) can be compressed out of band and written raw.
+    switch (compression) {
+    case COMPRESSION_LZW:
+    case COMPRESSION_ADOBE_DEFLATE:
+    case COMPRESSION_DEFLATE:
+    case COMPRESSION_PACKBITS:
+#if defined(COMPRESSION_ZSTD)
+    case COMPRESSION_ZSTD:
+#endif
+#if defined(COMPRESSION_LZMA)
+    case COMPRESSION_LZMA:
+#endif
+        return true;
+    default: return false;
+    }
+}
+
+// Scratch TIFF sink that keeps only the bytes appended since the last chunk was
+// taken, so a compressing thread never holds more than one encoded chunk.
+struct TiffChunkSink {
+    uint64_t position = 0u;
+    uint64_t size = 0u;
+    std::vector<std::byte> pending;
+};
+
+static tmsize_t
+tiff_chunk_sink_read(thandle_t, void*, tmsize_t)
+{
+    return 0;
+}
+
+static tmsize_t
+tiff_chunk_sink_write(thandle_t handle, void* data, tmsize_t byteCount)
+{
+    TiffChunkSink& sink = *static_cast<TiffChunkSink*>(handle);
+    if (sink.position >= sink.size) {
+        const std::byte* bytes = static_cast<const std::byte*>(data);
+        sink.pending.insert(sink.pending.end(), bytes, bytes + byteCount);
+    }
+    sink.position += static_cast<uint64_t>(byteCount);
+    sink.size = std::max(sink.size, sink.position);
+    return byteCount;
+}
+
+static toff_t
+tiff_chunk_sink_seek(thandle_t handle, toff_t offset, int whence)
+{
+    TiffChunkSink& sink = *static_cast<TiffChunkSink*>(handle);
+    if (whence == SEEK_END) {
+        sink.position = sink.size + offset;
+    } else if (whence == SEEK_CUR) {
+        sink.position += offset;
+    } else {
+        sink.position = offset;
+    }
+    return sink.position;
+}
+
+static int
+tiff_chunk_sink_close(thandle_t)
+{
+    return 0;
+}
+
+static toff_t
+tiff_chunk_sink_size(thandle_t handle)
+{
+    return static_cast<const TiffChunkSink*>(handle)->size;
+}
+
+static int
+tiff_chunk_sink_map(thandle_t, void**, toff_t*)
+{
+    return 0;
+}
+
+static void
+tiff_chunk_sink_unmap(thandle_t, void*, toff_t)
+{
+}
+
+static bool
+encode_tiff_chunks(TIFF* tif,
+                   const TiffSaveOptions& options,
+                   const TiffWriteLayout& layout,
+                   const size_t threadCount,
+                   std::byte* imageBytes,
+                   const size_t pixelBytes,
+                   const uint32_t firstChunkIndex,
+                   std::string& errorMessage)
+{
+    const tsize_t tileByteCount = layout.useTiles ? TIFFTileSize(tif) : 0;
+    const tsize_t tileRowBytes = layout.useTiles ? TIFFTileRowSize(tif) : 0;
+    if (layout.useTiles && (tileByteCount <= 0 || tileRowBytes <= 0)) {
+        errorMessage = "invalid TIFF tile buffer geometry";
+        return false;
+    }
+
+    const uint32_t chunksAcross = layout.useTiles ? (layout.width + layout.tileWidth - 1u) / layout.tileWidth : 1u;
+    const uint32_t chunkHeight = layout.useTiles ? layout.tileLength : layout.rowsPerStrip;
+    const uint32_t chunkCount = chunksAcross * ((layout.height + chunkHeight - 1u) / chunkHeight);
+    const size_t rowBytes = static_cast<size_t>(layout.width) * pixelBytes;
+
+    std::vector<std::vector<std::byte>> encodedChunks(chunkCount);
+    std::vector<bool> chunkReady(chunkCount, false);
+    std::mutex chunkMutex;
+    std::condition_variable chunkCondition;
+    std::atomic<uint32_t> nextChunk { 0u };
+    bool failed = false;
+    std::string failure;
+
+    const auto fail = [&](const char* message) {
+        std::lock_guard<std::mutex> lock(chunkMutex);
+        if (!failed) {
+            failed = true;
+            failure = message;
+        }
+        chunkCondition.notify_all();
+    };
+
+    // Every worker compresses chunks through a private in-memory TIFF with the
+    // same directory, then hands the encoded bytes to this thread for an
+    // in-order raw write into the real file. `layout` may describe a band of
+    // the image whose chunks start at `firstChunkIndex` in the file.
+    const auto compressChunks = [&]() {
+        TiffChunkSink sink;
+        TIFF* scratch = TIFFClientOpen("rawgl-tiff-chunk",
+                                       "w8",
+                                       &sink,
+                                       tiff_chunk_sink_read,
+                                       tiff_chunk_sink_write,
+                                       tiff_chunk_sink_seek,
+                                       tiff_chunk_sink_close,
+                                       tiff_chunk_sink_size,
+                                       tiff_chunk_sink_map,
+                                       tiff_chunk_sink_unmap);
+        std::string scratchError;
+        if (scratch == nullptr || !set_tiff_image_fields(scratch, options, layout, scratchError)) {
+            if (scratch != nullptr) {
+                TIFFCleanup(scratch);
+            }
+            fail("can't prepare TIFF chunk encoder");
+            return;
+        }
+        set_tiff_chunk_fields(scratch, options, layout);
+
+        std::vector<std::byte> tileBytes(static_cast<size_t>(tileByteCount));
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(chunkMutex);
+                if (failed) {
+                    break;
+                }
+            }
+            const uint32_t chunkIndex = nextChunk.fetch_add(1u);
+            if (chunkIndex >= chunkCount) {
+                break;
+            }
+
+            sink.pending.clear();
+            tsize_t written = 0;
+            if (layout.useTiles) {
+                fill_tiff_tile_buffer(imageBytes,
+                                      layout,
+                                      pixelBytes,
+                                      static_cast<size_t>(tileRowBytes),
+                                      (chunkIndex % chunksAcross) * layout.tileWidth,
+                                      (chunkIndex / chunksAcross) * layout.tileLength,
+                                      tileBytes);
+                written = TIFFWriteEncodedTile(scratch, chunkIndex, tileBytes.data(), tileByteCount);
+            } else {
+                const uint32_t firstRow = chunkIndex * layout.rowsPerStrip;
+                const uint32_t rowCount = std::min(layout.rowsPerStrip, layout.height - firstRow);
+                written = TIFFWriteEncodedStrip(scratch,
+                                                chunkIndex,
+                                                imageBytes + static_cast<size_t>(firstRow) * rowBytes,
+                                                static_cast<tsize_t>(static_cast<size_t>(rowCount) * rowBytes));
+            }
+            if (written < 0) {
+                fail(layout.useTiles ? "can't write TIFF tile" : "can't write TIFF strip");
+                break;
+            }
+
+            std::lock_guard<std::mutex> lock(chunkMutex);
+            encodedChunks[chunkIndex].swap(sink.pending);
+            chunkReady[chunkIndex] = true;
+            chunkCondition.notify_all();
+        }
+
+        TIFFCleanup(scratch);
+    };
+
+    std::vector<std::thread> workers;
+    const size_t workerCount = std::min(threadCount, static_cast<size_t>(chunkCount));
+    for (size_t workerIndex = 0u; workerIndex < workerCount; ++workerIndex) {
+        try {
+            workers.emplace_back(compressChunks);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    if (workers.empty()) {
+        errorMessage = "can't start TIFF encode threads";
+        return false;
+    }
+
+    for (uint32_t chunkIndex = 0u; chunkIndex < chunkCount; ++chunkIndex) {
+        std::vector<std::byte> chunkBytes;
+        {
+            std::unique_lock<std::mutex> lock(chunkMutex);
+            chunkCondition.wait(lock, [&]() { return failed || chunkReady[chunkIndex]; });
+            if (failed) {
+                break;
+            }
+            chunkBytes.swap(encodedChunks[chunkIndex]);
+        }
+
+        const uint32_t fileChunkIndex = firstChunkIndex + chunkIndex;
+        const tsize_t chunkSize = static_cast<tsize_t>(chunkBytes.size());
+        const tsize_t written = layout.useTiles
+                                    ? TIFFWriteRawTile(tif, fileChunkIndex, chunkBytes.data(), chunkSize)
+                                    : TIFFWriteRawStrip(tif, fileChunkIndex, chunkBytes.data(), chunkSize);
+        if (written != chunkSize) {
+            fail(layout.useTiles ? "can't write TIFF tile" : "can't write TIFF strip");
+            break;
+        }
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    if (failed) {
+        errorMessage = failure;
+        return false;
+    }
+    return true;
+}
+
+class TiffStreamEncoder final : public ImageStreamEncoder {
+public:
+    TiffStreamEncoder(const HostImageData& layout,
+                      const ImageEncodeSettings& settings,
+                      const int alphaChannel,
+                      const TiffSaveOptions& options,
+                      const uint32_t threadCount)
+        : m_layout(layout)
+        , m_settings(settings)
+        , m_alphaChannel(alphaChannel)
+        , m_options(options)
+        , m_threadCount(threadCount)
+    {
+    }
+
+    ~TiffStreamEncoder() override
+    {
+        if (m_tif != nullptr) {
+            TIFFClose(m_tif);
+        }
+    }
+
+    TiffStreamEncoder(const TiffStreamEncoder&) = delete;
+    TiffStreamEncoder&
+    operator=(const TiffStreamEncoder&) = delete;
+
+    bool
+    start(const std::string& path, std::string& errorMessage)
+    {
+        int outputChannels = 0;
+        int resolvedAlphaChannel = -1;
+        std::array<int, 4> sourceChannelMap = { 0, 1, 2, 3 };
+        if (!resolve_tiff_channel_layout(
+                m_layout, m_alphaChannel, outputChannels, resolvedAlphaChannel, sourceChannelMap, errorMessage)) {
+            return false;
+        }
+
+        uint16_t bitsPerSample = 0u;
+        uint16_t sampleFormat = SAMPLEFORMAT_UINT;
+        switch (m_settings.componentType) {
+        case ImageComponentType::U8:
+            bitsPerSample = 8u;
+            sampleFormat = SAMPLEFORMAT_UINT;
+            break;
+        case ImageComponentType::U16:
+            bitsPerSample = 16u;
+            sampleFormat = SAMPLEFORMAT_UINT;
+            break;
+        case ImageComponentType::F32:
+            bitsPerSample = 32u;
+            sampleFormat = SAMPLEFORMAT_IEEEFP;
+            break;
+        default: errorMessage = "unsupported TIFF output component type"; return false;
+        }
+
+        const char* openMode = m_options.forceBigTiff ? "w8" : "w";
+        m_tif = TIFFOpen(path.c_str(), openMode);
+        if (m_tif == nullptr) {
+            errorMessage = "can't open TIFF file for writing";
+            return false;
+        }
+
+        const int colorChannels = resolvedAlphaChannel >= 0 ? (outputChannels - 1) : outputChannels;
+        m_writeLayout.width = static_cast<uint32_t>(m_layout.width);
+        m_writeLayout.height = static_cast<uint32_t>(m_layout.height);
+        m_writeLayout.samplesPerPixel = static_cast<uint16_t>(outputChannels);
+        m_writeLayout.bitsPerSample = bitsPerSample;
+        m_writeLayout.sampleFormat = sampleFormat;
+        m_writeLayout.photometric = colorChannels == 1 ? PHOTOMETRIC_MINISBLACK : PHOTOMETRIC_RGB;
+        m_writeLayout.hasAlpha = resolvedAlphaChannel >= 0;
+
+        if (!set_tiff_image_fields(m_tif, m_options, m_writeLayout, errorMessage)) {
+            return false;
+        }
+        if (!resolve_tiff_tile_layout(m_options,
+                                      m_tif,
+                                      m_writeLayout.useTiles,
+                                      m_writeLayout.tileWidth,
+                                      m_writeLayout.tileLength,
+                                      errorMessage)) {
+            return false;
+        }
+        if (!resolve_tiff_strip_layout(
+                m_options, m_tif, m_writeLayout.useTiles, m_writeLayout.rowsPerStrip, errorMessage)) {
+            return false;
+        }
+        set_tiff_chunk_fields(m_tif, m_options, m_writeLayout);
+
+        m_pixelBytes = static_cast<size_t>(outputChannels) * byte_size_for_image_component(m_settings.componentType);
+        m_rowBytes = static_cast<size_t>(m_layout.width) * m_pixelBytes;
+
+        const uint32_t chunkHeight = m_writeLayout.useTiles ? m_writeLayout.tileLength : m_writeLayout.rowsPerStrip;
+        const uint32_t chunksAcross =
+            m_writeLayout.useTiles ? (m_writeLayout.width + m_writeLayout.tileWidth - 1u) / m_writeLayout.tileWidth
+                                   : 1u;
+        const bool multipleChunks = m_writeLayout.useTiles ? (chunksAcross > 1u || m_writeLayout.height > chunkHeight)
+                                                           : m_writeLayout.height > chunkHeight;
+        m_parallel =
+            m_threadCount > 1u && multipleChunks && is_tiff_chunk_compression_independent(m_options.compression);
+
+        // Rows are held back until they fill whole chunks; a parallel band carries
+        // enough chunks to keep every encode thread busy.
+        if (m_parallel) {
+            m_bandRows = chunkHeight * std::max(1u, (m_threadCount + chunksAcross - 1u) / chunksAcross);
+        } else {
+            m_bandRows = m_writeLayout.useTiles ? chunkHeight : 1u;
+        }
+        m_chunksPerBandRow = chunksAcross;
+        return true;
+    }
+
+    bool
+    writeRows(const HostImageData& rows, std::string& errorMessage) override
+    {
+        if (!validate_image_stream_rows(m_layout, static_cast<int>(m_rowsReceived), rows, errorMessage)) {
+            return false;
+        }
+
+        int outputChannels = 0;
+        int resolvedAlphaChannel = -1;
+        std::array<int, 4> sourceChannelMap = { 0, 1, 2, 3 };
+        if (!convert_host_image_to_tiff_bytes(rows,
+                                              m_settings,
+                                              m_alphaChannel,
+                                              outputChannels,
+                                              resolvedAlphaChannel,
+                                              sourceChannelMap,
+                                              m_convertedBytes,
+                                              errorMessage)) {
+            return false;
+        }
+        if (m_pendingRows == 0u) {
+            m_pendingBytes.swap(m_convertedBytes);
+        } else {
+            m_pendingBytes.insert(m_pendingBytes.end(), m_convertedBytes.begin(), m_convertedBytes.end());
+        }
+        m_pendingRows += static_cast<uint32_t>(rows.height);
+        m_rowsReceived += static_cast<uint32_t>(rows.height);
+
+        const bool lastRows = m_rowsReceived == m_writeLayout.height;
+        const uint32_t flushRows = lastRows ? m_pendingRows : (m_pendingRows / m_bandRows) * m_bandRows;
+        if (flushRows == 0u) {
+            return true;
+        }
+        if (!writeBand(flushRows, errorMessage)) {
+            return false;
+        }
+
+        const size_t flushedBytes = static_cast<size_t>(flushRows) * m_rowBytes;
+        m_pendingBytes.erase(m_pendingBytes.begin(),
+                             m_pendingBytes.begin() + static_cast<std::ptrdiff_t>(flushedBytes));
+        m_pendingRows -= flushRows;
+        return true;
+    }
+
+    bool
+    finish(std::string& errorMessage) override
+    {
+        if (m_rowsReceived != m_writeLayout.height) {
+            errorMessage = "TIFF stream finished before every row was written";
+            return false;
+        }
+        TIFFClose(m_tif);
+        m_tif = nullptr;
+        return true;
+    }
+
+private:
+    bool
+    writeBand(const uint32_t rowCount, std::string& errorMessage)
+    {
+        TiffWriteLayout bandLayout = m_writeLayout;
+        bandLayout.height = rowCount;
+
+        if (m_parallel) {
+            const uint32_t chunkHeight = m_writeLayout.useTiles ? m_writeLayout.tileLength : m_writeLayout.rowsPerStrip;
+            const uint32_t firstChunkIndex = (m_rowsWritten / chunkHeight) * m_chunksPerBandRow;
+            if (!encode_tiff_chunks(m_tif,
+                                    m_options,
+                                    bandLayout,
+                                    m_threadCount,
+                                    m_pendingBytes.data(),
+                                    m_pixelBytes,
+                                    firstChunkIndex,
+                                    errorMessage)) {
+                return false;
+            }
+        } else if (m_writeLayout.useTiles) {
+            const tsize_t tileByteCountSigned = TIFFTileSize(m_tif);
+            const tsize_t tileRowBytesSigned = TIFFTileRowSize(m_tif);
+            if (tileByteCountSigned <= 0 || tileRowBytesSigned <= 0) {
+                errorMessage = "invalid TIFF tile buffer geometry";
+                return false;
+            }
+
+            m_tileBytes.resize(static_cast<size_t>(tileByteCountSigned));
+            for (uint32_t tileY = 0u; tileY < bandLayout.height; tileY += bandLayout.tileLength) {
+                for (uint32_t tileX = 0u; tileX < bandLayout.width; tileX += bandLayout.tileWidth) {
+                    fill_tiff_tile_buffer(m_pendingBytes.data(),
+                                          bandLayout,
+                                          m_pixelBytes,
+                                          static_cast<size_t>(tileRowBytesSigned),
+                                          tileX,
+                                          tileY,
+                                          m_tileBytes);
+
+                    const ttile_t tileIndex = TIFFComputeTile(m_tif, tileX, m_rowsWritten + tileY, 0u, 0u);
+                    if (TIFFWriteEncodedTile(m_tif, tileIndex, m_tileBytes.data(), tileByteCountSigned) < 0) {
+                        errorMessage = "can't write TIFF tile";
+                        return false;
+                    }
+                }
+            }
+        } else {
+            for (uint32_t row = 0u; row < rowCount; ++row) {
+                std::byte* rowData = m_pendingBytes.data() + static_cast<size_t>(row) * m_rowBytes;
+                if (TIFFWriteScanline(m_tif, rowData, m_rowsWritten + row, 0) != 1) {
+                    errorMessage = "can't write TIFF scanline";
+                    return false;
+                }
+            }
+        }
+
+        m_rowsWritten += rowCount;
+        return true;
+    }
+
+    HostImageData m_layout;
+    ImageEncodeSettings m_settings;
+    int m_alphaChannel = -1;
+    TiffSaveOptions m_options;
+    uint32_t m_threadCount = 1u;
+    TIFF* m_tif = nullptr;
+    TiffWriteLayout m_writeLayout;
+    size_t m_pixelBytes = 0u;
+    size_t m_rowBytes = 0u;
+    bool m_parallel = false;
+    uint32_t m_bandRows = 1u;
+    uint32_t m_chunksPerBandRow = 1u;
+    uint32_t m_rowsReceived = 0u;
+    uint32_t m_rowsWritten = 0u;
+    uint32_t m_pendingRows = 0u;
+    std::vector<std::byte> m_pendingBytes;
+    std::vector<std::byte> m_convertedBytes;
+    std::vector<std::byte> m_tileBytes;
+};
 #endif
 
 }  // namespace
 
 DecodedImageData
 decode_tiff_file(const std::string& path, const std::map<std::string, std::string>& attributes)
+{
+    MappedFile mappedFile;
+    DecodedImageData result;
+    if (!mappedFile.open(path, result.errorMessage)) {
+        result.errorMessage = "can't open TIFF file";
+        return result;
+    }
+    return decode_tiff_memory(mappedFile.bytes(), attributes);
+}
+
+DecodedImageData
+decode_tiff_memory(const std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes)
 {
     DecodedImageData result;
 
 #if !defined(RAWGL_HAS_LIBTIFF)
-    (void)path;
+    (void)bytes;
     (void)attributes;
     result.errorMessage = "libtiff support is not available";
     return result;
 #else
-    TIFF* tif = TIFFOpen(path.c_str(), "r");
-    if (tif == nullptr) {
-        result.errorMessage = "can't open TIFF file";
-        return result;
-    }
-
     uint32_t directoryIndex = 0u;
     bool hasDirectoryIndex = false;
     std::string errorMessage;
@@ -1174,10 +2042,33 @@ decode_tiff_file(const std::string& path, const std::map<std::string, std::strin
                              directoryIndex,
                              "invalid TIFF directory index",
                              errorMessage)) {
-        TIFFClose(tif);
         result.errorMessage = errorMessage;
         return result;
     }
+
+    uint32_t threadCount = 1u;
+    bool hasThreadCount = false;
+    if (!parse_u32_attribute(attributes,
+                             { "tiff:threads", "rawgl:decode_threads" },
+                             1u,
+                             4096u,
+                             hasThreadCount,
+                             threadCount,
+                             "invalid TIFF decode thread count",
+                             errorMessage)) {
+        result.errorMessage = errorMessage;
+        return result;
+    }
+    if (!hasThreadCount) {
+        threadCount = 1u;
+    }
+
+    MemoryInputCursor cursor { bytes };
+    TIFF* tif = open_tiff_memory(cursor);
+    if (tif == nullptr) {
+        result.errorMessage = "can't open TIFF file";
+        return result;
+    }
     if (hasDirectoryIndex && TIFFSetDirectory(tif, static_cast<tdir_t>(directoryIndex)) != 1) {
         TIFFClose(tif);
         result.errorMessage = "requested TIFF directory was not found";
@@ -1221,10 +2112,16 @@ decode_tiff_file(const std::string& path, const std::map<std::string, std::strin
         return result;
     }
 
-    const tsize_t scanlineSize = TIFFScanlineSize(tif);
-    if (scanlineSize <= 0) {
+    TiffChunkLayout layout;
+    layout.width = width;
+    layout.height = height;
+    layout.samplesPerPixel = samplesPerPixel;
+    layout.bitsPerSample = bitsPerSample;
+    layout.photometric = photometric;
+    layout.componentType = componentType;
+    if (!resolve_tiff_chunk_layout(tif, layout, errorMessage)) {
         TIFFClose(tif);
-        result.errorMessage = "invalid TIFF scanline size";
+        result.errorMessage = errorMessage;
         return result;
     }
 
@@ -1236,83 +2133,18 @@ decode_tiff_file(const std::string& path, const std::map<std::string, std::strin
     result.bytes.resize(static_cast<size_t>(width) * static_cast<size_t>(height)
                         * static_cast<size_t>(samplesPerPixel) * bytesPerComponent);
 
-    std::vector<uint8_t> rowBuffer(static_cast<size_t>(scanlineSize));
-    if (TIFFIsTiled(tif) != 0) {
-        uint32_t tileWidth = 0u;
-        uint32_t tileLength = 0u;
-        TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileWidth);
-        TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileLength);
-        if (tileWidth == 0u || tileLength == 0u) {
-            TIFFClose(tif);
-            result.errorMessage = "invalid TIFF tile geometry";
-            return result;
-        }
-
-        const tsize_t tileSize = TIFFTileSize(tif);
-        const tsize_t tileRowSize = TIFFTileRowSize(tif);
-        if (tileSize <= 0) {
-            TIFFClose(tif);
-            result.errorMessage = "invalid TIFF tile size";
-            return result;
-        }
-        if (tileRowSize <= 0) {
-            TIFFClose(tif);
-            result.errorMessage = "invalid TIFF tile row size";
-            return result;
-        }
-
-        std::vector<uint8_t> tileBuffer(static_cast<size_t>(tileSize));
-        for (uint32_t tileY = 0u; tileY < height; tileY += tileLength) {
-            for (uint32_t tileX = 0u; tileX < width; tileX += tileWidth) {
-                const ttile_t tileIndex = TIFFComputeTile(tif, tileX, tileY, 0u, 0u);
-                if (TIFFReadEncodedTile(tif, tileIndex, tileBuffer.data(), tileSize) < 0) {
-                    TIFFClose(tif);
-                    result = DecodedImageData();
-                    result.errorMessage = "can't read TIFF tile";
-                    return result;
-                }
-
-                const size_t copyWidth = std::min(static_cast<size_t>(tileWidth), static_cast<size_t>(width - tileX));
-                const size_t copyHeight =
-                    std::min(static_cast<size_t>(tileLength), static_cast<size_t>(height - tileY));
-                const size_t tilePixelsPerRow = static_cast<size_t>(tileRowSize)
-                                                / (static_cast<size_t>(samplesPerPixel) * bytesPerComponent);
-                copy_tiff_interleaved_samples(tileBuffer.data(),
-                                              tilePixelsPerRow,
-                                              copyWidth,
-                                              copyHeight,
-                                              static_cast<size_t>(width),
-                                              static_cast<size_t>(tileX),
-                                              static_cast<size_t>(tileY),
-                                              samplesPerPixel,
-                                              bitsPerSample,
-                                              photometric,
-                                              componentType,
-                                              result.bytes.data());
-            }
-        }
-    } else {
-        for (uint32_t row = 0u; row < height; ++row) {
-            if (TIFFReadScanline(tif, rowBuffer.data(), row, 0) != 1) {
-                TIFFClose(tif);
-                result = DecodedImageData();
-                result.errorMessage = "can't read TIFF scanline";
-                return result;
-            }
-
-            copy_tiff_interleaved_samples(rowBuffer.data(),
-                                          static_cast<size_t>(width),
-                                          static_cast<size_t>(width),
-                                          1u,
-                                          static_cast<size_t>(width),
-                                          0u,
-                                          static_cast<size_t>(row),
-                                          samplesPerPixel,
-                                          bitsPerSample,
-                                          photometric,
-                                          componentType,
-                                          result.bytes.data());
-        }
+    if (!decode_tiff_chunks(tif,
+                            bytes,
+                            hasDirectoryIndex,
+                            directoryIndex,
+                            layout,
+                            static_cast<size_t>(threadCount),
+                            result.bytes.data(),
+                            errorMessage)) {
+        TIFFClose(tif);
+        result = DecodedImageData();
+        result.errorMessage = errorMessage;
+        return result;
     }
 
     TIFFClose(tif);
@@ -1328,170 +2160,66 @@ encode_tiff_file(const std::string& path,
                  const HostImageData& image,
                  const ImageEncodeSettings& settings,
                  std::string& errorMessage)
+{
+    std::unique_ptr<ImageStreamEncoder> encoder =
+        begin_tiff_stream_encode(path, attributes, alphaChannel, image, settings, errorMessage);
+    if (!encoder) {
+        return false;
+    }
+    return encoder->writeRows(image, errorMessage) && encoder->finish(errorMessage);
+}
+
+std::unique_ptr<ImageStreamEncoder>
+begin_tiff_stream_encode(const std::string& path,
+                         const std::map<std::string, std::string>& attributes,
+                         int alphaChannel,
+                         const HostImageData& layout,
+                         const ImageEncodeSettings& settings,
+                         std::string& errorMessage)
 {
 #if !defined(RAWGL_HAS_LIBTIFF)
     (void)path;
     (void)attributes;
     (void)alphaChannel;
-    (void)image;
+    (void)layout;
     (void)settings;
     errorMessage = "libtiff support is not available";
-    return false;
+    return nullptr;
 #else
     TiffSaveOptions options;
     if (!parse_tiff_save_options(attributes, settings.componentType, options, errorMessage)) {
-        return false;
-    }
-
-    bool useTiles = false;
-    uint32_t tileWidth = 0u;
-    uint32_t tileLength = 0u;
-    uint32_t rowsPerStrip = 0u;
-    int outputChannels = 0;
-    int resolvedAlphaChannel = -1;
-    std::array<int, 4> sourceChannelMap = { 0, 1, 2, 3 };
-    std::vector<std::byte> encodedBytes;
-    if (!convert_host_image_to_tiff_bytes(image,
-                                          settings,
-                                          alphaChannel,
-                                          outputChannels,
-                                          resolvedAlphaChannel,
-                                          sourceChannelMap,
-                                          encodedBytes,
-                                          errorMessage)) {
-        return false;
-    }
-
-    const char* openMode = options.forceBigTiff ? "w8" : "w";
-    TIFF* tif = TIFFOpen(path.c_str(), openMode);
-    if (tif == nullptr) {
-        errorMessage = "can't open TIFF file for writing";
-        return false;
-    }
-
-    const int colorChannels = resolvedAlphaChannel >= 0 ? (outputChannels - 1) : outputChannels;
-    const uint16_t photometric = colorChannels == 1 ? PHOTOMETRIC_MINISBLACK : PHOTOMETRIC_RGB;
-    const uint16_t samplesPerPixel = static_cast<uint16_t>(outputChannels);
-
-    uint16_t bitsPerSample = 0u;
-    uint16_t sampleFormat = SAMPLEFORMAT_UINT;
-    switch (settings.componentType) {
-    case ImageComponentType::U8:
-        bitsPerSample = 8u;
-        sampleFormat = SAMPLEFORMAT_UINT;
-        break;
-    case ImageComponentType::U16:
-        bitsPerSample = 16u;
-        sampleFormat = SAMPLEFORMAT_UINT;
-        break;
-    case ImageComponentType::F32:
-        bitsPerSample = 32u;
-        sampleFormat = SAMPLEFORMAT_IEEEFP;
-        break;
-    default:
-        TIFFClose(tif);
-        errorMessage = "unsupported TIFF output component type";
-        return false;
-    }
-
-    TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, static_cast<uint32_t>(image.width));
-    TIFFSetField(tif, TIFFTAG_IMAGELENGTH, static_cast<uint32_t>(image.height));
-    TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, samplesPerPixel);
-    TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerSample);
-    TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, sampleFormat);
-    TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, photometric);
-    TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
-    TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
-    TIFFSetField(tif, TIFFTAG_COMPRESSION, options.compression);
-
-    if (!set_tiff_compression_options(tif, options, errorMessage)) {
-        TIFFClose(tif);
-        return false;
-    }
-
-    if (!resolve_tiff_tile_layout(options, tif, useTiles, tileWidth, tileLength, errorMessage)) {
-        TIFFClose(tif);
-        return false;
-    }
-    if (!resolve_tiff_strip_layout(options, tif, useTiles, rowsPerStrip, errorMessage)) {
-        TIFFClose(tif);
-        return false;
-    }
-
-    if (useTiles) {
-        TIFFSetField(tif, TIFFTAG_TILEWIDTH, tileWidth);
-        TIFFSetField(tif, TIFFTAG_TILELENGTH, tileLength);
-    } else {
-        TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+        return nullptr;
     }
 
-    if (options.predictor != PREDICTOR_NONE) {
-        TIFFSetField(tif, TIFFTAG_PREDICTOR, options.predictor);
+    uint32_t threadCount = 1u;
+    bool hasThreadCount = false;
+    if (!parse_u32_attribute(attributes,
+                             { "tiff:threads", "rawgl:encode_threads" },
+                             1u,
+                             4096u,
+                             hasThreadCount,
+                             threadCount,
+                             "invalid TIFF encode thread count",
+                             errorMessage)) {
+        return nullptr;
     }
-
-    if (resolvedAlphaChannel >= 0) {
-        const uint16_t extraSample = options.unassociatedAlpha ? EXTRASAMPLE_UNASSALPHA : EXTRASAMPLE_ASSOCALPHA;
-        TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, 1, &extraSample);
+    if (!hasThreadCount) {
+        threadCount = 1u;
     }
 
-    const size_t rowBytes = static_cast<size_t>(image.width) * static_cast<size_t>(outputChannels)
-                            * byte_size_for_image_component(settings.componentType);
-
-    if (useTiles) {
-        const tsize_t tileByteCountSigned = TIFFTileSize(tif);
-        const tsize_t tileRowBytesSigned = TIFFTileRowSize(tif);
-        if (tileByteCountSigned <= 0 || tileRowBytesSigned <= 0) {
-            TIFFClose(tif);
-            errorMessage = "invalid TIFF tile buffer geometry";
-            return false;
-        }
-
-        const size_t tileByteCount = static_cast<size_t>(tileByteCountSigned);
-        const size_t tileRowBytes = static_cast<size_t>(tileRowBytesSigned);
-        std::vector<std::byte> tileBytes(tileByteCount);
-
-        for (uint32_t tileY = 0u; tileY < static_cast<uint32_t>(image.height); tileY += tileLength) {
-            for (uint32_t tileX = 0u; tileX < static_cast<uint32_t>(image.width); tileX += tileWidth) {
-                std::fill(tileBytes.begin(), tileBytes.end(), std::byte { 0 });
-
-                const size_t copyWidth =
-                    std::min(static_cast<size_t>(tileWidth), static_cast<size_t>(image.width) - static_cast<size_t>(tileX));
-                const size_t copyHeight = std::min(
-                    static_cast<size_t>(tileLength), static_cast<size_t>(image.height) - static_cast<size_t>(tileY));
-
-                for (size_t localY = 0; localY < copyHeight; ++localY) {
-                    const std::byte* sourceRow =
-                        encodedBytes.data() + (static_cast<size_t>(tileY) + localY) * rowBytes
-                        + static_cast<size_t>(tileX) * static_cast<size_t>(outputChannels)
-                              * byte_size_for_image_component(settings.componentType);
-                    std::byte* destinationRow = tileBytes.data() + localY * tileRowBytes;
-                    std::memcpy(destinationRow,
-                                sourceRow,
-                                copyWidth * static_cast<size_t>(outputChannels)
-                                    * byte_size_for_image_component(settings.componentType));
-                }
+    HostImageData streamLayout;
+    streamLayout.width = layout.width;
+    streamLayout.height = layout.height;
+    streamLayout.channels = layout.channels;
+    streamLayout.alphaChannel = layout.alphaChannel;
+    streamLayout.glInternalFormat = layout.glInternalFormat;
+    streamLayout.glType = layout.glType;
 
-                const ttile_t tileIndex = TIFFComputeTile(tif, tileX, tileY, 0u, 0u);
-                if (TIFFWriteEncodedTile(tif, tileIndex, tileBytes.data(), tileByteCountSigned) < 0) {
-                    TIFFClose(tif);
-                    errorMessage = "can't write TIFF tile";
-                    return false;
-                }
-            }
-        }
-    } else {
-        for (int row = 0; row < image.height; ++row) {
-            std::byte* rowData = encodedBytes.data() + static_cast<size_t>(row) * rowBytes;
-            if (TIFFWriteScanline(tif, rowData, static_cast<uint32_t>(row), 0) != 1) {
-                TIFFClose(tif);
-                errorMessage = "can't write TIFF scanline";
-                return false;
-            }
-        }
+    auto encoder = std::make_unique<TiffStreamEncoder>(streamLayout, settings, alphaChannel, options, threadCount);
+    if (!encoder->start(path, errorMessage)) {
+        return nullptr;
     }
-
-    TIFFClose(tif);
-    return true;
+    return encoder;
 #endif
 }
 
@@ -5,7 +5,10 @@
 
 #include "image_backend.h"
 
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 
 namespace rawgl::io {
@@ -13,6 +16,9 @@ namespace rawgl::io {
 DecodedImageData
 decode_tiff_file(const std::string& path, const std::map<std::string, std::string>& attributes = {});
 
+DecodedImageData
+decode_tiff_memory(std::span<const std::byte> bytes, const std::map<std::string, std::string>& attributes = {});
+
 bool
 encode_tiff_file(const std::string& path,
                  const std::map<std::string, std::string>& attributes,
@@ -21,4 +27,13 @@ encode_tiff_file(const std::string& path,
                  const ImageEncodeSettings& settings,
                  std::string& errorMessage);
 
+/// Starts a row-band TIFF encode; see \ref begin_image_stream_encode.
+std::unique_ptr<ImageStreamEncoder>
+begin_tiff_stream_encode(const std::string& path,
+                         const std::map<std::string, std::string>& attributes,
+                         int alphaChannel,
+                         const HostImageData& layout,
+                         const ImageEncodeSettings& settings,
+                         std::string& errorMessage);
+
 }  // namespace rawgl::io
@@ -9,8 +9,10 @@ single-pass render and compute workflows.
 from __future__ import annotations
 
 from collections.abc import Mapping, Sequence
+from concurrent.futures import Future
 from pathlib import Path
 import re
+import threading
 
 from . import _rawgl as _impl  # noqa: F401
 from ._rawgl import *  # noqa: F401,F403
@@ -52,6 +54,7 @@ _OUTPUT_SPEC_KEYS = frozenset({
     "bits",
     "capture_to_host",
     "capture",
+    "capture_sample_type",
     "persistent_texture_name",
     "attributes",
     "attrs",
@@ -284,8 +287,14 @@ def _numpy_gl_type(dtype) -> int:
     raise TypeError(f"unsupported numpy dtype for host image conversion: {dtype}")
 
 
-def make_host_image(array):
-    """Create HostImageData from a HxW or HxWxC NumPy array."""
+def make_host_image(array, *, copy: bool = True):
+    """Create HostImageData from a HxW or HxWxC NumPy array.
+
+    The pixels are copied by default, so later changes to ``array`` do not
+    reach queued or cloned requests. Pass ``copy=False`` to adopt a
+    C-contiguous array without copying; it must then stay unmodified while the
+    image is in use.
+    """
 
     np_module = _require_numpy()
     array = np_module.asarray(array)
@@ -305,7 +314,11 @@ def make_host_image(array):
     if gl_internal_format is None:
         raise TypeError("unsupported numpy dtype/channel combination for host image conversion")
 
-    contiguous = np_module.ascontiguousarray(array)
+    if copy:
+        contiguous = np_module.array(array, order="C", copy=True)
+        contiguous.setflags(write=False)
+    else:
+        contiguous = np_module.ascontiguousarray(array)
     image = HostImageData()
     image.width = int(width)
     image.height = int(height)
@@ -313,7 +326,7 @@ def make_host_image(array):
     image.alpha_channel = 3 if channels == 4 else -1
     image.gl_internal_format = int(gl_internal_format)
     image.gl_type = int(gl_type)
-    image.bytes = contiguous.tobytes()
+    image.adopt_buffer(contiguous)
     return image
 
 
@@ -436,38 +449,29 @@ def make_host_mesh(
     return mesh
 
 
-def host_image_to_array(image):
-    """Convert HostImageData bytes into a NumPy array."""
+def host_image_to_array(image, *, copy: bool = False):
+    """Return HostImageData pixels as a HxW or HxWxC NumPy array.
 
-    np_module = _require_numpy()
-    dtype_map = {
-        _GL_UNSIGNED_BYTE: np_module.uint8,
-        _GL_UNSIGNED_SHORT: np_module.uint16,
-        _GL_UNSIGNED_INT: np_module.uint32,
-        _GL_FLOAT: np_module.float32,
-        _GL_HALF_FLOAT: np_module.float16,
-    }
-    dtype = dtype_map.get(int(image.gl_type))
-    if dtype is None:
-        raise TypeError(f"unsupported HostImageData gl_type for NumPy conversion: {image.gl_type}")
-
-    values = np_module.frombuffer(image.bytes, dtype=dtype)
-    expected_size = int(image.width) * int(image.height) * int(image.channels)
-    if values.size != expected_size:
-        raise RuntimeError(
-            f"HostImageData byte payload size mismatch: expected {expected_size} values, found {values.size}"
-        )
-    if int(image.channels) == 1:
-        return values.reshape((int(image.height), int(image.width))).copy()
-    return values.reshape((int(image.height), int(image.width), int(image.channels))).copy()
+    By default the array is a read-only view that keeps the pixels alive on its
+    own; pass ``copy=True`` for an independent, writable array.
+    """
 
+    _require_numpy()
+    array = image.as_array()
+    return array.copy() if copy else array
 
-def captured_output_arrays(result):
-    """Convert all captured host outputs in a RunResult into NumPy arrays."""
 
-    return {
-        name: host_image_to_array(image) for name, image in result.captured_outputs.items()
-    }
+def captured_output_arrays(result, *, copy: bool = False):
+    """Return all captured host outputs in a RunResult as NumPy arrays.
+
+    The arrays view the result's capture storage unless ``copy=True``.
+    """
+
+    _require_numpy()
+    arrays = getattr(result, "raw_result", result).captured_output_arrays()
+    if copy:
+        return {name: array.copy() for name, array in arrays.items()}
+    return arrays
 
 
 def captured_counter_values(result):
@@ -502,7 +506,8 @@ def save_image(
         raise RuntimeError("rawgl.save_image() requires the core Python bindings")
 
     if _is_numpy_array(image):
-        host_image = make_host_image(image)
+        # The save finishes before returning and the request is not kept, so the array can be adopted.
+        host_image = make_host_image(image, copy=False)
     elif isinstance(image, HostImageData):
         host_image = image
     else:
@@ -551,7 +556,7 @@ def transfer_image_metadata(path, source_metadata, *, target_image=None, safety=
         request.safety = safety
     if target_image is not None:
         if _is_numpy_array(target_image):
-            request.target_image = make_host_image(target_image)
+            request.target_image = make_host_image(target_image, copy=False)
         elif isinstance(target_image, HostImageData):
             request.target_image = target_image
         else:
@@ -587,6 +592,28 @@ def load_image(path, *, attributes=None, codec_options=None, io_runtime=None):
     return result.image
 
 
+def load_image_memory(data, *, name_hint=None, attributes=None, codec_options=None, io_runtime=None):
+    """Decode one encoded image held in a bytes-like object into HostImageData through rawgl.io."""
+
+    io_runtime_type = globals().get("IoRuntime")
+    if io_runtime_type is None:
+        raise RuntimeError("rawgl.load_image_memory() requires the core Python bindings")
+
+    if io_runtime is None:
+        io_runtime = io_runtime_type()
+
+    kwargs = {"attributes": _coerce_attributes(attributes)}
+    if name_hint is not None:
+        kwargs["name_hint"] = str(name_hint)
+    if codec_options is not None:
+        kwargs["codec_options"] = codec_options
+
+    result = io_runtime.load_image_memory(data, **kwargs)
+    if not result.success:
+        raise RuntimeError(result.error_message or "failed to decode in-memory image")
+    return result.image
+
+
 def image_io_capabilities():
     """Return image IO capabilities for the loaded RawGL extension build."""
 
@@ -763,6 +790,15 @@ def _coerce_input_binding(name, spec):
     return _apply_input_scalar_or_sequence(binding, name, spec)
 
 
+def _coerce_capture_sample_type(value):
+    if isinstance(value, CaptureSampleType):
+        return value
+    sample_type = getattr(CaptureSampleType, str(value), None)
+    if not isinstance(sample_type, CaptureSampleType):
+        raise ValueError(f"unsupported capture_sample_type '{value}'")
+    return sample_type
+
+
 def _coerce_output_binding(name, spec):
     if isinstance(spec, OutputBinding):
         return spec
@@ -780,6 +816,8 @@ def _coerce_output_binding(name, spec):
     binding.alpha_channel = int(spec.get("alpha_channel", binding.alpha_channel))
     binding.bits = int(spec.get("bits", binding.bits))
     binding.capture_to_host = bool(spec.get("capture_to_host", spec.get("capture", False)))
+    if "capture_sample_type" in spec:
+        binding.capture_sample_type = _coerce_capture_sample_type(spec["capture_sample_type"])
     binding.persistent_texture_name = str(spec.get("persistent_texture_name", binding.persistent_texture_name))
     if "array_element" in spec:
         binding.uses_array_element = True
@@ -2121,13 +2159,50 @@ class BatchJobHandleView:
 
     def __init__(self, handle):
         self._handle = handle
+        self._future = None
 
     @property
     def raw_handle(self):
         return self._handle
 
-    def wait(self):
-        return BatchResultView(self._handle.wait())
+    def done(self):
+        return self._handle.is_ready()
+
+    def wait(self, timeout=None):
+        """Wait for the job; with ``timeout`` seconds, return None while it is still pending."""
+
+        if timeout is None:
+            return BatchResultView(self._handle.wait())
+        result = self._handle.wait_for(float(timeout))
+        return None if result is None else BatchResultView(result)
+
+    def future(self):
+        """Return a concurrent.futures.Future resolved with this job's BatchResultView.
+
+        A daemon thread waits on the job with the GIL released. Failed jobs
+        resolve normally; check ``success`` on the result. Use
+        ``asyncio.wrap_future`` or ``await handle`` from asyncio code.
+        """
+
+        if self._future is None:
+            future = Future()
+            future.set_running_or_notify_cancel()
+            handle = self._handle
+
+            def resolve():
+                try:
+                    future.set_result(BatchResultView(handle.wait()))
+                except BaseException as exc:
+                    future.set_exception(exc)
+
+            threading.Thread(target=resolve, name="rawgl-batch-job", daemon=True).start()
+            self._future = future
+        return self._future
+
+    def __await__(self):
+        import asyncio
+
+        return asyncio.wrap_future(self.future()).__await__()
 
     def close(self):
         self._handle = None
@@ -2225,6 +2300,22 @@ class BatchRunnerView:
     def io_runtime(self):
         return self._io_runtime
 
+    def wait_next_completed(self):
+        result = self._runner.wait_next_completed()
+        return None if result is None else BatchResultView(result)
+
+    def completed(self):
+        """Yield finished jobs until every submitted job has been delivered."""
+
+        while True:
+            result = self.wait_next_completed()
+            if result is None:
+                return
+            yield result
+
+    def drain(self):
+        return [BatchResultView(result) for result in self._runner.drain()]
+
     def close(self):
         runner = self._runner
         if runner is not None and hasattr(runner, "close"):
@@ -2404,6 +2495,8 @@ class _IoNamespace:
     def __init__(self):
         self.Runtime = globals().get("IoRuntime")
         self.RuntimeOptions = globals().get("IoRuntimeOptions")
+        self.TiledRunRequest = globals().get("TiledRunRequest")
+        self.TiledRunResult = globals().get("TiledRunResult")
         self.MetadataNameStyle = globals().get("MetadataNameStyle")
         self.MetadataNamePolicy = globals().get("MetadataNamePolicy")
         self.MetadataKeyKind = globals().get("MetadataKeyKind")
@@ -2427,6 +2520,7 @@ class _IoNamespace:
         self.ImageIoCapabilities = globals().get("ImageIoCapabilities")
         self.ImageLoadBackendPolicy = globals().get("ImageLoadBackendPolicy")
         self.JpegLoadColorTransform = globals().get("JpegLoadColorTransform")
+        self.JpegDctMethod = globals().get("JpegDctMethod")
         self.JpegLoadOptions = globals().get("JpegLoadOptions")
         self.PngLoadOptions = globals().get("PngLoadOptions")
         self.TiffLoadOptions = globals().get("TiffLoadOptions")
@@ -2464,6 +2558,15 @@ class _IoNamespace:
             io_runtime=self._resolve_runtime(io_runtime),
         )
 
+    def load_image_memory(self, data, *, name_hint=None, attributes=None, codec_options=None, io_runtime=None):
+        return load_image_memory(
+            data,
+            name_hint=name_hint,
+            attributes=attributes,
+            codec_options=codec_options,
+            io_runtime=self._resolve_runtime(io_runtime),
+        )
+
     def save_image(
         self,
         image,
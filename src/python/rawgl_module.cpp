@@ -2,15 +2,21 @@
 // Copyright (c) 2022-2026 Erium Vladlen.
 
 #include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
 #include <nanobind/stl/array.h>
 #include <nanobind/stl/map.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/shared_ptr.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <new>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -68,7 +74,7 @@ rawgl_python_call(Callback&& callback)
 }
 
 nb::bytes
-to_python_bytes(const std::vector<std::byte>& data)
+to_python_bytes(std::span<const std::byte> data)
 {
     if (data.empty()) {
         return nb::bytes();
@@ -336,17 +342,144 @@ std::vector<float>
 host_image_to_rgba32f(const rawgl::HostImageData& image)
 {
     std::vector<float> values;
-    if (image.bytes.empty()) {
+    const std::span<const std::byte> pixels = image.pixelBytes();
+    if (pixels.empty()) {
         return values;
     }
-    if (image.bytes.size() % sizeof(float) != 0u) {
+    if (pixels.size() % sizeof(float) != 0u) {
         throw std::runtime_error("Host image byte payload is not float-aligned");
     }
-    values.resize(image.bytes.size() / sizeof(float));
-    std::memcpy(values.data(), image.bytes.data(), image.bytes.size());
+    values.resize(pixels.size() / sizeof(float));
+    std::memcpy(values.data(), pixels.data(), pixels.size());
     return values;
 }
 
+nb::dlpack::dtype
+host_image_numpy_dtype(const unsigned int glType)
+{
+    switch (glType) {
+    case 0x1401u: return nb::dtype<uint8_t>();   // GL_UNSIGNED_BYTE
+    case 0x1403u: return nb::dtype<uint16_t>();  // GL_UNSIGNED_SHORT
+    case 0x1405u: return nb::dtype<uint32_t>();  // GL_UNSIGNED_INT
+    case 0x1406u: return nb::dtype<float>();     // GL_FLOAT
+    case 0x140Bu:                                // GL_HALF_FLOAT
+        return nb::dlpack::dtype { static_cast<uint8_t>(nb::dlpack::dtype_code::Float), 16, 1 };
+    default: throw nb::type_error("unsupported HostImageData gl_type for NumPy conversion");
+    }
+}
+
+void
+release_shared_pixels_capsule(void* pointer) noexcept
+{
+    delete static_cast<std::shared_ptr<const std::byte>*>(pointer);
+}
+
+// Moves owned pixels into refcounted storage so NumPy views keep them alive on their own.
+void
+share_host_image_pixels(rawgl::HostImageData& image)
+{
+    if (image.sharedBytes || image.bytes.empty()) {
+        return;
+    }
+
+    auto storage          = std::make_shared<std::vector<std::byte>>(std::move(image.bytes));
+    image.sharedByteCount = storage->size();
+    image.sharedBytes     = std::shared_ptr<const std::byte>(storage, storage->data());
+    image.bytes           = std::vector<std::byte>();
+}
+
+nb::object
+host_image_array_view(rawgl::HostImageData& image)
+{
+    share_host_image_pixels(image);
+
+    const nb::dlpack::dtype dtype = host_image_numpy_dtype(image.glType);
+    const std::span<const std::byte> pixels = image.pixelBytes();
+    const size_t width = static_cast<size_t>(std::max(image.width, 0));
+    const size_t height = static_cast<size_t>(std::max(image.height, 0));
+    const size_t channels = static_cast<size_t>(std::max(image.channels, 0));
+    if (pixels.size() != width * height * channels * (dtype.bits / 8u)) {
+        throw std::runtime_error("HostImageData byte payload size does not match width, height, channels, and gl_type");
+    }
+
+    // Each view holds its own reference to the pixels, so reassigning the image or its owner never frees them.
+    const nb::object arrayOwner =
+        nb::capsule(new std::shared_ptr<const std::byte>(image.sharedBytes), &release_shared_pixels_capsule);
+
+    const size_t shape[3] = { height, width, channels };
+    nb::ndarray<nb::numpy> array(const_cast<std::byte*>(pixels.data()),
+                                 channels == 1u ? 2u : 3u,
+                                 shape,
+                                 arrayOwner,
+                                 nullptr,
+                                 dtype);
+    nb::object result = nb::cast(array);
+    result.attr("setflags")(nb::arg("write") = false);
+    return result;
+}
+
+int
+release_adopted_python_buffer(void* pointer)
+{
+    Py_buffer* buffer = static_cast<Py_buffer*>(pointer);
+    PyBuffer_Release(buffer);
+    delete buffer;
+    return 0;
+}
+
+void
+adopt_python_buffer(rawgl::HostImageData& image, const nb::object& value)
+{
+    auto buffer = std::make_unique<Py_buffer>();
+    if (PyObject_GetBuffer(value.ptr(), buffer.get(), PyBUF_C_CONTIGUOUS) != 0) {
+        PyErr_Clear();
+        throw std::runtime_error("expected a C-contiguous buffer object");
+    }
+
+    Py_buffer* adopted = buffer.release();
+    const std::byte* data = static_cast<const std::byte*>(adopted->buf);
+    const size_t byteCount = static_cast<size_t>(adopted->len);
+    image.sharedBytes = std::shared_ptr<const std::byte>(data, [adopted](const std::byte*) {
+        if (Py_IsInitialized() == 0) {
+            delete adopted;
+            return;
+        }
+        if (PyGILState_Check() != 0) {
+            release_adopted_python_buffer(adopted);
+            return;
+        }
+        // The last reference may drop on a batch or GPU worker while the
+        // interpreter thread waits on that worker, so defer instead of blocking.
+        if (Py_AddPendingCall(&release_adopted_python_buffer, adopted) != 0) {
+            nb::gil_scoped_acquire gil;
+            release_adopted_python_buffer(adopted);
+        }
+    });
+    image.sharedByteCount = byteCount;
+    image.bytes.clear();
+    image.bytes.shrink_to_fit();
+}
+
+rawgl::io::ImageLoadResult
+load_python_image_memory(const rawgl::io::IoRuntime& ioRuntime,
+                         const nb::object& data,
+                         const std::string& nameHint,
+                         const std::vector<rawgl::Attribute>& attributes,
+                         const rawgl::io::ImageCodecLoadOptions& codecOptions)
+{
+    // The buffer stays exported while the GIL is released, so the encoded bytes are decoded without a copy.
+    PythonBufferView view(data);
+    rawgl::io::ImageMemoryLoadRequest request;
+    request.bytes = std::span<const std::byte>(static_cast<const std::byte*>(view.buffer.buf),
+                                               static_cast<size_t>(view.buffer.len));
+    request.nameHint = nameHint;
+    request.attributes = attributes;
+    request.codecOptions = codecOptions;
+
+    nb::gil_scoped_release release;
+    return ioRuntime.loadImageMemory(request);
+}
+
 const char*
 rawgl_python_status()
 {
@@ -410,6 +543,11 @@ NB_MODULE(_rawgl, module)
         .value("pass_output", rawgl::InputSourceKind::passOutput)
         .value("workflow_texture", rawgl::InputSourceKind::workflowTexture);
 
+    nb::enum_<rawgl::CaptureSampleType>(module, "CaptureSampleType")
+        .value("native", rawgl::CaptureSampleType::native)
+        .value("unorm8", rawgl::CaptureSampleType::unorm8)
+        .value("unorm16", rawgl::CaptureSampleType::unorm16);
+
     nb::enum_<rawgl::MeshSourceKind>(module, "MeshSourceKind")
         .value("quad", rawgl::MeshSourceKind::quad)
         .value("file", rawgl::MeshSourceKind::file)
@@ -430,8 +568,20 @@ NB_MODULE(_rawgl, module)
         .def_rw("gl_type", &rawgl::HostImageData::glType)
         .def_prop_rw(
             "bytes",
-            [](const rawgl::HostImageData& image) { return to_python_bytes(image.bytes); },
-            [](rawgl::HostImageData& image, const nb::object& value) { image.bytes = from_python_bytes(value); });
+            [](const rawgl::HostImageData& image) { return to_python_bytes(image.pixelBytes()); },
+            [](rawgl::HostImageData& image, const nb::object& value) {
+                image.bytes = from_python_bytes(value);
+                image.sharedBytes.reset();
+                image.sharedByteCount = 0;
+            })
+        .def(
+            "as_array",
+            [](rawgl::HostImageData& image) { return host_image_array_view(image); },
+            "Return a read-only NumPy view of the pixels without copying.")
+        .def("adopt_buffer",
+             &adopt_python_buffer,
+             nb::arg("buffer"),
+             "Use a C-contiguous buffer such as a NumPy array as the pixel storage without copying.");
 
     nb::class_<rawgl::HostMeshAttribute>(module, "HostMeshAttribute")
         .def(nb::init<>())
@@ -628,7 +778,8 @@ NB_MODULE(_rawgl, module)
         .def_rw("uses_array_element", &rawgl::OutputBinding::usesArrayElement)
         .def_rw("array_element", &rawgl::OutputBinding::arrayElement)
         .def_rw("attributes", &rawgl::OutputBinding::attributes)
-        .def_rw("capture_to_host", &rawgl::OutputBinding::captureToHost);
+        .def_rw("capture_to_host", &rawgl::OutputBinding::captureToHost)
+        .def_rw("capture_sample_type", &rawgl::OutputBinding::captureSampleType);
 
     nb::class_<rawgl::MeshBinding>(module, "MeshBinding")
         .def(nb::init<>())
@@ -700,7 +851,28 @@ NB_MODULE(_rawgl, module)
         .def_rw("success", &rawgl::RunResult::success)
         .def_rw("error_message", &rawgl::RunResult::errorMessage)
         .def_rw("captured_outputs", &rawgl::RunResult::capturedOutputs)
-        .def_rw("captured_counters", &rawgl::RunResult::capturedCounters);
+        .def_rw("captured_counters", &rawgl::RunResult::capturedCounters)
+        .def(
+            "captured_output_array",
+            [](rawgl::RunResult& result, const std::string& name) {
+                const auto captureIt = result.capturedOutputs.find(name);
+                if (captureIt == result.capturedOutputs.end()) {
+                    throw nb::key_error(name.c_str());
+                }
+                return host_image_array_view(captureIt->second);
+            },
+            nb::arg("name"),
+            "Return a NumPy view of one captured output without copying.")
+        .def(
+            "captured_output_arrays",
+            [](rawgl::RunResult& result) {
+                nb::dict arrays;
+                for (auto& [name, image] : result.capturedOutputs) {
+                    arrays[nb::str(name.c_str())] = host_image_array_view(image);
+                }
+                return arrays;
+            },
+            "Return read-only NumPy views of all captured outputs without copying.");
 
     nb::class_<rawgl::io::RunRequest>(module, "IoRunRequest")
         .def(nb::init<>())
@@ -709,10 +881,16 @@ NB_MODULE(_rawgl, module)
         .def_rw("file_outputs", &rawgl::io::RunRequest::fileOutputs);
 
     nb::class_<rawgl::PreparedWorkflow>(module, "PreparedWorkflow")
-        .def("run", &rawgl::PreparedWorkflow::run, nb::arg("settings") = rawgl::RunSettings {});
+        .def("run",
+             &rawgl::PreparedWorkflow::run,
+             nb::arg("settings") = rawgl::RunSettings {},
+             nb::call_guard<nb::gil_scoped_release>());
 
     nb::class_<rawgl::io::PreparedIoWorkflow>(module, "PreparedIoWorkflow")
-        .def("run", &rawgl::io::PreparedIoWorkflow::run, nb::arg("request") = rawgl::io::RunRequest {});
+        .def("run",
+             &rawgl::io::PreparedIoWorkflow::run,
+             nb::arg("request") = rawgl::io::RunRequest {},
+             nb::call_guard<nb::gil_scoped_release>());
 
     nb::class_<PythonPrepareResult>(module, "PrepareResult")
         .def(nb::init<>())
@@ -746,7 +924,22 @@ NB_MODULE(_rawgl, module)
         .def_rw("shader_interfaces", &rawgl::SessionStats::shaderInterfaces)
         .def_rw("textures", &rawgl::SessionStats::textures)
         .def_rw("meshes_host", &rawgl::SessionStats::meshesHost)
-        .def_rw("meshes_gpu", &rawgl::SessionStats::meshesGpu);
+        .def_rw("meshes_gpu", &rawgl::SessionStats::meshesGpu)
+        .def_rw("texture_bytes", &rawgl::SessionStats::textureBytes)
+        .def_rw("texture_hits", &rawgl::SessionStats::textureHits)
+        .def_rw("texture_misses", &rawgl::SessionStats::textureMisses)
+        .def_rw("texture_evictions", &rawgl::SessionStats::textureEvictions)
+        .def_rw("output_textures_pooled", &rawgl::SessionStats::outputTexturesPooled)
+        .def_rw("output_texture_pool_bytes", &rawgl::SessionStats::outputTexturePoolBytes)
+        .def_rw("output_texture_pool_hits", &rawgl::SessionStats::outputTexturePoolHits)
+        .def_rw("output_texture_pool_misses", &rawgl::SessionStats::outputTexturePoolMisses)
+        .def_rw("output_texture_pool_evictions", &rawgl::SessionStats::outputTexturePoolEvictions);
+
+    nb::class_<rawgl::SessionOptions>(module, "SessionOptions")
+        .def(nb::init<>())
+        .def_rw("texture_cache_budget_bytes", &rawgl::SessionOptions::textureCacheBudgetBytes)
+        .def_rw("output_texture_pool_budget_bytes", &rawgl::SessionOptions::outputTexturePoolBudgetBytes)
+        .def_rw("gl_error_policy", &rawgl::SessionOptions::glErrorPolicy);
 
     nb::class_<rawgl::RuntimeInfo>(module, "RuntimeInfo")
         .def(nb::init<>())
@@ -760,7 +953,8 @@ NB_MODULE(_rawgl, module)
         .def_rw("renderer", &rawgl::RuntimeInfo::renderer)
         .def_rw("version", &rawgl::RuntimeInfo::version)
         .def_rw("shading_language_version", &rawgl::RuntimeInfo::shadingLanguageVersion)
-        .def_rw("software_renderer", &rawgl::RuntimeInfo::softwareRenderer);
+        .def_rw("software_renderer", &rawgl::RuntimeInfo::softwareRenderer)
+        .def_rw("gl_error_policy", &rawgl::RuntimeInfo::glErrorPolicy);
 
     module.def("runtime_info",
                []() { return rawgl_python_call([]() { return rawgl::ProbeRuntimeInfo(); }); },
@@ -771,14 +965,23 @@ NB_MODULE(_rawgl, module)
              [](nb::pointer_and_handle<rawgl::Session> instance) {
                  rawgl_python_call([&]() { new (instance.p) rawgl::Session(); });
              })
+        .def("__init__",
+             [](nb::pointer_and_handle<rawgl::Session> instance, const rawgl::SessionOptions& options) {
+                 rawgl_python_call([&]() { new (instance.p) rawgl::Session(options); });
+             },
+             nb::arg("options"))
         .def("inspect_shader_interface",
              [](const rawgl::Session& session, const rawgl::ShaderInspectionRequest& request) {
-                 return rawgl_python_call([&]() { return session.inspectShaderInterface(request); });
+                 return rawgl_python_call([&]() {
+                     nb::gil_scoped_release release;
+                     return session.inspectShaderInterface(request);
+                 });
              },
              nb::arg("request"))
         .def("prepare",
              [](const rawgl::Session& session, const rawgl::Workflow& workflow) {
                  return rawgl_python_call([&]() {
+                     nb::gil_scoped_release release;
                      rawgl::PrepareResult prepareResult = session.prepare(workflow);
                      PythonPrepareResult result;
                      result.success = prepareResult.success;
@@ -792,7 +995,10 @@ NB_MODULE(_rawgl, module)
              nb::arg("workflow"))
         .def("run",
              [](const rawgl::Session& session, const rawgl::Workflow& workflow, const rawgl::RunSettings& settings) {
-                 return rawgl_python_call([&]() { return session.run(workflow, settings); });
+                 return rawgl_python_call([&]() {
+                     nb::gil_scoped_release release;
+                     return session.run(workflow, settings);
+                 });
              },
              nb::arg("workflow"),
              nb::arg("settings") = rawgl::RunSettings {},
@@ -811,10 +1017,19 @@ NB_MODULE(_rawgl, module)
         .value("grayscale", rawgl::io::JpegLoadColorTransform::Grayscale)
         .value("rgb", rawgl::io::JpegLoadColorTransform::Rgb);
 
+    nb::enum_<rawgl::io::JpegDctMethod>(module, "JpegDctMethod")
+        .value("accurate", rawgl::io::JpegDctMethod::Accurate)
+        .value("fast", rawgl::io::JpegDctMethod::Fast)
+        .value("float", rawgl::io::JpegDctMethod::Float);
+
     nb::class_<rawgl::io::JpegLoadOptions>(module, "JpegLoadOptions")
         .def(nb::init<>())
         .def_rw("has_color_transform", &rawgl::io::JpegLoadOptions::hasColorTransform)
-        .def_rw("color_transform", &rawgl::io::JpegLoadOptions::colorTransform);
+        .def_rw("color_transform", &rawgl::io::JpegLoadOptions::colorTransform)
+        .def_rw("has_dct_method", &rawgl::io::JpegLoadOptions::hasDctMethod)
+        .def_rw("dct_method", &rawgl::io::JpegLoadOptions::dctMethod)
+        .def_rw("has_fancy_upsampling", &rawgl::io::JpegLoadOptions::hasFancyUpsampling)
+        .def_rw("fancy_upsampling", &rawgl::io::JpegLoadOptions::fancyUpsampling);
 
     nb::class_<rawgl::io::PngLoadOptions>(module, "PngLoadOptions")
         .def(nb::init<>())
@@ -836,19 +1051,30 @@ NB_MODULE(_rawgl, module)
     nb::class_<rawgl::io::OpenExrLoadOptions>(module, "OpenExrLoadOptions")
         .def(nb::init<>())
         .def_rw("has_channel_selection", &rawgl::io::OpenExrLoadOptions::hasChannelSelection)
-        .def_rw("channel_selection", &rawgl::io::OpenExrLoadOptions::channelSelection);
+        .def_rw("channel_selection", &rawgl::io::OpenExrLoadOptions::channelSelection)
+        .def_rw("has_thread_count", &rawgl::io::OpenExrLoadOptions::hasThreadCount)
+        .def_rw("thread_count", &rawgl::io::OpenExrLoadOptions::threadCount);
 
     nb::class_<rawgl::io::Jpeg2000LoadOptions>(module, "Jpeg2000LoadOptions")
         .def(nb::init<>())
         .def_rw("has_reduce_factor", &rawgl::io::Jpeg2000LoadOptions::hasReduceFactor)
         .def_rw("reduce_factor", &rawgl::io::Jpeg2000LoadOptions::reduceFactor)
         .def_rw("has_layer_limit", &rawgl::io::Jpeg2000LoadOptions::hasLayerLimit)
-        .def_rw("layer_limit", &rawgl::io::Jpeg2000LoadOptions::layerLimit);
+        .def_rw("layer_limit", &rawgl::io::Jpeg2000LoadOptions::layerLimit)
+        .def_rw("has_region", &rawgl::io::Jpeg2000LoadOptions::hasRegion)
+        .def_rw("region_x", &rawgl::io::Jpeg2000LoadOptions::regionX)
+        .def_rw("region_y", &rawgl::io::Jpeg2000LoadOptions::regionY)
+        .def_rw("region_width", &rawgl::io::Jpeg2000LoadOptions::regionWidth)
+        .def_rw("region_height", &rawgl::io::Jpeg2000LoadOptions::regionHeight)
+        .def_rw("has_thread_count", &rawgl::io::Jpeg2000LoadOptions::hasThreadCount)
+        .def_rw("thread_count", &rawgl::io::Jpeg2000LoadOptions::threadCount);
 
     nb::class_<rawgl::io::ImageCodecLoadOptions>(module, "ImageCodecLoadOptions")
         .def(nb::init<>())
         .def_rw("has_backend_policy", &rawgl::io::ImageCodecLoadOptions::hasBackendPolicy)
         .def_rw("backend_policy", &rawgl::io::ImageCodecLoadOptions::backendPolicy)
+        .def_rw("has_decode_scale", &rawgl::io::ImageCodecLoadOptions::hasDecodeScale)
+        .def_rw("decode_scale", &rawgl::io::ImageCodecLoadOptions::decodeScale)
         .def_rw("has_jpeg", &rawgl::io::ImageCodecLoadOptions::hasJpeg)
         .def_rw("jpeg", &rawgl::io::ImageCodecLoadOptions::jpeg)
         .def_rw("has_png", &rawgl::io::ImageCodecLoadOptions::hasPng)
@@ -877,7 +1103,9 @@ NB_MODULE(_rawgl, module)
         .def_rw("has_optimize", &rawgl::io::JpegSaveOptions::hasOptimize)
         .def_rw("optimize", &rawgl::io::JpegSaveOptions::optimize)
         .def_rw("has_subsampling", &rawgl::io::JpegSaveOptions::hasSubsampling)
-        .def_rw("subsampling", &rawgl::io::JpegSaveOptions::subsampling);
+        .def_rw("subsampling", &rawgl::io::JpegSaveOptions::subsampling)
+        .def_rw("has_dct_method", &rawgl::io::JpegSaveOptions::hasDctMethod)
+        .def_rw("dct_method", &rawgl::io::JpegSaveOptions::dctMethod);
 
     nb::class_<rawgl::io::PngSaveOptions>(module, "PngSaveOptions")
         .def(nb::init<>())
@@ -978,7 +1206,9 @@ NB_MODULE(_rawgl, module)
         .def_rw("has_line_order", &rawgl::io::OpenExrSaveOptions::hasLineOrder)
         .def_rw("line_order", &rawgl::io::OpenExrSaveOptions::lineOrder)
         .def_rw("has_dwa_compression_level", &rawgl::io::OpenExrSaveOptions::hasDwaCompressionLevel)
-        .def_rw("dwa_compression_level", &rawgl::io::OpenExrSaveOptions::dwaCompressionLevel);
+        .def_rw("dwa_compression_level", &rawgl::io::OpenExrSaveOptions::dwaCompressionLevel)
+        .def_rw("has_thread_count", &rawgl::io::OpenExrSaveOptions::hasThreadCount)
+        .def_rw("thread_count", &rawgl::io::OpenExrSaveOptions::threadCount);
 
     nb::class_<rawgl::io::Jpeg2000SaveOptions>(module, "Jpeg2000SaveOptions")
         .def(nb::init<>())
@@ -987,7 +1217,9 @@ NB_MODULE(_rawgl, module)
         .def_rw("has_compression_ratio", &rawgl::io::Jpeg2000SaveOptions::hasCompressionRatio)
         .def_rw("compression_ratio", &rawgl::io::Jpeg2000SaveOptions::compressionRatio)
         .def_rw("has_quality", &rawgl::io::Jpeg2000SaveOptions::hasQuality)
-        .def_rw("quality", &rawgl::io::Jpeg2000SaveOptions::quality);
+        .def_rw("quality", &rawgl::io::Jpeg2000SaveOptions::quality)
+        .def_rw("has_thread_count", &rawgl::io::Jpeg2000SaveOptions::hasThreadCount)
+        .def_rw("thread_count", &rawgl::io::Jpeg2000SaveOptions::threadCount);
 
     nb::class_<rawgl::io::ImageCodecSaveOptions>(module, "ImageCodecSaveOptions")
         .def(nb::init<>())
@@ -1036,10 +1268,39 @@ NB_MODULE(_rawgl, module)
         .def_rw("uses_array_element", &rawgl::io::FileOutputBinding::usesArrayElement)
         .def_rw("array_element", &rawgl::io::FileOutputBinding::arrayElement);
 
+    nb::class_<rawgl::io::TiledRunRequest>(module, "TiledRunRequest")
+        .def(nb::init<>())
+        .def_rw("input", &rawgl::io::TiledRunRequest::input)
+        .def_rw("output", &rawgl::io::TiledRunRequest::output)
+        .def_rw("tile_width", &rawgl::io::TiledRunRequest::tileWidth)
+        .def_rw("tile_height", &rawgl::io::TiledRunRequest::tileHeight)
+        .def_rw("halo", &rawgl::io::TiledRunRequest::halo)
+        .def_rw("tile_info_input_name", &rawgl::io::TiledRunRequest::tileInfoInputName)
+        .def_rw("settings", &rawgl::io::TiledRunRequest::settings);
+
+    nb::class_<rawgl::io::TiledRunResult>(module, "TiledRunResult")
+        .def(nb::init<>())
+        .def_rw("success", &rawgl::io::TiledRunResult::success)
+        .def_rw("error_message", &rawgl::io::TiledRunResult::errorMessage)
+        .def_rw("width", &rawgl::io::TiledRunResult::width)
+        .def_rw("height", &rawgl::io::TiledRunResult::height)
+        .def_rw("tile_count", &rawgl::io::TiledRunResult::tileCount);
+
     nb::class_<rawgl::io::IoRuntimeOptions>(module, "IoRuntimeOptions")
         .def(nb::init<>())
         .def_rw("decode_worker_count", &rawgl::io::IoRuntimeOptions::decodeWorkerCount)
-        .def_rw("encode_worker_count", &rawgl::io::IoRuntimeOptions::encodeWorkerCount);
+        .def_rw("encode_worker_count", &rawgl::io::IoRuntimeOptions::encodeWorkerCount)
+        .def_rw("decode_threads_per_image", &rawgl::io::IoRuntimeOptions::decodeThreadsPerImage)
+        .def_rw("encode_threads_per_image", &rawgl::io::IoRuntimeOptions::encodeThreadsPerImage)
+        .def_rw("decode_cache_budget_bytes", &rawgl::io::IoRuntimeOptions::decodeCacheBudgetBytes);
+
+    nb::class_<rawgl::io::IoCacheStats>(module, "IoCacheStats")
+        .def(nb::init<>())
+        .def_rw("entries", &rawgl::io::IoCacheStats::entries)
+        .def_rw("bytes", &rawgl::io::IoCacheStats::bytes)
+        .def_rw("hits", &rawgl::io::IoCacheStats::hits)
+        .def_rw("misses", &rawgl::io::IoCacheStats::misses)
+        .def_rw("evictions", &rawgl::io::IoCacheStats::evictions);
 
     nb::class_<rawgl::io::ImageLoadRequest>(module, "ImageLoadRequest")
         .def(nb::init<>())
@@ -1237,23 +1498,44 @@ NB_MODULE(_rawgl, module)
 
     nb::class_<rawgl::io::IoRuntime>(module, "IoRuntime")
         .def(nb::init<const rawgl::io::IoRuntimeOptions&>(), nb::arg("options") = rawgl::io::IoRuntimeOptions {})
-        .def("load_image_file", &rawgl::io::IoRuntime::loadImageFile, nb::arg("request"))
-        .def("save_image_file", &rawgl::io::IoRuntime::saveImageFile, nb::arg("request"))
-        .def("read_metadata_file", &rawgl::io::IoRuntime::readMetadataFile, nb::arg("request"))
-        .def("read_metadata_document_file", &rawgl::io::IoRuntime::readMetadataDocumentFile, nb::arg("request"))
+        .def("load_image_file",
+             &rawgl::io::IoRuntime::loadImageFile,
+             nb::arg("request"),
+             nb::call_guard<nb::gil_scoped_release>())
+        .def("load_image_memory",
+             &load_python_image_memory,
+             nb::arg("data"),
+             nb::arg("name_hint") = std::string(),
+             nb::arg("attributes") = std::vector<rawgl::Attribute> {},
+             nb::arg("codec_options") = rawgl::io::ImageCodecLoadOptions {})
+        .def("cache_stats", &rawgl::io::IoRuntime::cacheStats)
+        .def("save_image_file",
+             &rawgl::io::IoRuntime::saveImageFile,
+             nb::arg("request"),
+             nb::call_guard<nb::gil_scoped_release>())
+        .def("read_metadata_file",
+             &rawgl::io::IoRuntime::readMetadataFile,
+             nb::arg("request"),
+             nb::call_guard<nb::gil_scoped_release>())
+        .def("read_metadata_document_file",
+             &rawgl::io::IoRuntime::readMetadataDocumentFile,
+             nb::arg("request"),
+             nb::call_guard<nb::gil_scoped_release>())
         .def("transfer_image_metadata_file",
              &rawgl::io::IoRuntime::transferImageMetadataFile,
-             nb::arg("request"))
+             nb::arg("request"),
+             nb::call_guard<nb::gil_scoped_release>())
         .def("prepare",
              [](const rawgl::io::IoRuntime& ioRuntime,
                 const rawgl::Session& session,
                 const rawgl::Workflow& workflow,
                 const std::vector<rawgl::io::FileInputBinding>& fileInputs,
                 const std::vector<rawgl::io::FileOutputBinding>& fileOutputs) {
-                 rawgl::io::PrepareWorkflowResult prepareResult = ioRuntime.prepare(session,
-                                                                                   workflow,
-                                                                                   fileInputs,
-                                                                                   fileOutputs);
+                 rawgl::io::PrepareWorkflowResult prepareResult;
+                 {
+                     nb::gil_scoped_release release;
+                     prepareResult = ioRuntime.prepare(session, workflow, fileInputs, fileOutputs);
+                 }
                  PythonIoPrepareResult result;
                  result.success = prepareResult.success;
                  result.errorMessage = std::move(prepareResult.errorMessage);
@@ -1272,16 +1554,36 @@ NB_MODULE(_rawgl, module)
              nb::arg("workflow"),
              nb::arg("request") = rawgl::io::RunRequest {},
              nb::arg("file_inputs") = std::vector<rawgl::io::FileInputBinding> {},
-             nb::arg("file_outputs") = std::vector<rawgl::io::FileOutputBinding> {});
-
-    module.def("load_image_file", &rawgl::io::LoadImageFile, nb::arg("request"));
-    module.def("save_image_file", &rawgl::io::SaveImageFile, nb::arg("request"));
+             nb::arg("file_outputs") = std::vector<rawgl::io::FileOutputBinding> {},
+             nb::call_guard<nb::gil_scoped_release>())
+        .def("run_tiled",
+             &rawgl::io::IoRuntime::runTiled,
+             nb::arg("session"),
+             nb::arg("workflow"),
+             nb::arg("request"),
+             nb::call_guard<nb::gil_scoped_release>());
+
+    module.def("load_image_file",
+               &rawgl::io::LoadImageFile,
+               nb::arg("request"),
+               nb::call_guard<nb::gil_scoped_release>());
+    module.def("save_image_file",
+               &rawgl::io::SaveImageFile,
+               nb::arg("request"),
+               nb::call_guard<nb::gil_scoped_release>());
     module.def("get_image_io_capabilities", &rawgl::io::GetImageIoCapabilities);
-    module.def("read_metadata_file", &rawgl::io::ReadMetadataFile, nb::arg("request"));
-    module.def("read_metadata_document_file", &rawgl::io::ReadMetadataDocumentFile, nb::arg("request"));
+    module.def("read_metadata_file",
+               &rawgl::io::ReadMetadataFile,
+               nb::arg("request"),
+               nb::call_guard<nb::gil_scoped_release>());
+    module.def("read_metadata_document_file",
+               &rawgl::io::ReadMetadataDocumentFile,
+               nb::arg("request"),
+               nb::call_guard<nb::gil_scoped_release>());
     module.def("transfer_image_metadata_file",
                &rawgl::io::TransferImageMetadataFile,
-               nb::arg("request"));
+               nb::arg("request"),
+               nb::call_guard<nb::gil_scoped_release>());
 
     nb::class_<rawgl::batch::BatchRunnerOptions>(module, "BatchRunnerOptions")
         .def(nb::init<>())
@@ -1294,7 +1596,8 @@ NB_MODULE(_rawgl, module)
         .def_rw("gpu_worker_count", &rawgl::batch::BatchRunnerOptions::gpuWorkerCount)
         .def_rw("host_memory_budget_bytes", &rawgl::batch::BatchRunnerOptions::hostMemoryBudgetBytes)
         .def_rw("gpu_memory_budget_bytes", &rawgl::batch::BatchRunnerOptions::gpuMemoryBudgetBytes)
-        .def_rw("preserve_submit_order", &rawgl::batch::BatchRunnerOptions::preserveSubmitOrder);
+        .def_rw("preserve_submit_order", &rawgl::batch::BatchRunnerOptions::preserveSubmitOrder)
+        .def_rw("collect_completions", &rawgl::batch::BatchRunnerOptions::collectCompletions);
 
     nb::class_<rawgl::batch::BatchProgress>(module, "BatchProgress")
         .def(nb::init<>())
@@ -1302,7 +1605,9 @@ NB_MODULE(_rawgl, module)
         .def_rw("completed_jobs", &rawgl::batch::BatchProgress::completedJobs)
         .def_rw("failed_jobs", &rawgl::batch::BatchProgress::failedJobs)
         .def_rw("cancelled_jobs", &rawgl::batch::BatchProgress::cancelledJobs)
-        .def_rw("in_flight_jobs", &rawgl::batch::BatchProgress::inFlightJobs);
+        .def_rw("in_flight_jobs", &rawgl::batch::BatchProgress::inFlightJobs)
+        .def_rw("reserved_host_bytes", &rawgl::batch::BatchProgress::reservedHostBytes)
+        .def_rw("reserved_gpu_bytes", &rawgl::batch::BatchProgress::reservedGpuBytes);
 
     nb::class_<rawgl::batch::BatchSubmitRequest>(module, "BatchSubmitRequest")
         .def(nb::init<>())
@@ -1324,7 +1629,26 @@ NB_MODULE(_rawgl, module)
     nb::class_<rawgl::batch::BatchPreparedWorkflow>(module, "BatchPreparedWorkflow");
 
     nb::class_<rawgl::batch::BatchJobHandle>(module, "BatchJobHandle")
-        .def("wait", &rawgl::batch::BatchJobHandle::wait);
+        .def("wait", &rawgl::batch::BatchJobHandle::wait, nb::call_guard<nb::gil_scoped_release>())
+        .def("is_ready", &rawgl::batch::BatchJobHandle::isReady)
+        .def("wait_for",
+             [](const rawgl::batch::BatchJobHandle& handle,
+                const double timeoutSeconds) -> std::optional<rawgl::batch::BatchResult> {
+                 const auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::duration<double>(std::max(timeoutSeconds, 0.0)));
+                 rawgl::batch::BatchResult result;
+                 bool ready = false;
+                 {
+                     nb::gil_scoped_release release;
+                     ready = handle.waitFor(timeout, result);
+                 }
+                 if (!ready) {
+                     return std::nullopt;
+                 }
+                 return result;
+             },
+             nb::arg("timeout"),
+             "Wait up to `timeout` seconds and return the result, or None while the job is pending.");
 
     nb::class_<rawgl::batch::BatchRunner>(module, "BatchRunner")
         .def(nb::init<rawgl::Session&, const rawgl::batch::BatchRunnerOptions&>(),
@@ -1342,7 +1666,11 @@ NB_MODULE(_rawgl, module)
                 const rawgl::Workflow& workflow,
                 const std::vector<rawgl::io::FileInputBinding>& fileInputs,
                 const std::vector<rawgl::io::FileOutputBinding>& fileOutputs) {
-                 rawgl::batch::BatchPrepareResult prepareResult = runner.prepare(workflow, fileInputs, fileOutputs);
+                 rawgl::batch::BatchPrepareResult prepareResult;
+                 {
+                     nb::gil_scoped_release release;
+                     prepareResult = runner.prepare(workflow, fileInputs, fileOutputs);
+                 }
                  PythonBatchPrepareResult result;
                  result.success = prepareResult.success;
                  result.errorMessage = std::move(prepareResult.errorMessage);
@@ -1358,7 +1686,22 @@ NB_MODULE(_rawgl, module)
              &rawgl::batch::BatchRunner::submit,
              nb::arg("workflow"),
              nb::arg("request") = rawgl::batch::BatchSubmitRequest {},
-             nb::arg("cancellation") = static_cast<const rawgl::batch::BatchCancellationToken*>(nullptr))
+             nb::arg("cancellation") = static_cast<const rawgl::batch::BatchCancellationToken*>(nullptr),
+             nb::call_guard<nb::gil_scoped_release>())
+        .def("wait_next_completed",
+             [](rawgl::batch::BatchRunner& runner) -> std::optional<rawgl::batch::BatchResult> {
+                 rawgl::batch::BatchResult result;
+                 bool delivered = false;
+                 {
+                     nb::gil_scoped_release release;
+                     delivered = runner.waitNextCompleted(result);
+                 }
+                 if (!delivered) {
+                     return std::nullopt;
+                 }
+                 return result;
+             })
+        .def("drain", &rawgl::batch::BatchRunner::drain, nb::call_guard<nb::gil_scoped_release>())
         .def("progress", &rawgl::batch::BatchRunner::progress)
-        .def("close", &rawgl::batch::BatchRunner::close);
+        .def("close", &rawgl::batch::BatchRunner::close, nb::call_guard<nb::gil_scoped_release>());
 }
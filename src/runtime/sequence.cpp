@@ -10,6 +10,7 @@
 #include "log.h"
 #include "texture_loader.h"
 
+#include <algorithm>
 #include <future>
 #include <sstream>
 #include <stdexcept>
@@ -47,6 +48,15 @@ throw_sequence_error(const std::string& message)
     throw std::runtime_error(message);
 }
 
+static void
+check_sequence_gl_errors(const std::string& stage)
+{
+    std::string glErrorMessage;
+    if (rawgl_take_gl_errors(glErrorMessage)) {
+        throw_sequence_error(stage + ": OpenGL error: " + glErrorMessage);
+    }
+}
+
 struct PendingTextureLoad {
     std::string key;
     std::future<rawgl::io::LoadedTextureData> future;
@@ -66,20 +76,6 @@ static const uint32_t RAWGL_DEFAULT_MATERIAL_IDS[] = { 0u, 0u, 0u, 0u };
 
 static const unsigned int RAWGL_DEFAULT_INDICES[] = { 0, 1, 2, 0, 2, 3 };
 
-static const SequenceExecutionInputOverride*
-find_input_override(const std::vector<SequenceExecutionInputOverride>& inputOverrides,
-                    const size_t passIndex,
-                    const std::string& inputName)
-{
-    for (const SequenceExecutionInputOverride& inputOverride : inputOverrides) {
-        if (inputOverride.passIndex == passIndex && inputOverride.inputName == inputName) {
-            return &inputOverride;
-        }
-    }
-
-    return nullptr;
-}
-
 static const rawgl::io::IoRuntimeService&
 resolve_io_runtime(const std::shared_ptr<rawgl::io::IoRuntimeService>& ioRuntime)
 {
@@ -668,6 +664,10 @@ Sequence::~Sequence()
 {
     destroyAtomicCounterBuffers();
 
+    for (const auto& samplerIt : m_samplers) {
+        glDeleteSamplers(1, &samplerIt.second);
+    }
+
     for (auto& pass : m_passes) {
         if (pass.fboId) {
             glDeleteFramebuffers(1, &pass.fboId);
@@ -693,10 +693,11 @@ Sequence::initializeFromRuntimeConfig(const SequenceRuntimeConfig& runtimeConfig
     Log_SetVerbosity(std::clamp(runtimeConfig.verbosity, 0, 5));
     LOG(debug) << "Starting RawGL sequence" << std::endl;
 
-    m_textures        = runtimeConfig.sharedTextures;
-    m_sharedMeshes    = runtimeConfig.sharedMeshes;
-    m_sharedGpuMeshes = runtimeConfig.sharedGpuMeshes;
-    m_ioRuntime       = runtimeConfig.ioRuntime;
+    m_textures          = runtimeConfig.sharedTextures;
+    m_sharedMeshes      = runtimeConfig.sharedMeshes;
+    m_sharedGpuMeshes   = runtimeConfig.sharedGpuMeshes;
+    m_ioRuntime         = runtimeConfig.ioRuntime;
+    m_outputTexturePool = runtimeConfig.outputTexturePool;
     buildPassesFromRuntimeConfig(runtimeConfig);
 
     int passIndex = 0;
@@ -716,6 +717,7 @@ Sequence::initializeFromRuntimeConfig(const SequenceRuntimeConfig& runtimeConfig
 void
 Sequence::preloadInputTextures()
 {
+    const rawgl::io::IoRuntimeService& ioRuntime = resolve_io_runtime(m_ioRuntime);
     std::vector<PendingTextureLoad> pendingTextureLoads;
     std::unordered_map<std::string, std::size_t> pendingTextureIndex;
 
@@ -750,12 +752,10 @@ Sequence::preloadInputTextures()
 
             PendingTextureLoad pendingLoad;
             pendingLoad.key    = textureKey;
-            pendingLoad.future = std::async(std::launch::async,
-                                            [this](std::string path, std::map<std::string, std::string> attributes) {
-                                                return resolve_io_runtime(m_ioRuntime).loadTextureFileData(path, attributes);
-                                            },
-                                            input.path,
-                                            input.attributes);
+            pendingLoad.future = ioRuntime.decodePool().submit(
+                [&ioRuntime, path = input.path, attributes = input.attributes]() {
+                    return ioRuntime.loadTextureFileData(path, attributes);
+                });
             pendingTextureIndex.insert({ textureKey, pendingTextureLoads.size() });
             pendingTextureLoads.push_back(std::move(pendingLoad));
         }
@@ -777,7 +777,7 @@ Sequence::preloadInputTextures()
         m_textures.insert({ pendingLoad.key,
                             std::make_shared<Texture>(textureData.width, textureData.height, textureData.internalFormat,
                                                       textureData.type,
-                                                      textureData.bytes.empty() ? nullptr : textureData.bytes.data(),
+                                                      textureData.bytes && !textureData.bytes->empty() ? textureData.bytes->data() : nullptr,
                                                       textureData.alphaChannel) });
     }
 }
@@ -844,11 +844,47 @@ Sequence::ensurePassOutputTextures(SequencePass& pass, int passIndex)
             uploadType     = formats[formatIndex].uploadType;
         }
 
-        auto textureIt = m_textures
-                             .insert({ textureName,
-                                       std::make_shared<Texture>(pass.size[0], pass.size[1], internalFormat, uploadType,
-                                                                 nullptr, output.alphaChannel) })
-                             .first;
+        const auto fitsOutput = [&](const Texture& candidate) {
+            return candidate.getWidth() == pass.size[0] && candidate.getHeight() == pass.size[1]
+                   && candidate.getInternalFormat() == internalFormat
+                   && candidate.getAlphaChannel() == output.alphaChannel;
+        };
+
+        std::shared_ptr<Texture> texture = std::move(output.nextRunTexture);
+        if (texture && !fitsOutput(*texture)) {
+            texture.reset();
+        }
+
+        // Passes run in index order, so a texture whose last reader ran before this pass is free to write again.
+        output.clearBeforePass = false;
+        const bool sharesTexture = !texture && output.lastUsePass >= passIndex;
+        if (sharesTexture) {
+            for (AliasedOutputTexture& aliased : m_aliasedOutputTextures) {
+                if (aliased.lastUsePass < passIndex && fitsOutput(*aliased.texture)) {
+                    aliased.lastUsePass    = output.lastUsePass;
+                    texture                = aliased.texture;
+                    output.clearBeforePass = true;
+                    break;
+                }
+            }
+        }
+
+        if (output.clearBeforePass) {
+            LOG(debug) << "Pass " << passIndex << ": output " << outputIt.first << " shares texture "
+                       << texture->getId() << " with an earlier transient output.";
+        } else if (texture) {
+            texture->clear();
+        } else if (m_outputTexturePool) {
+            texture = m_outputTexturePool->acquire(pass.size[0], pass.size[1], internalFormat, uploadType,
+                                                   output.alphaChannel);
+        } else {
+            texture = std::make_shared<Texture>(pass.size[0], pass.size[1], internalFormat, uploadType, nullptr,
+                                                output.alphaChannel);
+        }
+        if (sharesTexture && !output.clearBeforePass) {
+            m_aliasedOutputTextures.push_back(AliasedOutputTexture { texture, output.lastUsePass });
+        }
+        auto textureIt = m_textures.insert({ textureName, std::move(texture) }).first;
         output.texture = textureIt->second;
 
         if (!pass.isCompute) {
@@ -1187,11 +1223,81 @@ Sequence::validatePassSetup() const
     }
 }
 
+Sequence::InputBindingKind
+Sequence::classifyInputBinding(const GLenum uniformType)
+{
+    switch (uniformType) {
+    case GL_SAMPLER_2D:
+    case GL_INT_SAMPLER_2D:
+    case GL_UNSIGNED_INT_SAMPLER_2D: return InputBindingKind::sampler;
+    case GL_IMAGE_2D: return InputBindingKind::image;
+    case GL_BOOL:
+    case GL_BOOL_VEC2:
+    case GL_BOOL_VEC3:
+    case GL_BOOL_VEC4:
+    case GL_INT:
+    case GL_INT_VEC2:
+    case GL_INT_VEC3:
+    case GL_INT_VEC4: return InputBindingKind::intValues;
+    case GL_UNSIGNED_INT:
+    case GL_UNSIGNED_INT_VEC2:
+    case GL_UNSIGNED_INT_VEC3:
+    case GL_UNSIGNED_INT_VEC4: return InputBindingKind::uintValues;
+    case GL_FLOAT:
+    case GL_FLOAT_VEC2:
+    case GL_FLOAT_VEC3:
+    case GL_FLOAT_VEC4:
+    case GL_FLOAT_MAT2:
+    case GL_FLOAT_MAT2x3:
+    case GL_FLOAT_MAT2x4:
+    case GL_FLOAT_MAT3:
+    case GL_FLOAT_MAT3x2:
+    case GL_FLOAT_MAT3x4:
+    case GL_FLOAT_MAT4:
+    case GL_FLOAT_MAT4x2:
+    case GL_FLOAT_MAT4x3: return InputBindingKind::floatValues;
+    case GL_DOUBLE:
+    case GL_DOUBLE_VEC2:
+    case GL_DOUBLE_VEC3:
+    case GL_DOUBLE_VEC4:
+    case GL_DOUBLE_MAT2:
+    case GL_DOUBLE_MAT2x3:
+    case GL_DOUBLE_MAT2x4:
+    case GL_DOUBLE_MAT3:
+    case GL_DOUBLE_MAT3x2:
+    case GL_DOUBLE_MAT3x4:
+    case GL_DOUBLE_MAT4:
+    case GL_DOUBLE_MAT4x2:
+    case GL_DOUBLE_MAT4x3: return InputBindingKind::doubleValues;
+    default: return InputBindingKind::other;
+    }
+}
+
+GLuint
+Sequence::acquireSampler(GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT)
+{
+    const std::array<GLint, 4> key = { minFilter, magFilter, wrapS, wrapT };
+    auto samplerIt = m_samplers.find(key);
+    if (samplerIt != m_samplers.end()) {
+        return samplerIt->second;
+    }
+
+    GLuint sampler = 0;
+    GLCall(glCreateSamplers(1, &sampler));
+    GLCall(glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, minFilter));
+    GLCall(glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, magFilter));
+    GLCall(glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, wrapS));
+    GLCall(glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, wrapT));
+    m_samplers.emplace(key, sampler);
+    return sampler;
+}
+
 void
 Sequence::buildExecutionPlan()
 {
     m_executionPlan.clear();
     m_executionPlan.reserve(m_passes.size());
+    size_t overrideSlotCount = 0;
 
     for (int passIndex = 0; passIndex < static_cast<int>(m_passes.size()); ++passIndex) {
         SequencePass& pass = m_passes[passIndex];
@@ -1203,8 +1309,19 @@ Sequence::buildExecutionPlan()
         plan.outputs.reserve(pass.outputs.size());
         plan.meshes.reserve(pass.meshes.size());
 
+        // Inputs stay in name order, which resolveInputOverrides relies on for its binary search.
         for (auto& inputIt : pass.inputs) {
-            plan.inputs.push_back(PlannedInputBinding { &inputIt.first, &inputIt.second });
+            PassInput& input = inputIt.second;
+            PlannedInputBinding binding { &inputIt.first, &input };
+            binding.kind         = classifyInputBinding(input.uniform->type);
+            binding.overrideSlot = overrideSlotCount++;
+            if (binding.kind == InputBindingKind::sampler) {
+                const GLint integerMinFilter =
+                    input.tex_min == GL_NEAREST_MIPMAP_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+                binding.sampler        = acquireSampler(input.tex_min, input.tex_mag, input.tex_s, input.tex_t);
+                binding.integerSampler = acquireSampler(integerMinFilter, GL_NEAREST, input.tex_s, input.tex_t);
+            }
+            plan.inputs.push_back(binding);
         }
 
         for (auto& outputIt : pass.outputs) {
@@ -1217,55 +1334,71 @@ Sequence::buildExecutionPlan()
 
         m_executionPlan.push_back(std::move(plan));
     }
+
+    m_inputOverrideSlots.assign(overrideSlotCount, nullptr);
+}
+
+void
+Sequence::resolveInputOverrides(const std::vector<SequenceExecutionInputOverride>& inputOverrides)
+{
+    std::fill(m_inputOverrideSlots.begin(), m_inputOverrideSlots.end(), nullptr);
+
+    for (const SequenceExecutionInputOverride& inputOverride : inputOverrides) {
+        if (inputOverride.passIndex >= m_executionPlan.size()) {
+            continue;
+        }
+
+        const std::vector<PlannedInputBinding>& bindings = m_executionPlan[inputOverride.passIndex].inputs;
+        auto bindingIt = std::lower_bound(bindings.begin(), bindings.end(), inputOverride.inputName,
+                                          [](const PlannedInputBinding& binding, const std::string& name) {
+                                              return *binding.name < name;
+                                          });
+        if (bindingIt == bindings.end() || *bindingIt->name != inputOverride.inputName) {
+            continue;
+        }
+
+        // The first override for an input wins.
+        const SequenceExecutionInputOverride*& slot = m_inputOverrideSlots[bindingIt->overrideSlot];
+        if (slot == nullptr) {
+            slot = &inputOverride;
+        }
+    }
 }
 
 int
-Sequence::bindPassInputs(const PassExecutionPlan& plan,
-                         const std::vector<SequenceExecutionInputOverride>& inputOverrides)
+Sequence::bindPassInputs(const PassExecutionPlan& plan)
 {
-    SequencePass& pass = *plan.pass;
     int textureIndex = 0;
 
     for (const PlannedInputBinding& binding : plan.inputs) {
         PassInput& input = *binding.input;
-        const SequenceExecutionInputOverride* inputOverride =
-            find_input_override(inputOverrides, static_cast<size_t>(plan.passIndex), *binding.name);
-        std::shared_ptr<Texture> boundTexture = input.texture;
-        if (inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::texture) {
-            boundTexture = inputOverride->texture;
-        }
-        if (is_texture_input_uniform(input.uniform->type) && !boundTexture) {
-            throw_sequence_error("input (" + *binding.name + "): runtime texture binding is missing.");
-        }
+        const SequenceExecutionInputOverride* inputOverride = m_inputOverrideSlots[binding.overrideSlot];
+
+        switch (binding.kind) {
+        case InputBindingKind::sampler:
+        case InputBindingKind::image: {
+            const std::shared_ptr<Texture>& boundTexture =
+                inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::texture
+                    ? inputOverride->texture
+                    : input.texture;
+            if (!boundTexture) {
+                throw_sequence_error("input (" + *binding.name + "): runtime texture binding is missing.");
+            }
 
-        switch (input.uniform->type) {
-        case GL_SAMPLER_2D:
-        case GL_INT_SAMPLER_2D:
-        case GL_UNSIGNED_INT_SAMPLER_2D: {
             const GLuint textureId = boundTexture->getId();
-
-            GLCall(glActiveTexture(GL_TEXTURE0 + textureIndex));
-            GLCall(glBindTexture(GL_TEXTURE_2D, textureId));
-
-            GLint minFilter = input.tex_min;
-            GLint magFilter = input.tex_mag;
-            if (is_integer_texture_format(boundTexture->getInternalFormat())) {
-                if (minFilter != GL_NEAREST && minFilter != GL_NEAREST_MIPMAP_NEAREST) {
-                    minFilter = GL_NEAREST;
-                }
-                magFilter = GL_NEAREST;
+            if (binding.kind == InputBindingKind::image) {
+                GLCall(glBindImageTexture(textureIndex, textureId, 0, GL_FALSE, 0, GL_READ_ONLY,
+                                          boundTexture->getInternalFormat()));
+                LOG(debug) << "Image " << textureId << " binding is " << textureIndex;
+                input.uniform->set(textureIndex++);
+                break;
             }
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, input.tex_s);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, input.tex_t);
+            const bool integerTexture = is_integer_texture_format(boundTexture->getInternalFormat());
+            GLCall(glBindTextureUnit(textureIndex, textureId));
+            GLCall(glBindSampler(textureIndex, integerTexture ? binding.integerSampler : binding.sampler));
 
-            if (!is_integer_texture_format(boundTexture->getInternalFormat()) && minFilter != GL_LINEAR
-                && minFilter != GL_NEAREST) {
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, 0);
+            if (!integerTexture && input.tex_min != GL_LINEAR && input.tex_min != GL_NEAREST) {
                 GLCall(glGenerateTextureMipmap(textureId));
                 LOG(debug) << "Generated mip-maps for " << *binding.name << " at " << boundTexture;
             }
@@ -1273,109 +1406,54 @@ Sequence::bindPassInputs(const PassExecutionPlan& plan,
             input.uniform->set(textureIndex++);
             break;
         }
-        case GL_IMAGE_2D: {
-            const GLuint textureId = boundTexture->getId();
-            GLCall(glBindImageTexture(textureIndex, textureId, 0, GL_FALSE, 0, GL_READ_ONLY,
-                                      boundTexture->getInternalFormat()));
-            LOG(debug) << "Image " << textureId << " binding is " << textureIndex;
-            input.uniform->set(textureIndex++);
-            break;
-        }
-        case GL_BOOL:
-        case GL_BOOL_VEC2:
-        case GL_BOOL_VEC3:
-        case GL_BOOL_VEC4:
-        case GL_INT:
-        case GL_INT_VEC2:
-        case GL_INT_VEC3:
-        case GL_INT_VEC4:
-            if (inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::intValues) {
-                if (input.usesArrayElement) {
-                    set_addressed_int_uniform(input, inputOverride->intValues.data());
-                } else {
-                    input.uniform->set(inputOverride->intValues.data());
-                }
+        case InputBindingKind::intValues: {
+            const GLint* values = inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::intValues
+                                      ? inputOverride->intValues.data()
+                                      : &input.ints[0];
+            if (input.usesArrayElement) {
+                set_addressed_int_uniform(input, values);
             } else {
-                if (input.usesArrayElement) {
-                    set_addressed_int_uniform(input, &input.ints[0]);
-                } else {
-                    input.uniform->set(&input.ints[0]);
-                }
+                input.uniform->set(values);
             }
             break;
-        case GL_UNSIGNED_INT:
-        case GL_UNSIGNED_INT_VEC2:
-        case GL_UNSIGNED_INT_VEC3:
-        case GL_UNSIGNED_INT_VEC4:
-            if (inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::uintValues) {
-                if (input.usesArrayElement) {
-                    set_addressed_uint_uniform(input, inputOverride->uintValues.data());
-                } else {
-                    input.uniform->set(inputOverride->uintValues.data());
-                }
+        }
+        case InputBindingKind::uintValues: {
+            const GLuint* values =
+                inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::uintValues
+                    ? inputOverride->uintValues.data()
+                    : &input.uints[0];
+            if (input.usesArrayElement) {
+                set_addressed_uint_uniform(input, values);
             } else {
-                if (input.usesArrayElement) {
-                    set_addressed_uint_uniform(input, &input.uints[0]);
-                } else {
-                    input.uniform->set(&input.uints[0]);
-                }
+                input.uniform->set(values);
             }
             break;
-        case GL_FLOAT:
-        case GL_FLOAT_VEC2:
-        case GL_FLOAT_VEC3:
-        case GL_FLOAT_VEC4:
-        case GL_FLOAT_MAT2:
-        case GL_FLOAT_MAT2x3:
-        case GL_FLOAT_MAT2x4:
-        case GL_FLOAT_MAT3:
-        case GL_FLOAT_MAT3x2:
-        case GL_FLOAT_MAT3x4:
-        case GL_FLOAT_MAT4:
-        case GL_FLOAT_MAT4x2:
-        case GL_FLOAT_MAT4x3:
-            if (inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::floatValues) {
-                if (input.usesArrayElement) {
-                    set_addressed_float_uniform(input, inputOverride->floatValues.data());
-                } else {
-                    input.uniform->set(inputOverride->floatValues.data());
-                }
+        }
+        case InputBindingKind::floatValues: {
+            const GLfloat* values =
+                inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::floatValues
+                    ? inputOverride->floatValues.data()
+                    : &input.floats[0];
+            if (input.usesArrayElement) {
+                set_addressed_float_uniform(input, values);
             } else {
-                if (input.usesArrayElement) {
-                    set_addressed_float_uniform(input, &input.floats[0]);
-                } else {
-                    input.uniform->set(&input.floats[0]);
-                }
+                input.uniform->set(values);
             }
             break;
-        case GL_DOUBLE:
-        case GL_DOUBLE_VEC2:
-        case GL_DOUBLE_VEC3:
-        case GL_DOUBLE_VEC4:
-        case GL_DOUBLE_MAT2:
-        case GL_DOUBLE_MAT2x3:
-        case GL_DOUBLE_MAT2x4:
-        case GL_DOUBLE_MAT3:
-        case GL_DOUBLE_MAT3x2:
-        case GL_DOUBLE_MAT3x4:
-        case GL_DOUBLE_MAT4:
-        case GL_DOUBLE_MAT4x2:
-        case GL_DOUBLE_MAT4x3:
-            if (inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::doubleValues) {
-                if (input.usesArrayElement) {
-                    set_addressed_double_uniform(input, inputOverride->doubleValues.data());
-                } else {
-                    input.uniform->set(inputOverride->doubleValues.data());
-                }
+        }
+        case InputBindingKind::doubleValues: {
+            const GLdouble* values =
+                inputOverride && inputOverride->kind == SequenceExecutionInputOverrideKind::doubleValues
+                    ? inputOverride->doubleValues.data()
+                    : &input.doubles[0];
+            if (input.usesArrayElement) {
+                set_addressed_double_uniform(input, values);
             } else {
-                if (input.usesArrayElement) {
-                    set_addressed_double_uniform(input, &input.doubles[0]);
-                } else {
-                    input.uniform->set(&input.doubles[0]);
-                }
+                input.uniform->set(values);
             }
             break;
-        default: input.uniform->set(&input.floats[0]); break;
+        }
+        case InputBindingKind::other: input.uniform->set(&input.floats[0]); break;
         }
     }
 
@@ -1655,6 +1733,9 @@ Sequence::executeComputePass(const PassExecutionPlan& plan, int textureIndex)
 
     for (const PlannedOutputBinding& binding : plan.outputs) {
         PassOutput& output = *binding.output;
+        if (output.clearBeforePass) {
+            output.texture->clear();
+        }
 
         GLCall(glBindImageTexture(textureIndex, output.texture->getId(), 0, GL_FALSE, 0, GL_WRITE_ONLY,
                                   output.texture->getInternalFormat()));
@@ -1790,16 +1871,31 @@ Sequence::run(const SequenceSystemUniformState& systemUniforms,
     //glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     //glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
 
+    const bool checkEachPass = rawgl_gl_error_policy() == GLErrorPolicy::perPass;
+    // Sampler objects override texture parameters on their units, so they are unbound before anything else samples.
+    GLsizei boundSamplerUnits = 0;
+
+    // Errors queued by earlier GL work are not this run's; drain them so they are not blamed on the first pass.
+    std::string pendingGlErrors;
+    if (checkEachPass && rawgl_take_gl_errors(pendingGlErrors)) {
+        LOG(warning) << "OpenGL errors pending before the sequence run: " << pendingGlErrors;
+    }
+
     try {
         prepareRunTextures();
         applyMeshOverrides(meshOverrides);
         applyMeshUpdates(meshUpdates);
+        resolveInputOverrides(inputOverrides);
+        if (checkEachPass) {
+            check_sequence_gl_errors("Run setup");
+        }
 
         for (const PassExecutionPlan& plan : m_executionPlan) {
             SequencePass& pass = *plan.pass;
             GLCall(glUseProgram(pass.program->getId()));
 
-            const int textureIndex = bindPassInputs(plan, inputOverrides);
+            const int textureIndex = bindPassInputs(plan);
+            boundSamplerUnits      = std::max(boundSamplerUnits, static_cast<GLsizei>(textureIndex));
             bindInternalUniforms(plan, systemUniforms);
             preparePassAtomicCounters(pass);
             bindPassAtomicCounters(pass);
@@ -1811,10 +1907,20 @@ Sequence::run(const SequenceSystemUniformState& systemUniforms,
             }
 
             capturePassAtomicCounterResults(pass);
+            if (checkEachPass) {
+                check_sequence_gl_errors("Pass " + std::to_string(plan.passIndex));
+            }
         }
         clearRunMeshOverrides();
+        glBindSamplers(0, boundSamplerUnits, nullptr);
+        boundSamplerUnits = 0;
+        beginOutputReadbacks();
+        if (checkEachPass) {
+            check_sequence_gl_errors("Output readback");
+        }
     } catch (...) {
         clearRunMeshOverrides();
+        glBindSamplers(0, boundSamplerUnits, nullptr);
         glBindVertexArray(0);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
         glUseProgram(0);
@@ -1843,6 +1949,130 @@ Sequence::getPassOutputTexture(size_t passIndex, const std::string& outputName)
     return outputIt->second.texture;
 }
 
+GLenum
+Sequence::resolveOutputReadbackType(const PassOutput& output)
+{
+    const GLenum nativeType = texture_readback_type(output.texture->getInternalFormat());
+    if (output.captureType == 0 || !TexturePackProgram::supports(*output.texture, output.captureType)) {
+        return nativeType;
+    }
+
+    if (!m_packProgram) {
+        m_packProgram = std::make_unique<TexturePackProgram>();
+        if (!m_packProgram->isValid()) {
+            LOG(warning) << "Output packing program is unavailable, capturing outputs in their native type.";
+        }
+    }
+    return m_packProgram->isValid() ? output.captureType : nativeType;
+}
+
+GLenum
+Sequence::getPassOutputReadbackType(size_t passIndex, const std::string& outputName)
+{
+    if (passIndex >= m_passes.size()) {
+        throw_sequence_error("invalid pass index for output readback");
+    }
+
+    auto outputIt = m_passes[passIndex].outputs.find(outputName);
+    if (outputIt == m_passes[passIndex].outputs.end() || !outputIt->second.texture) {
+        throw_sequence_error("output (" + outputName + "): texture is not available for readback.");
+    }
+    return resolveOutputReadbackType(outputIt->second);
+}
+
+void
+Sequence::setNextRunOutputTexture(size_t passIndex, const std::string& outputName, std::shared_ptr<Texture> texture)
+{
+    if (passIndex >= m_passes.size()) {
+        throw_sequence_error("invalid pass index for output texture");
+    }
+
+    auto outputIt = m_passes[passIndex].outputs.find(outputName);
+    if (outputIt == m_passes[passIndex].outputs.end()) {
+        throw_sequence_error("output (" + outputName + "): output is not declared.");
+    }
+    outputIt->second.nextRunTexture = std::move(texture);
+}
+
+void
+Sequence::beginOutputReadbacks()
+{
+    bool startedReadback = false;
+    for (SequencePass& pass : m_passes) {
+        for (auto& outputIt : pass.outputs) {
+            PassOutput& output = outputIt.second;
+            if (!output.captureToHost || !output.texture) {
+                continue;
+            }
+
+            if (!output.readback) {
+                output.readback = std::make_shared<TextureReadback>();
+            }
+            const GLenum readbackType = resolveOutputReadbackType(output);
+            const bool queued = readbackType == texture_readback_type(output.texture->getInternalFormat())
+                                    ? output.readback->begin(*output.texture, readbackType)
+                                    : output.readback->beginPacked(*output.texture, readbackType, *m_packProgram);
+            if (!queued) {
+                LOG(debug) << "output (" << outputIt.first << "): asynchronous readback unavailable, reading on capture.";
+                continue;
+            }
+            startedReadback = true;
+        }
+    }
+
+    if (startedReadback) {
+        GLCall(glFlush());
+    }
+}
+
+void
+Sequence::readPassOutputData(size_t passIndex, const std::string& outputName, GLenum type,
+                             std::vector<std::byte>& destination)
+{
+    if (passIndex >= m_passes.size()) {
+        throw_sequence_error("invalid pass index for output readback");
+    }
+
+    auto outputIt = m_passes[passIndex].outputs.find(outputName);
+    if (outputIt == m_passes[passIndex].outputs.end() || !outputIt->second.texture) {
+        throw_sequence_error("output (" + outputName + "): texture is not available for readback.");
+    }
+
+    PassOutput& output = outputIt->second;
+    const std::size_t byteSize = output.texture->getDataSize(type);
+    if (byteSize == 0) {
+        throw_sequence_error("output (" + outputName + "): unsupported readback type.");
+    }
+
+    destination.resize(byteSize);
+    if (output.readback && output.readback->isPending() && output.readback->getType() == type
+        && output.readback->getByteSize() == byteSize) {
+        if (!output.readback->finish(destination.data())) {
+            throw_sequence_error("output (" + outputName + "): asynchronous readback failed.");
+        }
+        return;
+    }
+
+    if (output.readback) {
+        output.readback->cancel();
+    }
+    if (type != texture_readback_type(output.texture->getInternalFormat())
+        && type == resolveOutputReadbackType(output)) {
+        if (!output.readback) {
+            output.readback = std::make_shared<TextureReadback>();
+        }
+        if (!output.readback->beginPacked(*output.texture, type, *m_packProgram)
+            || !output.readback->finish(destination.data())) {
+            throw_sequence_error("output (" + outputName + "): packed readback failed.");
+        }
+        if (rawgl_gl_error_policy() == GLErrorPolicy::perPass) {
+            check_sequence_gl_errors("output (" + outputName + ")");
+        }
+        return;
+    }
+    output.texture->getData(type, destination.data());
+}
+
 std::vector<GLuint>
 Sequence::getPassAtomicCounterValues(size_t passIndex, const std::string& counterName) const
 {
@@ -1890,6 +2120,7 @@ Sequence::setPassAtomicCounterValues(size_t passIndex, const std::string& counte
 void
 Sequence::releaseRunOutputTextures()
 {
+    std::vector<std::shared_ptr<Texture>> releasedTextures;
     for (size_t passIndex = 0; passIndex < m_passes.size(); ++passIndex) {
         SequencePass& pass = m_passes[passIndex];
         for (auto& outputIt : pass.outputs) {
@@ -1897,9 +2128,13 @@ Sequence::releaseRunOutputTextures()
 
             auto textureIt = m_textures.find(textureKey);
             if (textureIt != m_textures.end()) {
+                releasedTextures.push_back(std::move(textureIt->second));
                 m_textures.erase(textureIt);
             }
 
+            if (outputIt.second.readback) {
+                outputIt.second.readback->cancel();
+            }
             outputIt.second.texture.reset();
         }
     }
@@ -1913,6 +2148,18 @@ Sequence::releaseRunOutputTextures()
         }
     }
 
+    // Shared transient textures appear once per output; keep one reference each so the pool sees them as unowned.
+    m_aliasedOutputTextures.clear();
+    std::sort(releasedTextures.begin(), releasedTextures.end());
+    releasedTextures.erase(std::unique(releasedTextures.begin(), releasedTextures.end()), releasedTextures.end());
+
+    // Only textures nothing else still references go back to the pool; the rest are freed by their last owner.
+    if (m_outputTexturePool) {
+        for (std::shared_ptr<Texture>& texture : releasedTextures) {
+            m_outputTexturePool->release(std::move(texture));
+        }
+    }
+
     m_runTexturesDirty = true;
 }
 
@@ -226,6 +226,16 @@ struct PassOutput {
     std::shared_ptr<Texture> texture;
     bool usesArrayElement = false;
     size_t arrayElement = 0;
+    bool captureToHost = false;
+    // Requested host sample type for float outputs packed on the GPU, or 0 to read back the native type.
+    GLenum captureType = 0;
+    std::shared_ptr<TextureReadback> readback;
+    // Caller-provided render target for the next run, used instead of a newly acquired texture when it fits.
+    std::shared_ptr<Texture> nextRunTexture;
+    // Last pass that reads this output during a run, or -1 when its texture must not be shared with other outputs.
+    int lastUsePass = -1;
+    // Set when the texture was taken over from an earlier output, so compute passes clear it before writing.
+    bool clearBeforePass = false;
 
     PassOutput();
 };
@@ -422,6 +432,8 @@ struct SequenceRuntimeConfig {
     std::map<std::string, std::shared_ptr<SequenceSharedMeshData>> sharedMeshes;
     std::map<std::string, std::shared_ptr<SequenceSharedGpuMesh>> sharedGpuMeshes;
     std::shared_ptr<rawgl::io::IoRuntimeService> ioRuntime;
+    /// Optional pool that run output textures are drawn from and returned to between runs.
+    std::shared_ptr<TexturePool> outputTexturePool;
 };
 
 struct SequenceSystemUniformState {
@@ -481,14 +493,39 @@ public:
              const std::vector<SequenceExecutionMeshUpdate>& meshUpdates,
              const std::vector<SequenceExecutionMeshOverride>& meshOverrides = {});
     std::shared_ptr<Texture> getPassOutputTexture(size_t passIndex, const std::string& outputName) const;
+    /// Renders an output into `texture` on the next run that allocates output textures.
+    ///
+    /// The texture is cleared first. It is ignored when its size, format or alpha channel differ from the output.
+    void setNextRunOutputTexture(size_t passIndex, const std::string& outputName, std::shared_ptr<Texture> texture);
+    /// Host element type \ref readPassOutputData delivers for a captured output.
+    GLenum getPassOutputReadbackType(size_t passIndex, const std::string& outputName);
+    void readPassOutputData(size_t passIndex, const std::string& outputName, GLenum type,
+                            std::vector<std::byte>& destination);
     std::vector<GLuint> getPassAtomicCounterValues(size_t passIndex, const std::string& counterName) const;
     void setPassAtomicCounterValues(size_t passIndex, const std::string& counterName, const std::vector<GLuint>& values);
     void releaseRunOutputTextures();
 
 private:
+    /// Uniform class of a planned input, resolved once instead of switching on the GL type every run.
+    enum class InputBindingKind {
+        sampler,
+        image,
+        intValues,
+        uintValues,
+        floatValues,
+        doubleValues,
+        other,
+    };
+
     struct PlannedInputBinding {
         const std::string* name = nullptr;
         PassInput* input        = nullptr;
+        InputBindingKind kind   = InputBindingKind::other;
+        /// Index of this input in \ref m_inputOverrideSlots.
+        size_t overrideSlot     = 0;
+        /// Sampler objects for float and integer textures; integer textures are never filtered.
+        GLuint sampler          = 0;
+        GLuint integerSampler   = 0;
     };
 
     struct PlannedOutputBinding {
@@ -504,6 +541,11 @@ private:
         std::vector<const MeshInput*> meshes;
     };
 
+    struct AliasedOutputTexture {
+        std::shared_ptr<Texture> texture;
+        int lastUsePass = -1;
+    };
+
     struct RunMeshOverrideState {
         MeshInput* meshInput = nullptr;
         MeshInput::Mesh mesh;
@@ -517,24 +559,36 @@ private:
     std::vector<RunMeshOverrideState> m_runMeshOverrideStates;
     std::vector<std::shared_ptr<SequenceSharedGpuMesh>> m_runMeshOverrideGpuMeshes;
     std::shared_ptr<rawgl::io::IoRuntimeService> m_ioRuntime;
+    std::shared_ptr<TexturePool> m_outputTexturePool;
+    /// Shareable transient output textures of the current run and the last pass that reads each.
+    std::vector<AliasedOutputTexture> m_aliasedOutputTextures;
 
     std::vector<SequencePass> m_passes;
     std::vector<PassExecutionPlan> m_executionPlan;
+    /// Override applied to each planned input during the current run, indexed by its override slot.
+    std::vector<const SequenceExecutionInputOverride*> m_inputOverrideSlots;
+    /// Sampler objects keyed by min filter, mag filter, wrap s and wrap t.
+    std::map<std::array<GLint, 4>, GLuint> m_samplers;
     bool m_runTexturesDirty = false;
+    std::unique_ptr<TexturePackProgram> m_packProgram;
 
     void buildPassesFromRuntimeConfig(const SequenceRuntimeConfig& runtimeConfig);
     void preloadInputTextures();
     void ensurePassOutputTextures(SequencePass& pass, int passIndex);
     void refreshPassTextureInputs(SequencePass& pass);
     void prepareRunTextures();
+    void beginOutputReadbacks();
+    GLenum resolveOutputReadbackType(const PassOutput& output);
     void applyMeshOverrides(const std::vector<SequenceExecutionMeshOverride>& meshOverrides);
     void clearRunMeshOverrides();
     void applyMeshUpdates(const std::vector<SequenceExecutionMeshUpdate>& meshUpdates);
     void initializePass(SequencePass& pass, int passIndex);
     void validatePassSetup() const;
     void buildExecutionPlan();
-    int bindPassInputs(const PassExecutionPlan& plan,
-                       const std::vector<SequenceExecutionInputOverride>& inputOverrides);
+    static InputBindingKind classifyInputBinding(GLenum uniformType);
+    GLuint acquireSampler(GLint minFilter, GLint magFilter, GLint wrapS, GLint wrapT);
+    void resolveInputOverrides(const std::vector<SequenceExecutionInputOverride>& inputOverrides);
+    int bindPassInputs(const PassExecutionPlan& plan);
     void bindInternalUniforms(const PassExecutionPlan& plan, const SequenceSystemUniformState& systemUniforms);
     void initializePassAtomicCounters(SequencePass& pass);
     void preparePassAtomicCounters(SequencePass& pass);
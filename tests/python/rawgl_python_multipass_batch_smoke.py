@@ -2,6 +2,7 @@
 
 from __future__ import annotations
 
+import asyncio
 import math
 import sys
 
@@ -147,6 +148,33 @@ if status != 0:
     raise SystemExit(status)
 print("rawgl_python_multipass_batch_smoke:wait2", flush=True)
 
+if not first_handle.done() or first_handle.wait(timeout=0.0) is None:
+    raise SystemExit(fail("finished batch job handle did not report ready"))
+
+future_handle = prepared.submit()
+future_result = future_handle.future().result(timeout=60.0)
+if future_result.cancelled or not future_result.success:
+    raise SystemExit(fail(f"future batch multipass workflow failed: {future_result.error_message}"))
+status = expect_rgba(future_result.run_result, (0.25, 0.50, 0.75, 1.0))
+if status != 0:
+    raise SystemExit(status)
+
+
+async def await_batch_jobs():
+    handles = [prepared.submit(), prepared.submit()]
+    return await asyncio.gather(*handles)
+
+
+awaited_results = asyncio.run(await_batch_jobs())
+for awaited_result in awaited_results:
+    if awaited_result.cancelled or not awaited_result.success:
+        raise SystemExit(fail(f"awaited batch multipass workflow failed: {awaited_result.error_message}"))
+    status = expect_rgba(awaited_result.run_result, (0.25, 0.50, 0.75, 1.0))
+    if status != 0:
+        raise SystemExit(status)
+print("rawgl_python_multipass_batch_smoke:async", flush=True)
+
+del future_handle
 del first_handle
 del second_handle
 del prepared
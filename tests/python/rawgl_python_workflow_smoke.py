@@ -89,6 +89,26 @@ def verify_inline_lut(session: rawgl.Session) -> int:
         default_lut_array = result.output_array()
         if default_lut_array.shape != (8, 8, 4):
             return fail(f"unexpected RunResultView.output_array() shape: {default_lut_array.shape}")
+        if lut_array.flags.writeable:
+            return fail("captured_output_arrays() returned a writable view")
+        lut_copy = lut_array.copy()
+        getattr(result, "raw_result", result).captured_outputs = {}
+        if not np.array_equal(lut_array, lut_copy):
+            return fail("captured output view changed after the captures were reassigned")
+
+        source = np.arange(4 * 3 * 4, dtype=np.float32).reshape(4, 3, 4)
+        copied_image = rawgl.make_host_image(source)
+        if np.shares_memory(rawgl.host_image_to_array(copied_image), source):
+            return fail("make_host_image() aliased a writable NumPy array without copy=False")
+        host_image = rawgl.make_host_image(source, copy=False)
+        view = rawgl.host_image_to_array(host_image)
+        if not np.shares_memory(view, source):
+            return fail("host_image_to_array() copied adopted NumPy pixels")
+        if view.flags.writeable:
+            return fail("host_image_to_array() returned a writable view over adopted pixels")
+        copied = rawgl.host_image_to_array(host_image, copy=True)
+        if np.shares_memory(copied, source) or not np.array_equal(copied, source):
+            return fail("host_image_to_array(copy=True) did not return an independent copy")
 
     return 0
 
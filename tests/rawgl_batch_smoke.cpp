@@ -5,6 +5,9 @@
 
 #include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
 
 static bool
 verify_core_batch_path()
@@ -116,6 +119,260 @@ void main()
     return true;
 }
 
+static bool
+verify_memory_budget_admission()
+{
+    rawgl::Pass pass;
+    pass.programKind = rawgl::ShaderProgramKind::compute;
+    pass.shaderModules.push_back(rawgl::ShaderModuleDefinition {
+        rawgl::ShaderModuleRole::compute,
+        rawgl::ShaderModuleSourceKind::glslText,
+        "",
+        R"(#version 450 core
+uniform int iFrame;
+layout(rgba32f) writeonly uniform image2D o_out0;
+layout(local_size_x = 1, local_size_y = 1) in;
+void main()
+{
+    imageStore(o_out0, ivec2(0, 0), vec4(float(iFrame), 0.0, 0.0, 1.0));
+}
+)",
+        {},
+        "rawgl_batch_smoke_budget_compute",
+    });
+    pass.sizeX = 1;
+    pass.sizeY = 1;
+    pass.workGroupSizeX = 1;
+    pass.workGroupSizeY = 1;
+    pass.hasExplicitWorkGroupSize = true;
+    pass.outputs.push_back(rawgl::CapturedOutput("o_out0", "rgba32f", 4, 3, 16));
+
+    rawgl::Workflow workflow;
+    workflow.verbosity = 0;
+    workflow.passes.push_back(std::move(pass));
+
+    // One 1x1 rgba32f capture is 16 bytes, so this budget admits a single job at a time.
+    rawgl::batch::BatchRunnerOptions options;
+    options.hostMemoryBudgetBytes = 16u;
+    options.gpuMemoryBudgetBytes = 16u;
+
+    rawgl::Session session;
+    rawgl::batch::BatchRunner runner(session, options);
+    rawgl::batch::BatchPrepareResult prepareResult = runner.prepare(workflow);
+    if (!prepareResult.success || !prepareResult.workflow) {
+        std::cerr << "Budgeted batch prepare failed: " << prepareResult.errorMessage << std::endl;
+        return false;
+    }
+
+    std::vector<rawgl::batch::BatchJobHandle> handles;
+    for (int frame = 0; frame < 3; ++frame) {
+        rawgl::batch::BatchSubmitRequest request;
+        request.settings.systemUniforms = rawgl::SystemUniformState { 0.0, 0.0, frame, 0 };
+        handles.push_back(runner.submit(*prepareResult.workflow, request));
+
+        const rawgl::batch::BatchProgress progress = runner.progress();
+        if (progress.reservedHostBytes > options.hostMemoryBudgetBytes
+            || progress.reservedGpuBytes > options.gpuMemoryBudgetBytes) {
+            std::cerr << "Batch admission exceeded the memory budget." << std::endl;
+            return false;
+        }
+    }
+
+    for (const rawgl::batch::BatchJobHandle& handle : handles) {
+        const rawgl::batch::BatchResult result = handle.wait();
+        if (!result.runResult.success) {
+            std::cerr << "Budgeted batch run failed: " << result.runResult.errorMessage << std::endl;
+            return false;
+        }
+    }
+
+    const rawgl::batch::BatchProgress progress = runner.progress();
+    if (progress.completedJobs != 3u || progress.inFlightJobs != 0u || progress.reservedHostBytes != 0u
+        || progress.reservedGpuBytes != 0u) {
+        std::cerr << "Unexpected budgeted batch progress snapshot." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+verify_completion_delivery(const bool preserveSubmitOrder)
+{
+    rawgl::Pass pass;
+    pass.programKind = rawgl::ShaderProgramKind::compute;
+    pass.shaderModules.push_back(rawgl::ShaderModuleDefinition {
+        rawgl::ShaderModuleRole::compute,
+        rawgl::ShaderModuleSourceKind::glslText,
+        "",
+        R"(#version 450 core
+uniform int iFrame;
+layout(rgba32f) writeonly uniform image2D o_out0;
+layout(local_size_x = 1, local_size_y = 1) in;
+void main()
+{
+    imageStore(o_out0, ivec2(0, 0), vec4(float(iFrame), 0.0, 0.0, 1.0));
+}
+)",
+        {},
+        "rawgl_batch_smoke_completion_compute",
+    });
+    pass.sizeX = 1;
+    pass.sizeY = 1;
+    pass.workGroupSizeX = 1;
+    pass.workGroupSizeY = 1;
+    pass.hasExplicitWorkGroupSize = true;
+    pass.outputs.push_back(rawgl::CapturedOutput("o_out0", "rgba32f", 4, 3, 16));
+
+    rawgl::Workflow workflow;
+    workflow.verbosity = 0;
+    workflow.passes.push_back(std::move(pass));
+
+    rawgl::batch::BatchRunnerOptions options;
+    options.preserveSubmitOrder = preserveSubmitOrder;
+    options.collectCompletions = true;
+
+    rawgl::Session session;
+    rawgl::batch::BatchRunner runner(session, options);
+    rawgl::batch::BatchPrepareResult prepareResult = runner.prepare(workflow);
+    if (!prepareResult.success || !prepareResult.workflow) {
+        std::cerr << "Completion batch prepare failed: " << prepareResult.errorMessage << std::endl;
+        return false;
+    }
+
+    // Handles are dropped immediately; results are only observed through the completion queue.
+    for (int frame = 0; frame < 4; ++frame) {
+        rawgl::batch::BatchSubmitRequest request;
+        request.settings.systemUniforms = rawgl::SystemUniformState { 0.0, 0.0, frame, 0 };
+        runner.submit(*prepareResult.workflow, request);
+    }
+
+    rawgl::batch::BatchResult firstResult;
+    if (!runner.waitNextCompleted(firstResult) || !firstResult.runResult.success) {
+        std::cerr << "Completion queue did not deliver the first batch job." << std::endl;
+        return false;
+    }
+
+    std::vector<rawgl::batch::BatchResult> results = runner.drain();
+    results.insert(results.begin(), std::move(firstResult));
+    if (results.size() != 4u) {
+        std::cerr << "Unexpected completion count: " << results.size() << std::endl;
+        return false;
+    }
+
+    std::vector<bool> seen(results.size(), false);
+    for (size_t resultIndex = 0; resultIndex < results.size(); ++resultIndex) {
+        const rawgl::batch::BatchResult& result = results[resultIndex];
+        if (!result.runResult.success || result.submitIndex >= seen.size() || seen[result.submitIndex]) {
+            std::cerr << "Completion queue delivered an unexpected batch result." << std::endl;
+            return false;
+        }
+        if (preserveSubmitOrder && result.submitIndex != resultIndex) {
+            std::cerr << "Completion queue broke submit order: " << result.submitIndex << std::endl;
+            return false;
+        }
+        seen[result.submitIndex] = true;
+    }
+
+    rawgl::batch::BatchResult extraResult;
+    if (runner.waitNextCompleted(extraResult) || !runner.drain().empty()) {
+        std::cerr << "Completion queue delivered a job twice." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+verify_completion_callback()
+{
+    rawgl::Pass pass;
+    pass.programKind = rawgl::ShaderProgramKind::compute;
+    pass.shaderModules.push_back(rawgl::ShaderModuleDefinition {
+        rawgl::ShaderModuleRole::compute,
+        rawgl::ShaderModuleSourceKind::glslText,
+        "",
+        R"(#version 450 core
+uniform int iFrame;
+layout(rgba32f) writeonly uniform image2D o_out0;
+layout(local_size_x = 1, local_size_y = 1) in;
+void main()
+{
+    imageStore(o_out0, ivec2(0, 0), vec4(float(iFrame), 0.0, 0.0, 1.0));
+}
+)",
+        {},
+        "rawgl_batch_smoke_callback_compute",
+    });
+    pass.sizeX = 1;
+    pass.sizeY = 1;
+    pass.workGroupSizeX = 1;
+    pass.workGroupSizeY = 1;
+    pass.hasExplicitWorkGroupSize = true;
+    pass.outputs.push_back(rawgl::CapturedOutput("o_out0", "rgba32f", 4, 3, 16));
+
+    rawgl::Workflow workflow;
+    workflow.verbosity = 0;
+    workflow.passes.push_back(std::move(pass));
+
+    // Default options leave the completion queue off; drain must still wait and the callback must still fire.
+    std::mutex callbackMutex;
+    std::vector<size_t> callbackIndices;
+    bool callbackFailure = false;
+    rawgl::batch::BatchRunnerOptions options;
+    options.onCompleted = [&](const rawgl::batch::BatchResult& result) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        callbackFailure = callbackFailure || !result.runResult.success || result.cancelled;
+        callbackIndices.push_back(result.submitIndex);
+    };
+
+    rawgl::Session session;
+    rawgl::batch::BatchRunner runner(session, options);
+    rawgl::batch::BatchPrepareResult prepareResult = runner.prepare(workflow);
+    if (!prepareResult.success || !prepareResult.workflow) {
+        std::cerr << "Callback batch prepare failed: " << prepareResult.errorMessage << std::endl;
+        return false;
+    }
+
+    std::vector<rawgl::batch::BatchJobHandle> handles;
+    for (int frame = 0; frame < 4; ++frame) {
+        rawgl::batch::BatchSubmitRequest request;
+        request.settings.systemUniforms = rawgl::SystemUniformState { 0.0, 0.0, frame, 0 };
+        handles.push_back(runner.submit(*prepareResult.workflow, request));
+    }
+
+    if (!runner.drain().empty()) {
+        std::cerr << "Drain returned results without the completion queue." << std::endl;
+        return false;
+    }
+    for (const rawgl::batch::BatchJobHandle& handle : handles) {
+        if (!handle.isReady()) {
+            std::cerr << "Drain returned before every batch job finished." << std::endl;
+            return false;
+        }
+    }
+
+    rawgl::batch::BatchResult extraResult;
+    if (runner.waitNextCompleted(extraResult)) {
+        std::cerr << "waitNextCompleted delivered a job without the completion queue." << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (callbackFailure || callbackIndices.size() != handles.size()) {
+        std::cerr << "Completion callback saw " << callbackIndices.size() << " jobs." << std::endl;
+        return false;
+    }
+    for (size_t callbackIndex = 0; callbackIndex < callbackIndices.size(); ++callbackIndex) {
+        if (callbackIndices[callbackIndex] != callbackIndex) {
+            std::cerr << "Completion callback broke submit order: " << callbackIndices[callbackIndex] << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static bool
 verify_io_batch_path()
 {
@@ -285,6 +542,43 @@ void main()
         return false;
     }
 
+    std::vector<std::filesystem::path> decodedOutputPaths;
+    std::vector<rawgl::batch::BatchJobHandle> decodedHandles;
+    for (size_t jobIndex = 0; jobIndex < 3u; ++jobIndex) {
+        const std::filesystem::path decodedOutputPath = std::filesystem::absolute(
+            "tests/outputs/rawgl_batch_decoded_" + std::to_string(jobIndex) + ".png");
+        std::filesystem::remove(decodedOutputPath, removeError);
+        decodedOutputPaths.push_back(decodedOutputPath);
+
+        rawgl::batch::BatchSubmitRequest decodedRequest;
+        decodedRequest.fileInputs.push_back(rawgl::io::FileTextureOverride(0, "u_src0", inputPath.string()));
+        decodedRequest.fileOutputs.push_back(
+            rawgl::io::FileOutput(0, "out_color", decodedOutputPath.string(), "rgba32f", 4, 3, 16));
+        decodedHandles.push_back(runner.submit(*dynamicPrepare.workflow, decodedRequest));
+    }
+
+    rawgl::batch::BatchSubmitRequest missingInputRequest;
+    missingInputRequest.fileInputs.push_back(
+        rawgl::io::FileTextureOverride(0, "u_src0", std::filesystem::absolute("tests/inputs/missing.png").string()));
+    rawgl::batch::BatchJobHandle missingInputHandle = runner.submit(*dynamicPrepare.workflow, missingInputRequest);
+
+    for (size_t jobIndex = 0; jobIndex < decodedHandles.size(); ++jobIndex) {
+        rawgl::batch::BatchResult decodedResult = decodedHandles[jobIndex].wait();
+        if (!decodedResult.runResult.success) {
+            std::cerr << "Batch job with per-run file input failed: " << decodedResult.runResult.errorMessage
+                      << std::endl;
+            return false;
+        }
+        if (!std::filesystem::exists(decodedOutputPaths[jobIndex])) {
+            std::cerr << "Batch job with per-run file input did not write output image." << std::endl;
+            return false;
+        }
+    }
+    if (missingInputHandle.wait().runResult.success) {
+        std::cerr << "Batch job with missing per-run file input unexpectedly succeeded." << std::endl;
+        return false;
+    }
+
     rawgl::Session coreOnlySession;
     rawgl::batch::BatchRunner coreOnlyRunner(coreOnlySession);
     rawgl::batch::BatchPrepareResult coreOnlyPrepare = coreOnlyRunner.prepare(multiOutputWorkflow);
@@ -311,6 +605,15 @@ main()
     if (!verify_core_batch_path()) {
         return 1;
     }
+    if (!verify_memory_budget_admission()) {
+        return 1;
+    }
+    if (!verify_completion_delivery(true) || !verify_completion_delivery(false)) {
+        return 1;
+    }
+    if (!verify_completion_callback()) {
+        return 1;
+    }
     if (!verify_io_batch_path()) {
         return 1;
     }
@@ -39,18 +39,33 @@ main()
         "input.png",
         "--in_backend",
         "native_only",
+        "--in_decode_scale",
+        "4",
         "--in_jpeg_color_transform",
         "rgb",
+        "--in_jpeg_dct_method",
+        "fast",
+        "--in_jpeg_fancy_upsampling",
+        "false",
         "--in_png_expand_transparency",
         "false",
         "--in_tiff_directory_index",
         "2",
         "--in_exr_channels",
         "rgba",
+        "--in_exr_threads",
+        "4",
         "--in_jpeg2000_reduce_factor",
         "1",
         "--in_jpeg2000_layer_limit",
         "2",
+        "--in_jpeg2000_region",
+        "8",
+        "4",
+        "64",
+        "32",
+        "--in_jpeg2000_threads",
+        "6",
         "--out",
         "OutSample",
         "output.exr",
@@ -70,6 +85,8 @@ main()
         "true",
         "--out_jpeg_subsampling",
         "444",
+        "--out_jpeg_dct_method",
+        "float",
         "--out_png_compression",
         "2",
         "--out_png_interlace",
@@ -114,12 +131,16 @@ main()
         "decreasing_y",
         "--out_exr_dwa_level",
         "45.5",
+        "--out_exr_threads",
+        "3",
         "--out_jpeg2000_lossless",
         "false",
         "--out_jpeg2000_compression_ratio",
         "8.5",
         "--out_jpeg2000_quality",
         "42.0",
+        "--out_jpeg2000_threads",
+        "5",
     };
 
     rawgl::CommandLineRequest request;
@@ -137,10 +158,17 @@ main()
 
     const rawgl::io::ImageCodecLoadOptions& load = workflow.fileInputs[0].codecOptions;
     if (!load.hasBackendPolicy || load.backendPolicy != rawgl::io::ImageLoadBackendPolicy::NativeOnly
+        || !load.hasDecodeScale || load.decodeScale != 4u
         || !load.hasJpeg || load.jpeg.colorTransform != rawgl::io::JpegLoadColorTransform::Rgb
+        || !load.jpeg.hasDctMethod || load.jpeg.dctMethod != rawgl::io::JpegDctMethod::Fast
+        || !load.jpeg.hasFancyUpsampling || load.jpeg.fancyUpsampling
         || !load.hasPng || load.png.expandTransparency || !load.hasTiff || load.tiff.directoryIndex != 2u
         || !load.hasOpenExr || load.openExr.channelSelection != rawgl::io::OpenExrChannelSelection::Rgba
-        || !load.hasJpeg2000 || load.jpeg2000.reduceFactor != 1u || load.jpeg2000.layerLimit != 2u) {
+        || !load.openExr.hasThreadCount || load.openExr.threadCount != 4u
+        || !load.hasJpeg2000 || load.jpeg2000.reduceFactor != 1u || load.jpeg2000.layerLimit != 2u
+        || !load.jpeg2000.hasRegion || load.jpeg2000.regionX != 8u || load.jpeg2000.regionY != 4u
+        || load.jpeg2000.regionWidth != 64u || load.jpeg2000.regionHeight != 32u
+        || !load.jpeg2000.hasThreadCount || load.jpeg2000.threadCount != 6u) {
         std::cerr << "Input codec options were not translated correctly." << std::endl;
         return 1;
     }
@@ -153,7 +181,8 @@ main()
 
     const rawgl::io::ImageCodecSaveOptions& save = output.codecOptions;
     if (!save.hasJpeg || save.jpeg.quality != 92 || !save.jpeg.progressive || !save.jpeg.optimize
-        || save.jpeg.subsampling != rawgl::io::JpegChromaSubsampling::S444 || !save.hasPng
+        || save.jpeg.subsampling != rawgl::io::JpegChromaSubsampling::S444
+        || !save.jpeg.hasDctMethod || save.jpeg.dctMethod != rawgl::io::JpegDctMethod::Float || !save.hasPng
         || save.png.compressionLevel != 2 || save.png.interlaced || !save.hasTiff
         || save.tiff.compression != rawgl::io::TiffCompressionMode::Deflate
         || save.tiff.predictor != rawgl::io::TiffPredictorMode::Float
@@ -165,8 +194,10 @@ main()
         || save.openExr.compression != rawgl::io::OpenExrCompressionMode::Zip
         || save.openExr.layout != rawgl::io::OpenExrStorageLayout::Tiled || save.openExr.tileWidth != 64u
         || save.openExr.tileHeight != 32u || save.openExr.lineOrder != rawgl::io::OpenExrLineOrder::DecreasingY
-        || save.openExr.dwaCompressionLevel != 45.5f || !save.hasJpeg2000 || save.jpeg2000.lossless
-        || save.jpeg2000.compressionRatio != 8.5f || save.jpeg2000.quality != 42.0f) {
+        || save.openExr.dwaCompressionLevel != 45.5f || !save.openExr.hasThreadCount
+        || save.openExr.threadCount != 3u || !save.hasJpeg2000 || save.jpeg2000.lossless
+        || save.jpeg2000.compressionRatio != 8.5f || save.jpeg2000.quality != 42.0f
+        || !save.jpeg2000.hasThreadCount || save.jpeg2000.threadCount != 5u) {
         std::cerr << "Output codec options were not translated correctly." << std::endl;
         return 1;
     }
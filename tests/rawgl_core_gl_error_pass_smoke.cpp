@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#include "rawgl/rawgl.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+rawgl::Pass
+make_compute_pass(const char* path)
+{
+    rawgl::Pass pass;
+    pass.programKind = rawgl::ShaderProgramKind::compute;
+    rawgl::ShaderModuleDefinition module;
+    module.role       = rawgl::ShaderModuleRole::compute;
+    module.sourceKind = rawgl::ShaderModuleSourceKind::filePath;
+    module.path       = path;
+    pass.shaderModules.push_back(std::move(module));
+    pass.sizeX                    = 1;
+    pass.sizeY                    = 1;
+    pass.workGroupSizeX           = 1;
+    pass.workGroupSizeY           = 1;
+    pass.hasExplicitWorkGroupSize = true;
+    return pass;
+}
+
+}  // namespace
+
+// Pass 1 writes to an rgb32ui image, which glBindImageTexture rejects. The pass policy comes from the session
+// options, or from RAWGL_GL_ERRORS=pass overriding an `off` option when the variable is set.
+int
+main()
+{
+    const char* environmentPolicy = std::getenv("RAWGL_GL_ERRORS");
+    rawgl::SessionOptions sessionOptions;
+    sessionOptions.glErrorPolicy = environmentPolicy != nullptr && environmentPolicy[0] != '\0' ? "off" : "pass";
+
+    rawgl::ContextOptions contextOptions;
+    contextOptions.glErrorPolicy = sessionOptions.glErrorPolicy;
+    const rawgl::RuntimeInfo runtimeInfo = rawgl::ProbeRuntimeInfo(contextOptions);
+    if (runtimeInfo.glErrorPolicy != "pass") {
+        std::cerr << "Expected the pass OpenGL error policy, got '" << runtimeInfo.glErrorPolicy << "'." << std::endl;
+        return 1;
+    }
+
+    rawgl::Pass sourcePass = make_compute_pass("tests/shaders/image_chain_source.comp");
+    rawgl::OutputBinding sourceOutput;
+    sourceOutput.name         = "o_mid0";
+    sourceOutput.format       = "rgba32f";
+    sourceOutput.channels     = 4;
+    sourceOutput.alphaChannel = 3;
+    sourceOutput.bits         = 16;
+    sourcePass.outputs.push_back(std::move(sourceOutput));
+
+    rawgl::Pass consumePass = make_compute_pass("tests/shaders/image_chain_consume.comp");
+    rawgl::InputBinding midInput;
+    midInput.name                 = "u_mid0";
+    midInput.sourceKind           = rawgl::InputSourceKind::passOutput;
+    midInput.referencedOutputName = "o_mid0";
+    midInput.referencedPassIndex  = 0;
+    consumePass.inputs.push_back(std::move(midInput));
+    consumePass.outputs.push_back(rawgl::CapturedOutput("o_out0", "rgb32ui", 3, -1, 32));
+
+    rawgl::Workflow workflow;
+    workflow.verbosity = 0;
+    workflow.passes.push_back(std::move(sourcePass));
+    workflow.passes.push_back(std::move(consumePass));
+
+    rawgl::Session session(sessionOptions);
+    rawgl::PrepareResult prepareResult = session.prepare(workflow);
+    if (!prepareResult.success || !prepareResult.workflow) {
+        std::cerr << "Workflow preparation failed: " << prepareResult.errorMessage << std::endl;
+        return 1;
+    }
+
+    const rawgl::RunResult runResult = prepareResult.workflow->run(rawgl::RunSettings {});
+    if (runResult.success) {
+        std::cerr << "Expected the run to fail on the OpenGL error raised by pass 1." << std::endl;
+        return 1;
+    }
+    if (runResult.errorMessage.find("Pass 1: OpenGL error") == std::string::npos) {
+        std::cerr << "Unexpected run error: " << runResult.errorMessage << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
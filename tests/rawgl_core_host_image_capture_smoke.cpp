@@ -5,6 +5,7 @@
 
 #include <GL/glew.h>
 
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -96,6 +97,43 @@ verify_captured_counter(const rawgl::RunResult& executionResult,
     return true;
 }
 
+bool
+verify_packed_capture(const rawgl::RunResult& executionResult,
+                      const GLenum glType,
+                      const GLenum glInternalFormat,
+                      const uint16_t expected[4])
+{
+    const auto outputIt = executionResult.capturedOutputs.find("o_out0::0");
+    if (outputIt == executionResult.capturedOutputs.end()) {
+        std::cerr << "Missing packed captured output" << std::endl;
+        return false;
+    }
+
+    const rawgl::HostImageData& hostImage = outputIt->second;
+    const size_t sampleBytes = glType == GL_UNSIGNED_BYTE ? 1u : 2u;
+    if (hostImage.glType != glType || hostImage.glInternalFormat != glInternalFormat || hostImage.channels != 4
+        || hostImage.bytes.size() != sampleBytes * 4u) {
+        std::cerr << "Packed captured output metadata is invalid" << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < 4u; ++i) {
+        uint16_t sample = 0;
+        if (sampleBytes == 1u) {
+            sample = static_cast<uint8_t>(hostImage.bytes[i]);
+        } else {
+            std::memcpy(&sample, hostImage.bytes.data() + i * 2u, sizeof(sample));
+        }
+        if (sample != expected[i]) {
+            std::cerr << "Unexpected packed sample " << i << ": " << sample << " instead of " << expected[i]
+                      << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 rawgl::Workflow
 make_host_capture_workflow()
 {
@@ -123,6 +161,41 @@ make_host_capture_workflow()
     return workflow;
 }
 
+rawgl::Workflow
+make_packed_capture_workflow(const rawgl::CaptureSampleType sampleType)
+{
+    rawgl::Workflow workflow = make_host_capture_workflow();
+    rawgl::Pass& pass        = workflow.passes[0];
+    pass.inputs[0] = rawgl::HostTextureInput("u_src0", make_rgba32f_host_image(1.5f, -0.25f, 0.5f, 0.2f));
+    pass.outputs[0].captureSampleType = sampleType;
+    return workflow;
+}
+
+bool
+verify_packed_captures(rawgl::Session& session)
+{
+    // Out-of-range samples clamp, and rounding matches the CPU encoders: 0.2 * 255 + 0.5 truncates to 51.
+    const uint16_t expected8[4]  = { 255u, 0u, 128u, 51u };
+    const uint16_t expected16[4] = { 65535u, 0u, 32768u, 13107u };
+
+    rawgl::PrepareResult unorm8 = session.prepare(make_packed_capture_workflow(rawgl::CaptureSampleType::unorm8));
+    rawgl::PrepareResult unorm16 = session.prepare(make_packed_capture_workflow(rawgl::CaptureSampleType::unorm16));
+    if (!unorm8.success || !unorm16.success) {
+        std::cerr << "Packed capture workflow preparation failed" << std::endl;
+        return false;
+    }
+
+    const rawgl::RunResult unorm8Run  = unorm8.workflow->run(rawgl::RunSettings {});
+    const rawgl::RunResult unorm16Run = unorm16.workflow->run(rawgl::RunSettings {});
+    if (!unorm8Run.success || !unorm16Run.success) {
+        std::cerr << "Packed capture workflow execution failed" << std::endl;
+        return false;
+    }
+
+    return verify_packed_capture(unorm8Run, GL_UNSIGNED_BYTE, GL_RGBA8, expected8)
+           && verify_packed_capture(unorm16Run, GL_UNSIGNED_SHORT, GL_RGBA16, expected16);
+}
+
 }  // namespace
 
 int
@@ -168,5 +241,9 @@ main()
         return 1;
     }
 
+    if (!verify_packed_captures(session)) {
+        return 1;
+    }
+
     return 0;
 }
@@ -186,5 +186,35 @@ main()
         return 1;
     }
 
+    // The first override of an input wins, and overrides do not carry over into later runs.
+    rawgl::RunSettings repeatedOverrideRun;
+    for (const float gain : { 0.5f, 0.125f }) {
+        rawgl::InputOverride repeatedGain;
+        repeatedGain.passIndex   = 0;
+        repeatedGain.name        = "gain";
+        repeatedGain.sourceKind  = rawgl::InputSourceKind::floatValues;
+        repeatedGain.floatValues = { gain };
+        repeatedOverrideRun.overrides.push_back(std::move(repeatedGain));
+    }
+
+    const rawgl::RunResult repeatedOverriddenRun = prepareResult.workflow->run(repeatedOverrideRun);
+    if (!repeatedOverriddenRun.success) {
+        std::cerr << "Repeated-override workflow execution failed: " << repeatedOverriddenRun.errorMessage
+                  << std::endl;
+        return 1;
+    }
+    if (!verify_output(repeatedOverriddenRun, 0.5f)) {
+        return 1;
+    }
+
+    const rawgl::RunResult restoredRun = prepareResult.workflow->run(rawgl::RunSettings {});
+    if (!restoredRun.success) {
+        std::cerr << "Restored workflow execution failed: " << restoredRun.errorMessage << std::endl;
+        return 1;
+    }
+    if (!verify_output(restoredRun, 0.25f)) {
+        return 1;
+    }
+
     return 0;
 }
@@ -193,5 +193,28 @@ main()
         return 1;
     }
 
+    // Later runs render into the texture read two runs earlier, so each output must still be the previous seed.
+    const float laterSeeds[] = { 0.25f, 0.125f, 1.0f };
+    float previousSeed       = 0.75f;
+    for (const float laterSeed : laterSeeds) {
+        rawgl::io::RunRequest laterRun;
+        rawgl::InputOverride laterSeedOverride;
+        laterSeedOverride.passIndex   = 0;
+        laterSeedOverride.name        = "seed";
+        laterSeedOverride.sourceKind  = rawgl::InputSourceKind::floatValues;
+        laterSeedOverride.floatValues = { laterSeed };
+        laterRun.settings.overrides.push_back(std::move(laterSeedOverride));
+
+        const rawgl::RunResult laterResult = prepareResult.workflow->run(laterRun);
+        if (!laterResult.success) {
+            std::cerr << "Later persistent workflow execution failed: " << laterResult.errorMessage << std::endl;
+            return 1;
+        }
+        if (!verify_output(outputPath, previousSeed)) {
+            return 1;
+        }
+        previousSeed = laterSeed;
+    }
+
     return 0;
 }
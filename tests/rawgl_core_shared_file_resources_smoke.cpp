@@ -198,9 +198,21 @@ main()
     }
 
     const rawgl::SessionStats textureStats = session.stats();
-    if (textureStats.textures != 0) {
-        std::cerr << "IO-materialized file inputs should not populate the core shared texture cache, got "
-                  << textureStats.textures << std::endl;
+    if (textureStats.textures != 1 || textureStats.textureMisses != 1 || textureStats.textureHits != 1) {
+        std::cerr << "Expected one shared texture uploaded once and reused once, got " << textureStats.textures
+                  << " textures, " << textureStats.textureMisses << " misses, " << textureStats.textureHits
+                  << " hits" << std::endl;
+        return 1;
+    }
+
+    rawgl::SessionOptions uncachedOptions;
+    uncachedOptions.textureCacheBudgetBytes = 0;
+    rawgl::Session uncachedSession(uncachedOptions);
+    if (!build_and_run(uncachedSession, ioRuntime, make_texture_workflow(texOutB), texOutB)) {
+        return 1;
+    }
+    if (uncachedSession.stats().textures != 0) {
+        std::cerr << "A zero texture cache budget should disable texture reuse." << std::endl;
         return 1;
     }
 
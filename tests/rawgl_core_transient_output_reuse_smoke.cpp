@@ -21,9 +21,9 @@ make_file_module(const rawgl::ShaderProgramKind programKind, const char* path)
 }
 
 bool
-read_pixel_rgba32f(const rawgl::RunResult& runResult, float pixel[4])
+read_pixel_rgba32f(const rawgl::RunResult& runResult, const char* captureName, float pixel[4])
 {
-    const auto captureIt = runResult.capturedOutputs.find("o_out0::1");
+    const auto captureIt = runResult.capturedOutputs.find(captureName);
     if (captureIt == runResult.capturedOutputs.end()) {
         return false;
     }
@@ -35,10 +35,10 @@ read_pixel_rgba32f(const rawgl::RunResult& runResult, float pixel[4])
 }
 
 bool
-verify_output(const rawgl::RunResult& runResult)
+verify_output(const rawgl::RunResult& runResult, const char* captureName = "o_out0::1")
 {
     float pixel[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    if (!read_pixel_rgba32f(runResult, pixel)) {
+    if (!read_pixel_rgba32f(runResult, captureName, pixel)) {
         std::cerr << "Unable to read captured output image." << std::endl;
         return false;
     }
@@ -52,6 +52,38 @@ verify_output(const rawgl::RunResult& runResult)
     return true;
 }
 
+rawgl::Pass
+make_copy_pass(const size_t sourcePassIndex, const char* sourceOutputName, const bool capture)
+{
+    rawgl::Pass copyPass;
+    copyPass.programKind              = rawgl::ShaderProgramKind::compute;
+    copyPass.shaderModules.push_back(make_file_module(rawgl::ShaderProgramKind::compute, "tests/shaders/image_chain_consume.comp"));
+    copyPass.sizeX                    = 1;
+    copyPass.sizeY                    = 1;
+    copyPass.workGroupSizeX           = 1;
+    copyPass.workGroupSizeY           = 1;
+    copyPass.hasExplicitWorkGroupSize = true;
+    rawgl::InputBinding sourceInput;
+    sourceInput.name                 = "u_mid0";
+    sourceInput.sourceKind           = rawgl::InputSourceKind::passOutput;
+    sourceInput.referencedOutputName = sourceOutputName;
+    sourceInput.referencedPassIndex  = sourcePassIndex;
+    copyPass.inputs.push_back(std::move(sourceInput));
+
+    if (capture) {
+        copyPass.outputs.push_back(rawgl::CapturedOutput("o_out0", "rgba32f", 4, 3, 16));
+    } else {
+        rawgl::OutputBinding copyOutput;
+        copyOutput.name         = "o_out0";
+        copyOutput.format       = "rgba32f";
+        copyOutput.channels     = 4;
+        copyOutput.alphaChannel = 3;
+        copyOutput.bits         = 16;
+        copyPass.outputs.push_back(std::move(copyOutput));
+    }
+    return copyPass;
+}
+
 rawgl::Workflow
 make_transient_reuse_workflow()
 {
@@ -95,6 +127,74 @@ make_transient_reuse_workflow()
     return workflow;
 }
 
+bool
+verify_pool_stats(const rawgl::SessionStats& stats,
+                  const size_t pooled,
+                  const uint64_t hits,
+                  const uint64_t misses,
+                  const char* stage)
+{
+    if (stats.outputTexturesPooled != pooled || stats.outputTexturePoolHits != hits
+        || stats.outputTexturePoolMisses != misses) {
+        std::cerr << "Unexpected output texture pool stats " << stage << ": pooled " << stats.outputTexturesPooled
+                  << ", hits " << stats.outputTexturePoolHits << ", misses " << stats.outputTexturePoolMisses
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+verify_unpooled_runs()
+{
+    rawgl::SessionOptions options;
+    options.outputTexturePoolBudgetBytes = 0;
+    rawgl::Session session(options);
+    rawgl::PrepareResult prepareResult = session.prepare(make_transient_reuse_workflow());
+    if (!prepareResult.success || !prepareResult.workflow) {
+        std::cerr << "Unpooled workflow preparation failed: " << prepareResult.errorMessage << std::endl;
+        return false;
+    }
+
+    for (int run = 0; run < 2; ++run) {
+        const rawgl::RunResult runResult = prepareResult.workflow->run(rawgl::RunSettings {});
+        if (!runResult.success || !verify_output(runResult)) {
+            std::cerr << "Unpooled workflow execution failed: " << runResult.errorMessage << std::endl;
+            return false;
+        }
+    }
+
+    return verify_pool_stats(session.stats(), 0u, 0u, 0u, "with pooling disabled");
+}
+
+// Pass 2 writes after the last read of pass 0's output, so both share one texture; the captured output stays private.
+bool
+verify_aliased_chain()
+{
+    rawgl::Workflow workflow = make_transient_reuse_workflow();
+    workflow.passes[1]       = make_copy_pass(0u, "o_mid0", false);
+    workflow.passes.push_back(make_copy_pass(1u, "o_out0", false));
+    workflow.passes.push_back(make_copy_pass(2u, "o_out0", true));
+
+    rawgl::Session session;
+    rawgl::PrepareResult prepareResult = session.prepare(workflow);
+    if (!prepareResult.success || !prepareResult.workflow) {
+        std::cerr << "Aliased chain preparation failed: " << prepareResult.errorMessage << std::endl;
+        return false;
+    }
+
+    for (int run = 0; run < 2; ++run) {
+        const rawgl::RunResult runResult = prepareResult.workflow->run(rawgl::RunSettings {});
+        if (!runResult.success || !verify_output(runResult, "o_out0::3")) {
+            std::cerr << "Aliased chain execution failed: " << runResult.errorMessage << std::endl;
+            return false;
+        }
+    }
+
+    return verify_pool_stats(session.stats(), 3u, 3u, 3u, "for the aliased chain");
+}
+
 }  // namespace
 
 int
@@ -115,6 +215,10 @@ main()
     if (!verify_output(firstRun)) {
         return 1;
     }
+    // Both outputs are allocated at prepare time and handed back to the pool after the run.
+    if (!verify_pool_stats(session.stats(), 2u, 0u, 2u, "after the first run")) {
+        return 1;
+    }
 
     const rawgl::RunResult secondRun = prepareResult.workflow->run(rawgl::RunSettings {});
     if (!secondRun.success) {
@@ -124,6 +228,17 @@ main()
     if (!verify_output(secondRun)) {
         return 1;
     }
+    if (!verify_pool_stats(session.stats(), 2u, 2u, 2u, "after the second run")) {
+        return 1;
+    }
+
+    if (!verify_unpooled_runs()) {
+        return 1;
+    }
+
+    if (!verify_aliased_chain()) {
+        return 1;
+    }
 
     return 0;
 }
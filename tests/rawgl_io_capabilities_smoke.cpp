@@ -109,8 +109,10 @@ main()
         return 1;
     }
     if (jpeg->nativeRead &&
-        !expect_strings(jpeg->nativeReadOptions, { "jpeg:color_transform" }, "Native JPEG reader options")) {
-        std::cerr << "Native JPEG reader did not report color transform options." << std::endl;
+        !expect_strings(jpeg->nativeReadOptions,
+                        { "jpeg:color_transform", "rawgl:decode_scale", "jpeg:dct_method", "jpeg:fancy_upsampling" },
+                        "Native JPEG reader options")) {
+        std::cerr << "Native JPEG reader did not report color transform, decode scale, and IDCT options." << std::endl;
         return 1;
     }
     if (jpeg->nativeWrite &&
@@ -118,7 +120,8 @@ main()
                         { "jpeg:quality", "jpg:quality", "oiio:Compression",
                           "jpeg:progressive", "jpg:progressive",
                           "jpeg:optimize", "jpg:optimize",
-                          "jpeg:subsampling", "jpg:subsampling" },
+                          "jpeg:subsampling", "jpg:subsampling",
+                          "jpeg:dct_method", "jpg:dct_method" },
                         "Native JPEG writer options")) {
         return 1;
     }
@@ -175,6 +178,7 @@ main()
                           "openexr:tileLength", "openexr:tile_length",
                           "openexr:lineOrder", "openexr:line_order",
                           "openexr:dwaCompressionLevel", "openexr:dwa_compression_level",
+                          "openexr:threads",
                           "openexr:attribute:string:<name>" },
                         "Native OpenEXR writer options")) {
         return 1;
@@ -182,7 +186,8 @@ main()
     if (openexr->nativeRead &&
         !expect_strings(openexr->nativeReadOptions,
                         { "rawgl:load_backend", "rawgl:decode_backend",
-                          "openexr:channel_selection", "openexr:channelSelection" },
+                          "openexr:channel_selection", "openexr:channelSelection",
+                          "openexr:threads" },
                         "Native OpenEXR reader options")) {
         return 1;
     }
@@ -200,7 +205,8 @@ main()
         !expect_strings(jpeg2000->nativeReadOptions,
                         { "rawgl:load_backend", "rawgl:decode_backend",
                           "jpeg2000:reduce_factor", "jpeg2000:reduce",
-                          "jpeg2000:layer_limit", "jpeg2000:layers" },
+                          "jpeg2000:layer_limit", "jpeg2000:layers",
+                          "jpeg2000:region", "jpeg2000:threads" },
                         "Native JPEG-2000 reader options")) {
         return 1;
     }
@@ -3,10 +3,14 @@
 
 #include "rawgl/rawgl_io.h"
 
+#include <GL/glew.h>
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <filesystem>
 #include <iostream>
+#include <new>
 
 #if __has_include(<tiffio.h>)
 #include <tiffio.h>
@@ -18,6 +22,35 @@
 #define RAWGL_TEST_HAS_OPENEXR 1
 #endif
 
+// Counts heap allocations of at least the armed size, to catch full-size copies of captured pixels.
+static std::atomic<size_t> s_largeAllocationThreshold { 0 };
+static std::atomic<size_t> s_largeAllocationCount { 0 };
+
+void*
+operator new(const size_t size)
+{
+    const size_t threshold = s_largeAllocationThreshold.load(std::memory_order_relaxed);
+    if (threshold != 0u && size >= threshold) {
+        s_largeAllocationCount.fetch_add(1u, std::memory_order_relaxed);
+    }
+    if (void* pointer = std::malloc(size == 0u ? 1u : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void
+operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
 int
 main()
 {
@@ -29,6 +62,7 @@ main()
     const std::filesystem::path tiffBigOutputPath = "tests/outputs/rawgl_io_host_image_smoke_big.tif";
     const std::filesystem::path exrOutputPath = "tests/outputs/rawgl_io_host_image_smoke.exr";
     const std::filesystem::path materializedOutputPath = "tests/outputs/rawgl_io_materialized_output_smoke.png";
+    const std::filesystem::path capturedOutputPath = "tests/outputs/rawgl_io_captured_output_smoke.png";
 
     std::error_code removeError;
     std::filesystem::remove(outputPath, removeError);
@@ -37,6 +71,7 @@ main()
     std::filesystem::remove(tiffBigOutputPath, removeError);
     std::filesystem::remove(exrOutputPath, removeError);
     std::filesystem::remove(materializedOutputPath, removeError);
+    std::filesystem::remove(capturedOutputPath, removeError);
 
     rawgl::io::ImageLoadRequest loadRequest;
     loadRequest.path = inputPath.string();
@@ -459,6 +494,42 @@ main()
         return 1;
     }
 
+    // An 8-bit save of a float capture needs at most a quarter of the capture size, so any allocation of the
+    // full capture size is a copy of its pixels.
+    rawgl::HostImageData capturedImage;
+    capturedImage.width = 256;
+    capturedImage.height = 256;
+    capturedImage.channels = 4;
+    capturedImage.alphaChannel = 3;
+    capturedImage.glInternalFormat = GL_RGBA32F;
+    capturedImage.glType = GL_FLOAT;
+    capturedImage.bytes.resize(static_cast<size_t>(capturedImage.width) * capturedImage.height
+                               * capturedImage.channels * sizeof(float));
+    const size_t capturedByteCount = capturedImage.bytes.size();
+
+    rawgl::RunResult capturedRunResult;
+    capturedRunResult.success = true;
+    capturedRunResult.capturedOutputs.insert({ "out_color::0", std::move(capturedImage) });
+
+    std::vector<rawgl::io::OutputSaveBinding> capturedSaves(1u);
+    capturedSaves[0].output = rawgl::io::FileOutput(0, "out_color", capturedOutputPath.string());
+    capturedSaves[0].output.alphaChannel = 3;
+    capturedSaves[0].output.bits = 8;
+
+    s_largeAllocationCount.store(0u);
+    s_largeAllocationThreshold.store(capturedByteCount);
+    const rawgl::io::SaveOutputsResult capturedSaveResult =
+        ioRuntime.saveCapturedOutputs(capturedSaves, capturedRunResult);
+    s_largeAllocationThreshold.store(0u);
+    if (!capturedSaveResult.success || !std::filesystem::exists(capturedOutputPath)) {
+        std::cerr << "Saving a captured output failed: " << capturedSaveResult.errorMessage << std::endl;
+        return 1;
+    }
+    if (s_largeAllocationCount.load() != 0u) {
+        std::cerr << "Saving a captured output copied its pixels." << std::endl;
+        return 1;
+    }
+
     rawgl::io::RunRequest runRequest;
     runRequest.fileInputs.push_back(rawgl::io::FileTextureOverride(0, "u_src0", inputPath.string()));
 
@@ -480,5 +551,46 @@ main()
         return 1;
     }
 
+    if (!materializedOverride.hostTexture->sharedBytes
+        || materializedOverride.hostTexture->pixelBytes().empty()) {
+        std::cerr << "Materialized host texture does not carry shared decoded pixels." << std::endl;
+        return 1;
+    }
+
+    rawgl::io::IoRuntime cachedRuntime;
+    const rawgl::io::ImageLoadResult firstCachedLoad = cachedRuntime.loadImageFile(loadRequest);
+    const rawgl::io::ImageLoadResult secondCachedLoad = cachedRuntime.loadImageFile(loadRequest);
+    if (!firstCachedLoad.success || !secondCachedLoad.success
+        || firstCachedLoad.image.bytes != secondCachedLoad.image.bytes) {
+        std::cerr << "Repeated cached image loads did not match." << std::endl;
+        return 1;
+    }
+
+    const rawgl::io::RunSettingsMaterializationResult firstSharedSettings =
+        cachedRuntime.materializeRunSettings(runRequest);
+    const rawgl::io::RunSettingsMaterializationResult secondSharedSettings =
+        cachedRuntime.materializeRunSettings(runRequest);
+    if (!firstSharedSettings.success || !secondSharedSettings.success
+        || firstSharedSettings.settings.overrides[0].hostTexture->sharedBytes
+               != secondSharedSettings.settings.overrides[0].hostTexture->sharedBytes) {
+        std::cerr << "Cached file inputs did not share one decoded pixel buffer." << std::endl;
+        return 1;
+    }
+
+    const rawgl::io::IoCacheStats cacheStats = cachedRuntime.cacheStats();
+    if (cacheStats.entries != 2u || cacheStats.misses != 2u || cacheStats.hits != 2u || cacheStats.bytes == 0u) {
+        std::cerr << "Unexpected decode cache stats: entries=" << cacheStats.entries << " hits=" << cacheStats.hits
+                  << " misses=" << cacheStats.misses << std::endl;
+        return 1;
+    }
+
+    rawgl::io::IoRuntimeOptions uncachedOptions;
+    uncachedOptions.decodeCacheBudgetBytes = 0;
+    rawgl::io::IoRuntime uncachedRuntime(uncachedOptions);
+    if (!uncachedRuntime.loadImageFile(loadRequest).success || uncachedRuntime.cacheStats().entries != 0u) {
+        std::cerr << "Disabled decode cache retained decoded images." << std::endl;
+        return 1;
+    }
+
     return 0;
 }
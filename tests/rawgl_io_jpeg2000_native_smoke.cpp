@@ -3,6 +3,8 @@
 
 #include "rawgl/rawgl_io.h"
 
+#include "image_backend.h"
+
 #include <GL/glew.h>
 
 #include <cstddef>
@@ -266,6 +268,85 @@ expect_jpeg2000_load_failure(const char* label,
     return true;
 }
 
+static bool
+run_jpeg2000_region_case()
+{
+    Jpeg2000TestCase testCase;
+    testCase.label = "jp2-region-threads";
+    testCase.path = "tests/outputs/rawgl_io_jpeg2000_native_region.jp2";
+    testCase.width = 48;
+    testCase.height = 40;
+    testCase.channels = 3;
+    testCase.glInternalFormat = GL_RGB8;
+    testCase.glType = GL_UNSIGNED_BYTE;
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(testCase.path).parent_path(), error);
+    const rawgl::HostImageData source = make_test_image(testCase);
+    if (!save_jpeg2000_case(testCase, source)) {
+        return false;
+    }
+
+    rawgl::io::ImageLoadRequest request;
+    request.path = testCase.path;
+    request.codecOptions = make_load_options();
+    request.codecOptions.jpeg2000.hasRegion = true;
+    request.codecOptions.jpeg2000.regionX = 5;
+    request.codecOptions.jpeg2000.regionY = 3;
+    request.codecOptions.jpeg2000.regionWidth = 21;
+    request.codecOptions.jpeg2000.regionHeight = 17;
+    request.codecOptions.jpeg2000.hasThreadCount = true;
+    request.codecOptions.jpeg2000.threadCount = 4;
+
+    const rawgl::io::ImageLoadResult result = rawgl::io::LoadImageFile(request);
+    if (!result.success) {
+        std::cerr << "JPEG-2000 region load failed: " << result.errorMessage << std::endl;
+        return false;
+    }
+    if (result.image.width != 21 || result.image.height != 17 || result.image.channels != 3) {
+        std::cerr << "JPEG-2000 region load returned unexpected dimensions." << std::endl;
+        return false;
+    }
+    for (int y = 0; y < result.image.height; ++y) {
+        for (int x = 0; x < result.image.width; ++x) {
+            for (int channel = 0; channel < 3; ++channel) {
+                const size_t sampleIndex =
+                    (static_cast<size_t>(y) * 21u + static_cast<size_t>(x)) * 3u + static_cast<size_t>(channel);
+                if (static_cast<uint8_t>(result.image.bytes[sampleIndex])
+                    != make_u8_sample_value(x + 5, y + 3, channel)) {
+                    std::cerr << "JPEG-2000 region load returned samples from the wrong window." << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// An explicit thread count must reach OpenJPEG unchanged, even from a runtime whose default pools are hardware-sized.
+static bool
+run_jpeg2000_thread_case()
+{
+    rawgl::io::ImageLoadRequest request;
+    request.path = "tests/outputs/rawgl_io_jpeg2000_native_region.jp2";
+    request.attributes.push_back(rawgl::Attribute { "jpeg2000:threads", "8" });
+
+    const rawgl::io::IoRuntime ioRuntime;
+    const rawgl::io::ImageLoadResult result = ioRuntime.loadImageFile(request);
+    if (!result.success) {
+        std::cerr << "JPEG-2000 threaded load failed: " << result.errorMessage << std::endl;
+        return false;
+    }
+    const uint32_t threadCount = rawgl::io::last_codec_thread_count(rawgl::io::ImageCodecFamily::Jpeg2000);
+    if (threadCount != 8u) {
+        std::cerr << "JPEG-2000 load asked for 8 threads but OpenJPEG got " << threadCount << "." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 static bool
 run_jpeg2000_error_cases()
 {
@@ -340,6 +421,16 @@ run_jpeg2000_error_cases()
                                       { { "jpeg2000:reduce_factor", "not_a_number" } })) {
         return false;
     }
+    if (!expect_jpeg2000_load_failure("region outside image",
+                                      validPath,
+                                      { { "jpeg2000:region", "8,8,9,4" } })) {
+        return false;
+    }
+    if (!expect_jpeg2000_load_failure("empty region",
+                                      validPath,
+                                      { { "jpeg2000:region", "2,2,0,4" } })) {
+        return false;
+    }
     if (!expect_jpeg2000_load_failure("invalid layer limit",
                                       validPath,
                                       { { "jpeg2000:layer_limit", "not_a_number" } })) {
@@ -440,6 +531,12 @@ main()
             return 1;
         }
     }
+    if (!run_jpeg2000_region_case()) {
+        return 1;
+    }
+    if (!run_jpeg2000_thread_case()) {
+        return 1;
+    }
     if (!run_jpeg2000_error_cases()) {
         return 1;
     }
@@ -9,14 +9,18 @@
 
 #include <GL/glew.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 #if __has_include(<jpeglib.h>)
@@ -226,6 +230,20 @@ verify_jpeg_direct(const std::filesystem::path& path)
         return false;
     }
 
+    // DCT scaling rounds each dimension up: ceil(19 / 4) x ceil(17 / 4).
+    const rawgl::io::DecodedImageData quarter =
+        rawgl::io::decode_jpg_file(path.string(), { { "rawgl:decode_scale", "4" } });
+    if (!verify_decoded_shape(quarter, 5, 5, source.channels, rawgl::io::ImageComponentType::U8, "JPEG 1/4 scale")) {
+        return false;
+    }
+
+    const rawgl::io::DecodedImageData invalidScale =
+        rawgl::io::decode_jpg_file(path.string(), { { "rawgl:decode_scale", "3" } });
+    if (invalidScale.success) {
+        std::cerr << "JPEG decode accepted a non power-of-two decode scale." << std::endl;
+        return false;
+    }
+
 #if defined(RAWGL_TEST_HAS_JPEGLIB)
     FILE* file = std::fopen(path.string().c_str(), "rb");
     if (file == nullptr) {
@@ -263,9 +281,9 @@ verify_jpeg_direct(const std::filesystem::path& path)
 }
 
 static bool
-verify_exr_direct(const std::filesystem::path& path)
+verify_exr_direct(const std::filesystem::path& path, const char* threadCount)
 {
-    const rawgl::HostImageData source = make_f32_rgb_image(9, 7);
+    const rawgl::HostImageData source = make_f32_rgb_image(37, 29);
     rawgl::io::ImageEncodeSettings settings;
     settings.codec = rawgl::io::ImageCodecFamily::Exr;
     settings.componentType = rawgl::io::ImageComponentType::F32;
@@ -277,6 +295,7 @@ verify_exr_direct(const std::filesystem::path& path)
     attributes.insert({ "openexr:tile_height", "8" });
     attributes.insert({ "openexr:line_order", "increasing_y" });
     attributes.insert({ "openexr:attribute:string:RawGLTest", "native-codecs" });
+    attributes.insert({ "openexr:threads", threadCount });
 
     std::string errorMessage;
     if (!rawgl::io::encode_exr_file(path.string(), attributes, -1, source, settings, errorMessage)) {
@@ -284,7 +303,8 @@ verify_exr_direct(const std::filesystem::path& path)
         return false;
     }
 
-    const rawgl::io::DecodedImageData decoded = rawgl::io::decode_exr_file(path.string());
+    const rawgl::io::DecodedImageData decoded =
+        rawgl::io::decode_exr_file(path.string(), { { "openexr:threads", threadCount } });
     if (!verify_decoded_shape(decoded, source.width, source.height, source.channels, settings.componentType, "OpenEXR")) {
         return false;
     }
@@ -310,17 +330,271 @@ verify_exr_direct(const std::filesystem::path& path)
     return true;
 }
 
+// With default IoRuntimeOptions a lone load or save gets every hardware thread for its OpenEXR pool.
+static bool
+verify_exr_runtime_threads(const std::filesystem::path& path)
+{
+    const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads < 2u) {
+        return true;
+    }
+
+    const rawgl::io::IoRuntime ioRuntime;
+    rawgl::io::ImageSaveRequest saveRequest;
+    saveRequest.path = path.string();
+    saveRequest.bits = 32;
+    saveRequest.attributes = { { "openexr:compression", "zip" } };
+    saveRequest.image = make_f32_rgb_image(67, 45);
+    const rawgl::io::ImageSaveResult saveResult = ioRuntime.saveImageFile(saveRequest);
+    if (!saveResult.success) {
+        std::cerr << "OpenEXR runtime save failed: " << saveResult.errorMessage << std::endl;
+        return false;
+    }
+    const uint32_t encodeThreads = rawgl::io::last_codec_thread_count(rawgl::io::ImageCodecFamily::Exr);
+    if (encodeThreads != hardwareThreads) {
+        std::cerr << "OpenEXR runtime save used " << encodeThreads << " threads, expected " << hardwareThreads << "."
+                  << std::endl;
+        return false;
+    }
+
+    rawgl::io::ImageLoadRequest loadRequest;
+    loadRequest.path = path.string();
+    const rawgl::io::ImageLoadResult loadResult = ioRuntime.loadImageFile(loadRequest);
+    if (!loadResult.success) {
+        std::cerr << "OpenEXR runtime load failed: " << loadResult.errorMessage << std::endl;
+        return false;
+    }
+    const uint32_t decodeThreads = rawgl::io::last_codec_thread_count(rawgl::io::ImageCodecFamily::Exr);
+    if (decodeThreads != hardwareThreads) {
+        std::cerr << "OpenEXR runtime load used " << decodeThreads << " threads, expected " << hardwareThreads << "."
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static std::vector<std::byte>
+read_file_bytes(const std::filesystem::path& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    const std::vector<char> chars((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    std::vector<std::byte> bytes(chars.size());
+    if (!chars.empty()) {
+        std::memcpy(bytes.data(), chars.data(), chars.size());
+    }
+    return bytes;
+}
+
+static bool
+verify_memory_load(const std::filesystem::path& path, const char* nameHint, const char* label)
+{
+    const std::vector<std::byte> encoded = read_file_bytes(path);
+    if (encoded.empty()) {
+        std::cerr << label << " source file could not be read." << std::endl;
+        return false;
+    }
+
+    rawgl::io::ImageLoadRequest fileRequest;
+    fileRequest.path = path.string();
+    const rawgl::io::ImageLoadResult fileResult = rawgl::io::LoadImageFile(fileRequest);
+    if (!fileResult.success) {
+        std::cerr << label << " file load failed: " << fileResult.errorMessage << std::endl;
+        return false;
+    }
+
+    rawgl::io::ImageMemoryLoadRequest memoryRequest;
+    memoryRequest.bytes = encoded;
+    memoryRequest.nameHint = nameHint;
+    const rawgl::io::ImageLoadResult memoryResult = rawgl::io::LoadImageMemory(memoryRequest);
+    if (!memoryResult.success) {
+        std::cerr << label << " in-memory load failed: " << memoryResult.errorMessage << std::endl;
+        return false;
+    }
+
+    if (memoryResult.image.width != fileResult.image.width || memoryResult.image.height != fileResult.image.height
+        || memoryResult.image.channels != fileResult.image.channels
+        || memoryResult.image.glInternalFormat != fileResult.image.glInternalFormat
+        || memoryResult.image.bytes != fileResult.image.bytes) {
+        std::cerr << label << " in-memory load differs from the file load." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+verify_memory_load_failures(const std::filesystem::path& pngPath)
+{
+    const std::byte unknown[] = { std::byte { 0x00 }, std::byte { 0x11 }, std::byte { 0x22 }, std::byte { 0x33 } };
+    rawgl::io::ImageMemoryLoadRequest unknownRequest;
+    unknownRequest.bytes = unknown;
+    if (rawgl::io::LoadImageMemory(unknownRequest).success) {
+        std::cerr << "In-memory load accepted an unknown signature." << std::endl;
+        return false;
+    }
+
+    std::vector<std::byte> truncated = read_file_bytes(pngPath);
+    truncated.resize(std::min<size_t>(truncated.size(), 48u));
+    rawgl::io::ImageMemoryLoadRequest truncatedRequest;
+    truncatedRequest.bytes = truncated;
+    const rawgl::io::ImageLoadResult truncatedResult = rawgl::io::LoadImageMemory(truncatedRequest);
+    if (truncatedResult.success || truncatedResult.errorMessage.empty()) {
+        std::cerr << "In-memory load of a truncated PNG should fail with a message." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+stream_image_file(const rawgl::io::ImageSaveRequest& request, const int bandRows, const char* label)
+{
+    rawgl::io::ImageSaveRequest layoutRequest = request;
+    layoutRequest.image.bytes.clear();
+    rawgl::io::ImageStreamBeginResult begin = rawgl::io::IoRuntime().beginImageFileStream(layoutRequest);
+    if (!begin.success) {
+        std::cerr << label << " stream begin failed: " << begin.errorMessage << std::endl;
+        return false;
+    }
+
+    const rawgl::HostImageData& image = request.image;
+    const size_t rowBytes = image.bytes.size() / static_cast<size_t>(image.height);
+    for (int firstRow = 0; firstRow < image.height; firstRow += bandRows) {
+        rawgl::HostImageData band = image;
+        band.height = std::min(bandRows, image.height - firstRow);
+        band.bytes.assign(image.bytes.begin() + static_cast<std::ptrdiff_t>(static_cast<size_t>(firstRow) * rowBytes),
+                          image.bytes.begin()
+                              + static_cast<std::ptrdiff_t>(static_cast<size_t>(firstRow + band.height) * rowBytes));
+        const rawgl::io::ImageSaveResult written = begin.stream.writeRows(band);
+        if (!written.success) {
+            std::cerr << label << " stream write failed: " << written.errorMessage << std::endl;
+            return false;
+        }
+    }
+
+    const rawgl::io::ImageSaveResult finished = begin.stream.finish();
+    if (!finished.success) {
+        std::cerr << label << " stream finish failed: " << finished.errorMessage << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool
+verify_stream_save(const std::filesystem::path& wholePath,
+                   const std::filesystem::path& streamPath,
+                   const rawgl::HostImageData& image,
+                   const int bits,
+                   const std::vector<rawgl::Attribute>& attributes,
+                   const char* label)
+{
+    rawgl::io::ImageSaveRequest request;
+    request.path = wholePath.string();
+    request.bits = bits;
+    request.attributes = attributes;
+    request.image = image;
+    const rawgl::io::ImageSaveResult whole = rawgl::io::SaveImageFile(request);
+    if (!whole.success) {
+        std::cerr << label << " whole-image save failed: " << whole.errorMessage << std::endl;
+        return false;
+    }
+
+    request.path = streamPath.string();
+    if (!stream_image_file(request, 7, label)) {
+        return false;
+    }
+
+    rawgl::io::ImageLoadRequest wholeLoad;
+    wholeLoad.path = wholePath.string();
+    rawgl::io::ImageLoadRequest streamLoad;
+    streamLoad.path = streamPath.string();
+    const rawgl::io::ImageLoadResult wholeResult = rawgl::io::LoadImageFile(wholeLoad);
+    const rawgl::io::ImageLoadResult streamResult = rawgl::io::LoadImageFile(streamLoad);
+    if (!wholeResult.success || !streamResult.success) {
+        std::cerr << label << " reload failed: " << wholeResult.errorMessage << streamResult.errorMessage
+                  << std::endl;
+        return false;
+    }
+    if (streamResult.image.width != image.width || streamResult.image.height != image.height
+        || streamResult.image.bytes != wholeResult.image.bytes) {
+        std::cerr << label << " streamed file differs from the whole-image save." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+verify_stream_save_failures(const std::filesystem::path& path)
+{
+    rawgl::io::ImageSaveRequest request;
+    request.path = path.string();
+    request.bits = 8;
+    request.image = make_u8_rgb_image(16, 8);
+    rawgl::io::ImageStreamBeginResult begin = rawgl::io::IoRuntime().beginImageFileStream(request);
+    if (!begin.success) {
+        std::cerr << "PNG stream begin failed: " << begin.errorMessage << std::endl;
+        return false;
+    }
+
+    if (begin.stream.finish().success) {
+        std::cerr << "PNG stream finished without any rows." << std::endl;
+        return false;
+    }
+    if (begin.stream.isOpen() || begin.stream.writeRows(request.image).success) {
+        std::cerr << "PNG stream stayed open after a failed finish." << std::endl;
+        return false;
+    }
+
+    begin = rawgl::io::IoRuntime().beginImageFileStream(request);
+    const rawgl::HostImageData wrongWidth = make_u8_rgb_image(15, 8);
+    if (!begin.success || begin.stream.writeRows(wrongWidth).success) {
+        std::cerr << "PNG stream accepted rows with the wrong width." << std::endl;
+        return false;
+    }
+
+    begin = rawgl::io::IoRuntime().beginImageFileStream(request);
+    if (!begin.success || !begin.stream.writeRows(request.image).success
+        || begin.stream.writeRows(make_u8_rgb_image(16, 1)).success) {
+        std::cerr << "PNG stream accepted rows past the image height." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 int
 main()
 {
     const std::filesystem::path pngPath = "tests/outputs/rawgl_io_native_codecs_u16.png";
     const std::filesystem::path jpegPath = "tests/outputs/rawgl_io_native_codecs_progressive.jpg";
     const std::filesystem::path exrPath = "tests/outputs/rawgl_io_native_codecs_tiled.exr";
+    const std::filesystem::path parallelExrPath = "tests/outputs/rawgl_io_native_codecs_tiled_parallel.exr";
+    const std::filesystem::path runtimeExrPath = "tests/outputs/rawgl_io_native_codecs_runtime_threads.exr";
 
     std::error_code removeError;
     std::filesystem::remove(pngPath, removeError);
     std::filesystem::remove(jpegPath, removeError);
     std::filesystem::remove(exrPath, removeError);
+    std::filesystem::remove(parallelExrPath, removeError);
+    std::filesystem::remove(runtimeExrPath, removeError);
+    const std::vector<std::filesystem::path> streamPaths = {
+        "tests/outputs/rawgl_io_native_codecs_stream_whole.png",
+        "tests/outputs/rawgl_io_native_codecs_stream.png",
+        "tests/outputs/rawgl_io_native_codecs_stream_whole.tif",
+        "tests/outputs/rawgl_io_native_codecs_stream.tif",
+        "tests/outputs/rawgl_io_native_codecs_stream_tiled_whole.tif",
+        "tests/outputs/rawgl_io_native_codecs_stream_tiled.tif",
+        "tests/outputs/rawgl_io_native_codecs_stream_whole.exr",
+        "tests/outputs/rawgl_io_native_codecs_stream.exr",
+        "tests/outputs/rawgl_io_native_codecs_stream_tiled_whole.exr",
+        "tests/outputs/rawgl_io_native_codecs_stream_tiled.exr",
+        "tests/outputs/rawgl_io_native_codecs_stream_failures.png",
+    };
+    for (const std::filesystem::path& streamPath : streamPaths) {
+        std::filesystem::remove(streamPath, removeError);
+    }
 
     if (!verify_png_direct(pngPath)) {
         return 1;
@@ -328,7 +602,66 @@ main()
     if (!verify_jpeg_direct(jpegPath)) {
         return 1;
     }
-    if (!verify_exr_direct(exrPath)) {
+    if (!verify_exr_direct(exrPath, "1")) {
+        return 1;
+    }
+    if (!verify_exr_direct(parallelExrPath, "4")) {
+        return 1;
+    }
+    if (!verify_exr_runtime_threads(runtimeExrPath)) {
+        return 1;
+    }
+    if (!verify_memory_load(pngPath, "", "PNG")) {
+        return 1;
+    }
+    if (!verify_memory_load(jpegPath, "", "JPEG")) {
+        return 1;
+    }
+    if (!verify_memory_load(exrPath, "memory.exr", "EXR")) {
+        return 1;
+    }
+    if (!verify_memory_load_failures(pngPath)) {
+        return 1;
+    }
+    if (!verify_stream_save(streamPaths[0], streamPaths[1], make_u16_rgb_image(67, 45), 16, {}, "PNG")) {
+        return 1;
+    }
+    if (!verify_stream_save(streamPaths[2],
+                            streamPaths[3],
+                            make_u8_rgb_image(67, 45),
+                            8,
+                            { { "tiff:compression", "zip" }, { "tiff:rowsPerStrip", "4" }, { "tiff:threads", "4" } },
+                            "TIFF strips")) {
+        return 1;
+    }
+    if (!verify_stream_save(streamPaths[4],
+                            streamPaths[5],
+                            make_u16_rgb_image(67, 45),
+                            16,
+                            { { "tiff:compression", "lzw" }, { "tiff:tileWidth", "16" }, { "tiff:tileLength", "16" } },
+                            "TIFF tiles")) {
+        return 1;
+    }
+    if (!verify_stream_save(streamPaths[6],
+                            streamPaths[7],
+                            make_f32_rgb_image(67, 45),
+                            32,
+                            { { "openexr:compression", "zip" } },
+                            "OpenEXR scanlines")) {
+        return 1;
+    }
+    if (!verify_stream_save(streamPaths[8],
+                            streamPaths[9],
+                            make_f32_rgb_image(67, 45),
+                            32,
+                            { { "openexr:layout", "tiled" },
+                              { "openexr:tile_width", "16" },
+                              { "openexr:tile_height", "16" },
+                              { "openexr:threads", "4" } },
+                            "OpenEXR tiles")) {
+        return 1;
+    }
+    if (!verify_stream_save_failures(streamPaths[10])) {
         return 1;
     }
 
@@ -87,11 +87,13 @@ save_tiled_tiff(const std::filesystem::path& path, const rawgl::HostImageData& i
 static bool
 save_stripped_tiff(const std::filesystem::path& path,
                    const rawgl::HostImageData& image,
+                   const char* threadCount,
                    uint16_t& expectedCompression)
 {
     std::map<std::string, std::string> attributes;
     attributes.insert({ "tiff:layout", "strips" });
     attributes.insert({ "tiff:rows_per_strip", "4" });
+    attributes.insert({ "tiff:threads", threadCount });
 
 #if defined(RAWGL_TEST_HAS_TIFFIO)
 #    if defined(COMPRESSION_ADOBE_DEFLATE)
@@ -204,9 +206,12 @@ verify_stripped_tiff_layout(const std::filesystem::path& path, const uint16_t ex
 }
 
 static bool
-verify_round_trip(const std::filesystem::path& path, const rawgl::HostImageData& source)
+verify_round_trip(const std::filesystem::path& path, const rawgl::HostImageData& source, const char* threadCount)
 {
-    const rawgl::io::DecodedImageData result = rawgl::io::decode_tiff_file(path.string());
+    std::map<std::string, std::string> attributes;
+    attributes.insert({ "tiff:threads", threadCount });
+
+    const rawgl::io::DecodedImageData result = rawgl::io::decode_tiff_file(path.string(), attributes);
     if (!result.success) {
         std::cerr << "TIFF reload failed: " << result.errorMessage << std::endl;
         return false;
@@ -219,7 +224,7 @@ verify_round_trip(const std::filesystem::path& path, const rawgl::HostImageData&
     }
 
     if (result.bytes != source.bytes) {
-        std::cerr << "Reloaded TIFF pixels differ from source." << std::endl;
+        std::cerr << "Reloaded TIFF pixels differ from source with " << threadCount << " decode threads." << std::endl;
         return false;
     }
 
@@ -231,10 +236,13 @@ main()
 {
     const std::filesystem::path tiledOutputPath = "tests/outputs/rawgl_io_tiff_native_tiled_u16.tif";
     const std::filesystem::path strippedOutputPath = "tests/outputs/rawgl_io_tiff_native_stripped_u16.tif";
+    const std::filesystem::path parallelStrippedOutputPath =
+        "tests/outputs/rawgl_io_tiff_native_stripped_parallel_u16.tif";
 
     std::error_code removeError;
     std::filesystem::remove(tiledOutputPath, removeError);
     std::filesystem::remove(strippedOutputPath, removeError);
+    std::filesystem::remove(parallelStrippedOutputPath, removeError);
 
     const rawgl::HostImageData image = make_test_image();
     if (!save_tiled_tiff(tiledOutputPath, image)) {
@@ -243,18 +251,28 @@ main()
     if (!verify_tiled_tiff_layout(tiledOutputPath)) {
         return 1;
     }
-    if (!verify_round_trip(tiledOutputPath, image)) {
+    if (!verify_round_trip(tiledOutputPath, image, "1") || !verify_round_trip(tiledOutputPath, image, "4")) {
         return 1;
     }
 
     uint16_t expectedCompression = 0u;
-    if (!save_stripped_tiff(strippedOutputPath, image, expectedCompression)) {
+    if (!save_stripped_tiff(strippedOutputPath, image, "1", expectedCompression)) {
         return 1;
     }
     if (!verify_stripped_tiff_layout(strippedOutputPath, expectedCompression)) {
         return 1;
     }
-    if (!verify_round_trip(strippedOutputPath, image)) {
+    if (!verify_round_trip(strippedOutputPath, image, "1") || !verify_round_trip(strippedOutputPath, image, "4")) {
+        return 1;
+    }
+
+    if (!save_stripped_tiff(parallelStrippedOutputPath, image, "4", expectedCompression)) {
+        return 1;
+    }
+    if (!verify_stripped_tiff_layout(parallelStrippedOutputPath, expectedCompression)) {
+        return 1;
+    }
+    if (!verify_round_trip(parallelStrippedOutputPath, image, "1")) {
         return 1;
     }
 
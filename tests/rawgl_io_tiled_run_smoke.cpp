@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (c) 2022-2026 Erium Vladlen.
+
+#include "rawgl/rawgl_io.h"
+
+#include <filesystem>
+#include <iostream>
+
+static rawgl::Workflow
+make_box_blur_workflow()
+{
+    rawgl::Workflow workflow;
+    workflow.verbosity = 3;
+
+    rawgl::Pass pass;
+    pass.programKind = rawgl::ShaderProgramKind::vertfrag;
+    pass.sizeX = 512;
+    pass.sizeY = 512;
+
+    rawgl::ShaderModuleDefinition fragmentModule;
+    fragmentModule.role = rawgl::ShaderModuleRole::fragment;
+    fragmentModule.sourceKind = rawgl::ShaderModuleSourceKind::glslText;
+    fragmentModule.glslText = R"(#version 450 core
+layout(location = 0) in vec2 UV;
+layout(location = 0) out vec4 out_color;
+uniform sampler2D u_src0;
+void main()
+{
+    const ivec2 lastTexel = textureSize(u_src0, 0) - ivec2(1);
+    const ivec2 center = ivec2(gl_FragCoord.xy);
+    vec4 sum = vec4(0.0);
+    for (int y = -2; y <= 2; ++y) {
+        for (int x = -2; x <= 2; ++x) {
+            sum += texelFetch(u_src0, clamp(center + ivec2(x, y), ivec2(0), lastTexel), 0);
+        }
+    }
+    out_color = sum / 25.0;
+}
+)";
+    fragmentModule.debugLabel = "rawgl_io_tiled_run_smoke_fragment";
+    pass.shaderModules.push_back(fragmentModule);
+
+    workflow.passes.push_back(pass);
+    return workflow;
+}
+
+static bool
+load_image(const std::filesystem::path& path, rawgl::HostImageData& image)
+{
+    rawgl::io::ImageLoadRequest request;
+    request.path = path.string();
+    const rawgl::io::ImageLoadResult result = rawgl::io::LoadImageFile(request);
+    if (!result.success) {
+        std::cerr << "Failed to reload " << path << ": " << result.errorMessage << std::endl;
+        return false;
+    }
+    image = result.image;
+    return true;
+}
+
+int
+main()
+{
+    const std::filesystem::path inputPath = std::filesystem::absolute("tests/inputs/EmptyPresetLUT.png");
+    const std::filesystem::path fullOutputPath =
+        std::filesystem::absolute("tests/outputs/rawgl_io_tiled_run_smoke_full.png");
+    const std::filesystem::path tiledOutputPath =
+        std::filesystem::absolute("tests/outputs/rawgl_io_tiled_run_smoke_tiled.png");
+
+    std::error_code removeError;
+    std::filesystem::remove(fullOutputPath, removeError);
+    std::filesystem::remove(tiledOutputPath, removeError);
+
+    const rawgl::Workflow workflow = make_box_blur_workflow();
+    rawgl::Session session;
+    rawgl::io::IoRuntime ioRuntime;
+
+    std::vector<rawgl::io::FileInputBinding> fileInputs;
+    fileInputs.push_back(rawgl::io::FileTextureInput(0, "u_src0", inputPath.string()));
+    std::vector<rawgl::io::FileOutputBinding> fileOutputs;
+    fileOutputs.push_back(rawgl::io::FileOutput(0, "out_color", fullOutputPath.string(), "rgb8", 3, -1, 8));
+
+    const rawgl::RunResult fullResult = ioRuntime.run(session, workflow, {}, fileInputs, fileOutputs);
+    if (!fullResult.success) {
+        std::cerr << "Full-frame run failed: " << fullResult.errorMessage << std::endl;
+        return 1;
+    }
+
+    rawgl::io::TiledRunRequest tiledRequest;
+    tiledRequest.input = rawgl::io::FileTextureInput(0, "u_src0", inputPath.string());
+    tiledRequest.output = rawgl::io::FileOutput(0, "out_color", tiledOutputPath.string(), "rgb8", 3, -1, 8);
+    tiledRequest.tileWidth = 100;
+    tiledRequest.tileHeight = 70;
+    tiledRequest.halo = 2;
+
+    const rawgl::io::TiledRunResult tiledResult = ioRuntime.runTiled(session, workflow, tiledRequest);
+    if (!tiledResult.success) {
+        std::cerr << "Tiled run failed: " << tiledResult.errorMessage << std::endl;
+        return 1;
+    }
+    if (tiledResult.width != 512 || tiledResult.height != 512 || tiledResult.tileCount != 48u) {
+        std::cerr << "Tiled run reported an unexpected size or tile count." << std::endl;
+        return 1;
+    }
+
+    rawgl::HostImageData fullImage;
+    rawgl::HostImageData tiledImage;
+    if (!load_image(fullOutputPath, fullImage) || !load_image(tiledOutputPath, tiledImage)) {
+        return 1;
+    }
+    if (fullImage.width != tiledImage.width || fullImage.height != tiledImage.height
+        || fullImage.bytes != tiledImage.bytes) {
+        std::cerr << "Tiled output differs from the full-frame output." << std::endl;
+        return 1;
+    }
+
+    rawgl::io::TiledRunRequest badRequest = tiledRequest;
+    badRequest.halo = -1;
+    if (ioRuntime.runTiled(session, workflow, badRequest).success) {
+        std::cerr << "Tiled run accepted a negative halo." << std::endl;
+        return 1;
+    }
+
+    rawgl::Workflow resizedWorkflow = workflow;
+    resizedWorkflow.passes[0].sizeX = 256;
+    const rawgl::io::TiledRunResult resizedResult = ioRuntime.runTiled(session, resizedWorkflow, tiledRequest);
+    if (resizedResult.success || resizedResult.errorMessage.find("pass 0 is 256x512") == std::string::npos) {
+        std::cerr << "Tiled run accepted a pass smaller than the source image: " << resizedResult.errorMessage
+                  << std::endl;
+        return 1;
+    }
+
+    rawgl::io::TiledRunRequest undeclaredInfoRequest = tiledRequest;
+    undeclaredInfoRequest.tileInfoInputName = "u_tileInfo";
+    if (ioRuntime.runTiled(session, workflow, undeclaredInfoRequest).success) {
+        std::cerr << "Tiled run accepted a tile info input that no pass declares." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
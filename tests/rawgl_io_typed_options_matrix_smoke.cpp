@@ -371,6 +371,8 @@ verify_jpeg_typed_options(const std::filesystem::path& path)
     jpeg.optimize = true;
     jpeg.hasSubsampling = true;
     jpeg.subsampling = rawgl::io::JpegChromaSubsampling::S444;
+    jpeg.hasDctMethod = true;
+    jpeg.dctMethod = rawgl::io::JpegDctMethod::Float;
 
     rawgl::io::ImageCodecSaveOptions codecOptions;
     codecOptions.hasJpeg = true;
@@ -382,7 +384,8 @@ verify_jpeg_typed_options(const std::filesystem::path& path)
                                  { { "jpeg:quality", "0" },
                                    { "jpeg:progressive", "maybe" },
                                    { "jpeg:optimize", "maybe" },
-                                   { "jpeg:subsampling", "bad" } },
+                                   { "jpeg:subsampling", "bad" },
+                                   { "jpeg:dct_method", "bad" } },
                                  codecOptions,
                                  "JPEG typed matrix")) {
         return false;
@@ -395,6 +398,10 @@ verify_jpeg_typed_options(const std::filesystem::path& path)
     rgbLoadOptions.hasJpeg = true;
     rgbLoadOptions.jpeg.hasColorTransform = true;
     rgbLoadOptions.jpeg.colorTransform = rawgl::io::JpegLoadColorTransform::Rgb;
+    rgbLoadOptions.jpeg.hasDctMethod = true;
+    rgbLoadOptions.jpeg.dctMethod = rawgl::io::JpegDctMethod::Fast;
+    rgbLoadOptions.jpeg.hasFancyUpsampling = true;
+    rgbLoadOptions.jpeg.fancyUpsampling = false;
 
     rawgl::HostImageData rgbLoaded;
     if (!load_image_with_options(path, rgbLoadOptions, rgbLoaded, "JPEG typed RGB matrix")) {
@@ -11,9 +11,12 @@ main()
 {
     const std::filesystem::path inputPath = std::filesystem::absolute("tests/inputs/EmptyPresetLUT.png");
     const std::filesystem::path outputPath = std::filesystem::absolute("tests/outputs/rawgl_io_workflow_smoke.png");
+    const std::filesystem::path pooledOutputPath =
+        std::filesystem::absolute("tests/outputs/rawgl_io_workflow_smoke_pooled.png");
 
     std::error_code removeError;
     std::filesystem::remove(outputPath, removeError);
+    std::filesystem::remove(pooledOutputPath, removeError);
 
     rawgl::Workflow workflow;
     workflow.verbosity = 3;
@@ -78,5 +81,23 @@ void main()
         return 1;
     }
 
+    rawgl::io::IoRuntimeOptions pooledOptions;
+    pooledOptions.decodeWorkerCount = 1;
+    pooledOptions.encodeWorkerCount = 2;
+    const rawgl::io::IoRuntime pooledIoRuntime(pooledOptions);
+    std::vector<rawgl::io::FileOutputBinding> pooledFileOutputs = fileOutputs;
+    pooledFileOutputs.push_back(rawgl::io::FileOutput(0, "out_color", pooledOutputPath.string()));
+
+    const rawgl::RunResult pooledRunResult = pooledIoRuntime.run(session, workflow, {}, fileInputs, pooledFileOutputs);
+    if (!pooledRunResult.success) {
+        std::cerr << "Pooled IO workflow run failed: " << pooledRunResult.errorMessage << std::endl;
+        return 1;
+    }
+
+    if (!std::filesystem::exists(pooledOutputPath)) {
+        std::cerr << "Pooled IO workflow did not write output: " << pooledOutputPath << std::endl;
+        return 1;
+    }
+
     return 0;
 }